@@ -0,0 +1,248 @@
+#include "CaptureReplayer.h"
+#include "VirtualPrinter.h"
+#include <boost/log/trivial.hpp>
+#include <stdexcept>
+#include <charconv>
+#include <poll.h>
+
+// While the other side isn't connected
+static constexpr std::chrono::milliseconds REOPEN_POLL_INTERVAL(100);
+
+CaptureReplayer::Options CaptureReplayer::Options::parse(std::string_view spec)
+{
+	Options options;
+
+	while (!spec.empty())
+	{
+		const size_t comma = spec.find(',');
+		std::string_view item = spec.substr(0, comma);
+		spec = (comma == std::string_view::npos) ? std::string_view() : spec.substr(comma + 1);
+
+		if (item.empty())
+			continue;
+
+		const size_t eq = item.find('=');
+		if (eq == std::string_view::npos)
+			throw std::invalid_argument("Replay option without a value: " + std::string(item));
+
+		const std::string_view key = item.substr(0, eq), text = item.substr(eq + 1);
+
+		if (key == "file")
+			options.file = text;
+		else if (key == "speed")
+		{
+			auto result = std::from_chars(text.data(), text.data() + text.length(), options.speed);
+			if (result.ec != std::errc() || result.ptr != text.data() + text.length() || options.speed < 0)
+				throw std::invalid_argument("Invalid replay speed: " + std::string(text));
+		}
+		else
+			throw std::invalid_argument("Unknown replay option: " + std::string(key));
+	}
+
+	if (options.file.empty())
+		throw std::invalid_argument("No capture file to replay");
+
+	return options;
+}
+
+CaptureReplayer::CaptureReplayer(boost::asio::io_service& io, const Options& options)
+: m_options(options), m_master(io), m_timer(io), m_pollTimer(io), m_lastPlayed(std::chrono::steady_clock::now())
+{
+	if (!SerialCapture::read(options.file, m_records))
+		throw std::runtime_error("Cannot read the capture " + options.file);
+
+	// Whatever was captured before the first connection cannot be reproduced
+	for (size_t i = 0; i < m_records.size(); i++)
+	{
+		if (m_records[i].event == SerialCapture::Event::Connected)
+		{
+			m_next = i + 1;
+			m_lastTime = m_records[i].time;
+			break;
+		}
+	}
+	m_connectionStart = m_next;
+
+	m_master.assign(VirtualPrinter::openPseudoTerminal(m_devicePath));
+
+	BOOST_LOG_TRIVIAL(info) << "Replaying " << options.file << " (" << m_records.size() << " records) on " << m_devicePath;
+
+	doRead();
+}
+
+CaptureReplayer::~CaptureReplayer()
+{
+	boost::system::error_code ec;
+
+	m_timer.cancel(ec);
+	m_pollTimer.cancel(ec);
+	m_master.cancel(ec);
+	m_master.close(ec);
+}
+
+void CaptureReplayer::doRead()
+{
+	m_master.async_read_some(boost::asio::buffer(m_readBuffer), std::bind(&CaptureReplayer::readDone, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void CaptureReplayer::readDone(const boost::system::error_code& ec, size_t bytesRead)
+{
+	if (ec == boost::asio::error::operation_aborted)
+		return;
+
+	if (ec)
+	{
+		// EIO until the slave side is (re)opened
+		nextConnection();
+		waitForReopen();
+		return;
+	}
+
+	m_received.append(m_readBuffer, bytesRead);
+	m_stats.bytesReceived += bytesRead;
+
+	advance();
+	doRead();
+}
+
+void CaptureReplayer::waitForReopen()
+{
+	m_pollTimer.expires_after(REOPEN_POLL_INTERVAL);
+	m_pollTimer.async_wait([=](const boost::system::error_code& ec) {
+		if (ec)
+			return;
+
+		struct pollfd pfd = { m_master.native_handle(), POLLIN, 0 };
+
+		// POLLHUP while nobody has the slave side open
+		if (::poll(&pfd, 1, 0) < 0 || (pfd.revents & POLLHUP))
+		{
+			waitForReopen();
+			return;
+		}
+
+		// Whatever the printer sent right after connecting
+		advance();
+		doRead();
+	});
+}
+
+void CaptureReplayer::nextConnection()
+{
+	m_writeBuffer.clear();
+
+	// Nothing has happened on this connection yet
+	if (m_next == m_connectionStart && m_received.empty())
+		return;
+
+	boost::system::error_code ec;
+	m_timer.cancel(ec);
+	m_waiting = false;
+	m_received.clear();
+
+	while (m_next < m_records.size() && m_records[m_next].event != SerialCapture::Event::Connected)
+		m_next++;
+
+	if (m_next < m_records.size())
+	{
+		m_lastTime = m_records[m_next].time;
+		m_lastPlayed = std::chrono::steady_clock::now();
+		m_next++;
+	}
+	m_connectionStart = m_next;
+}
+
+void CaptureReplayer::advance()
+{
+	if (m_waiting)
+		return;
+
+	while (m_next < m_records.size())
+	{
+		const SerialCapture::Record& record = m_records[m_next];
+
+		switch (record.event)
+		{
+			case SerialCapture::Event::Sent:
+			{
+				// The other side has to send as much first
+				if (m_received.length() < record.data.length())
+					return;
+
+				size_t mismatched = 0;
+				for (size_t i = 0; i < record.data.length(); i++)
+				{
+					if (m_received[i] != record.data[i])
+						mismatched++;
+				}
+
+				if (mismatched > 0 && m_stats.mismatchedBytes == 0)
+				{
+					BOOST_LOG_TRIVIAL(warning) << "Replay of " << m_options.file << " diverges at record " << m_next
+						<< ", expected \"" << record.data << "\", got \"" << m_received.substr(0, record.data.length()) << '"';
+				}
+
+				m_stats.mismatchedBytes += mismatched;
+				m_received.erase(0, record.data.length());
+				break;
+			}
+			case SerialCapture::Event::Received:
+			{
+				if (m_options.speed > 0)
+				{
+					const auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>((record.time - m_lastTime) / m_options.speed);
+					const auto due = m_lastPlayed + delay;
+
+					if (due > std::chrono::steady_clock::now())
+					{
+						m_waiting = true;
+						m_timer.expires_at(due);
+						m_timer.async_wait([=](const boost::system::error_code& ec) {
+							if (ec)
+								return;
+
+							m_waiting = false;
+							advance();
+						});
+						return;
+					}
+				}
+
+				m_writeBuffer += record.data;
+				m_stats.bytesReplayed += record.data.length();
+				flushWrites();
+				break;
+			}
+			case SerialCapture::Event::Connected:
+				// The link was re-established in the capture, wait for the other side to reconnect as well
+				return;
+		}
+
+		m_lastTime = record.time;
+		m_lastPlayed = std::chrono::steady_clock::now();
+		m_next++;
+	}
+
+	if (!m_stats.finished)
+	{
+		BOOST_LOG_TRIVIAL(info) << "Replay of " << m_options.file << " finished";
+		m_stats.finished = true;
+	}
+}
+
+void CaptureReplayer::flushWrites()
+{
+	if (!m_writing.empty() || m_writeBuffer.empty())
+		return;
+
+	m_writing.swap(m_writeBuffer);
+
+	boost::asio::async_write(m_master, boost::asio::buffer(m_writing), [=](const boost::system::error_code& ec, size_t) {
+		if (ec == boost::asio::error::operation_aborted)
+			return;
+
+		// Nobody listening, the output is lost
+		m_writing.clear();
+		flushWrites();
+	});
+}
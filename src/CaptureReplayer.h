@@ -0,0 +1,76 @@
+#ifndef _CAPTUREREPLAYER_H
+#define _CAPTUREREPLAYER_H
+#include <boost/asio.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include "SerialCapture.h"
+
+// Plays back what a printer sent in a SerialCapture, on the other side of a pseudo terminal like VirtualPrinter.
+// Device paths starting with "replay:" get one of these.
+// Replies are deterministic: each one waits until as many bytes have been received as had been sent before it
+// in the capture, then follows after the recorded delay (divided by the speed). Playback starts at the first
+// connection in the capture and moves on to the next one once the other side closes the port.
+class CaptureReplayer
+{
+public:
+	struct Options
+	{
+		std::string file;
+		// 1 for the original timing, 0 to reply as soon as possible
+		double speed = 1;
+
+		// Parses the part after "replay:", e.g. "file=/tmp/printer.dpcap,speed=10". Throws std::invalid_argument.
+		static Options parse(std::string_view spec);
+	};
+
+	// Throws std::runtime_error if the capture cannot be read
+	CaptureReplayer(boost::asio::io_service& io, const Options& options);
+	CaptureReplayer(const CaptureReplayer&) = delete;
+	~CaptureReplayer();
+
+	// Slave side of the pseudo terminal
+	const std::string& devicePath() const { return m_devicePath; }
+
+	struct Stats
+	{
+		size_t bytesReplayed = 0; // written to the other side
+		size_t bytesReceived = 0;
+		// Received bytes that differ from what had been sent in the capture
+		size_t mismatchedBytes = 0;
+		bool finished = false;
+	};
+	const Stats& stats() const { return m_stats; }
+private:
+	void doRead();
+	void readDone(const boost::system::error_code& ec, size_t bytesRead);
+	// Plays back records until having to wait for the other side or for a timer
+	void advance();
+	void waitForReopen();
+	// Skips to the next connection in the capture
+	void nextConnection();
+	void flushWrites();
+private:
+	const Options m_options;
+	std::vector<SerialCapture::Record> m_records;
+	boost::asio::posix::stream_descriptor m_master;
+	std::string m_devicePath;
+	boost::asio::steady_timer m_timer, m_pollTimer;
+
+	char m_readBuffer[512];
+	// Received in this connection but not matched up with a Sent record yet
+	std::string m_received;
+	std::string m_writeBuffer, m_writing;
+
+	// Next record to play back, and the first one of the current connection
+	size_t m_next = 0, m_connectionStart = 0;
+	bool m_waiting = false;
+	// When the previous record was played back and its time in the capture
+	std::chrono::steady_clock::time_point m_lastPlayed;
+	std::chrono::microseconds m_lastTime{0};
+
+	Stats m_stats;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "FileManager.h"
+#include "TimeEstimator.h"
 #include <fstream>
 #include <stdexcept>
 #include <boost/iostreams/device/mapped_file.hpp>
@@ -91,6 +92,9 @@ bool FileManager::deleteFile(std::string_view name)
 	
 	if (!boost::filesystem::remove(path))
 		return false;
+
+	boost::system::error_code ec;
+	boost::filesystem::remove(TimeTable::pathFor(path), ec);
 	
 	m_fileListChangedSignal();
 	return true;
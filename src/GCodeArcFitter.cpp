@@ -0,0 +1,112 @@
+#include "GCodeArcFitter.h"
+#include "GCodeCompactor.h"
+#include <cmath>
+
+// Positions with a tenth of a micron, the file's points come out as they were
+static constexpr int DECIMALS = 4;
+static constexpr int E_DECIMALS = 5;
+// A full circle would have the same start and end point, which firmware takes as 360 degrees
+static constexpr double MAX_SWEEP = 1.9 * M_PI;
+
+GCodeArcFitter::GCodeArcFitter(double tolerance)
+: GCodeMoveStage(MAX_SEGMENTS), m_tolerance(tolerance)
+{
+}
+
+bool GCodeArcFitter::fits(const Segment& segment) const
+{
+	Circle circle;
+	double sweep;
+
+	return fitCircle(segment, m_count + 1, circle, sweep);
+}
+
+bool GCodeArcFitter::fitCircle(const Segment& last, size_t count, Circle& circle, double& sweep) const
+{
+	// The run's starting point, then the end points of its segments
+	auto point = [&](size_t i, double& x, double& y) {
+		if (i == 0)
+		{
+			x = m_runX;
+			y = m_runY;
+		}
+		else
+		{
+			const Segment& s = (i == count) ? last : m_segments[i - 1];
+			x = s.x;
+			y = s.y;
+		}
+	};
+
+	// Circle through the first, middle and last point
+	double ax, ay, bx, by, cx, cy;
+
+	point(0, ax, ay);
+	point((count + 1) / 2, bx, by);
+	point(count, cx, cy);
+
+	const double d = 2 * (ax * (by - cy) + bx * (cy - ay) + cx * (ay - by));
+	if (std::abs(d) < 1e-9)
+		return false;
+
+	const double a2 = ax * ax + ay * ay, b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+
+	circle.x = (a2 * (by - cy) + b2 * (cy - ay) + c2 * (ay - by)) / d;
+	circle.y = (a2 * (cx - bx) + b2 * (ax - cx) + c2 * (bx - ax)) / d;
+	circle.r = std::hypot(ax - circle.x, ay - circle.y);
+
+	if (circle.r > MAX_RADIUS)
+		return false;
+
+	double px = ax, py = ay;
+	sweep = 0;
+
+	for (size_t i = 1; i <= count; i++)
+	{
+		double x, y;
+		point(i, x, y);
+
+		// The point itself and the middle of the segment leading to it, where a straight line is farthest from the arc
+		if (std::abs(std::hypot(x - circle.x, y - circle.y) - circle.r) > m_tolerance
+			|| std::abs(std::hypot((x + px) / 2 - circle.x, (y + py) / 2 - circle.y) - circle.r) > m_tolerance)
+		{
+			return false;
+		}
+
+		// All the way in the same direction
+		const double ux = px - circle.x, uy = py - circle.y, vx = x - circle.x, vy = y - circle.y;
+		const double angle = std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+
+		if (angle == 0 || (sweep != 0 && (angle > 0) != (sweep > 0)))
+			return false;
+
+		sweep += angle;
+		px = x;
+		py = y;
+	}
+
+	return std::abs(sweep) <= MAX_SWEEP;
+}
+
+bool GCodeArcFitter::replaceRun(Output& out)
+{
+	const Segment& last = m_segments[m_count - 1];
+	Circle circle;
+	double sweep;
+
+	if (m_count < MIN_SEGMENTS || !fitCircle(last, m_count, circle, sweep))
+		return false;
+
+	// Clockwise is G2
+	m_line = (sweep < 0) ? "G2" : "G3";
+
+	appendEndPoint(m_line, DECIMALS);
+	m_line += " I";
+	GCodeCompactor::formatNumber(circle.x - m_runX, DECIMALS, m_line);
+	m_line += " J";
+	GCodeCompactor::formatNumber(circle.y - m_runY, DECIMALS, m_line);
+	appendExtrusion(m_line, DECIMALS, E_DECIMALS);
+
+	out.line(m_line, last.endOffset);
+	return true;
+}
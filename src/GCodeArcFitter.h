@@ -0,0 +1,38 @@
+#ifndef _GCODEARCFITTER_H
+#define _GCODEARCFITTER_H
+#include "GCodeMoveStage.h"
+
+// Replaces runs of short G1 moves lying on a circle with a single G2/G3 arc.
+// Every original point and segment lies within the tolerance of the arc.
+// The printer's firmware has to support arcs (Marlin's ARC_SUPPORT, Klipper's [gcode_arcs]).
+class GCodeArcFitter : public GCodeMoveStage
+{
+public:
+	// tolerance in mm
+	GCodeArcFitter(double tolerance = 0.05);
+
+	const char* name() const override { return "arcs"; }
+
+	// Fewest G1 moves worth replacing with an arc
+	static constexpr size_t MIN_SEGMENTS = 3;
+	// Most G1 moves held back for one arc
+	static constexpr size_t MAX_SEGMENTS = 64;
+	// Larger circles are as good as straight lines
+	static constexpr double MAX_RADIUS = 1000;
+protected:
+	bool fits(const Segment& segment) const override;
+	bool replaceRun(Output& out) override;
+private:
+	struct Circle
+	{
+		double x, y, r;
+	};
+
+	// Circle through the run's first count segments, the last one of which may not be in m_segments yet
+	bool fitCircle(const Segment& last, size_t count, Circle& circle, double& sweep) const;
+private:
+	const double m_tolerance;
+	std::string m_line;
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "GCodeCompactor.h"
+#include <charconv>
+#include <cmath>
+#include <algorithm>
+
+static constexpr int MAX_DECIMALS = 6;
+static constexpr long long POWERS_OF_TEN[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+static inline long long scaled(double value, int decimals)
+{
+	return std::llround(value * POWERS_OF_TEN[decimals]);
+}
+
+GCodeCompactor::GCodeCompactor(int decimals)
+: m_decimals(std::clamp(decimals, 0, MAX_DECIMALS))
+{
+}
+
+void GCodeCompactor::reset(const GCodeState* state)
+{
+	// The resume sequence sets the feedrate, see GCodeState::resumeCommands()
+	m_feedrateKnown = state && state->feedrate > 0;
+	if (m_feedrateKnown)
+		m_feedrate = scaled(state->feedrate, m_decimals);
+}
+
+void GCodeCompactor::process(std::string_view line, size_t endOffset, Output& out)
+{
+	const std::string_view code = GCodeState::commandCode(line);
+
+	if (code == "G0" || code == "G1" || code == "G2" || code == "G3")
+	{
+		if (compact(line))
+		{
+			// Nothing left to say, e.g. "G1 F1800" at F1800
+			if (!m_line.empty())
+				out.line(m_line, endOffset);
+			return;
+		}
+
+		// Passed as it was, it may have changed the feedrate
+		m_feedrateKnown = false;
+	}
+	else if (!code.empty() && (code[0] == 'T' || (code[0] == 'G' && code != "G4" && code != "G90" && code != "G91" && code != "G92")))
+	{
+		// Homing, probing, tool changes... may leave a different feedrate behind
+		m_feedrateKnown = false;
+	}
+
+	out.line(line, endOffset);
+}
+
+bool GCodeCompactor::compact(std::string_view line)
+{
+	const size_t codeLength = line.find(' ');
+
+	m_line.assign(line.data(), std::min(codeLength, line.length()));
+	if (codeLength == std::string_view::npos)
+		return true;
+
+	const size_t codeEnd = m_line.length();
+	bool feedrateKnown = m_feedrateKnown;
+	long long feedrate = m_feedrate;
+	size_t pos = codeLength;
+
+	while (true)
+	{
+		while (pos < line.length() && line[pos] == ' ')
+			pos++;
+		if (pos >= line.length())
+			break;
+
+		size_t end = line.find(' ', pos);
+		if (end == std::string_view::npos)
+			end = line.length();
+
+		const char letter = line[pos];
+		const char* first = line.data() + pos + 1;
+		const char* last = line.data() + end;
+		double value;
+
+		if (letter < 'A' || letter > 'Z')
+			return false;
+
+		// from_chars doesn't accept a leading '+'
+		if (first < last && *first == '+')
+			first++;
+
+		// Anything that isn't a plain number is left as it was
+		auto result = std::from_chars(first, last, value);
+		if (result.ec != std::errc() || result.ptr != last)
+			return false;
+
+		if (letter == 'F')
+		{
+			const long long f = scaled(value, m_decimals);
+
+			if (!feedrateKnown || f != feedrate)
+			{
+				m_line += 'F';
+				formatNumber(value, m_decimals, m_line);
+			}
+
+			feedrateKnown = true;
+			feedrate = f;
+		}
+		else
+		{
+			m_line += letter;
+			formatNumber(value, (letter == 'E') ? std::min(m_decimals + 2, MAX_DECIMALS) : m_decimals, m_line);
+		}
+
+		pos = end;
+	}
+
+	m_feedrateKnown = feedrateKnown;
+	m_feedrate = feedrate;
+
+	// Only the command code left, the move would go nowhere
+	if (m_line.length() == codeEnd)
+		m_line.clear();
+
+	return true;
+}
+
+void GCodeCompactor::formatNumber(double value, int decimals, std::string& out)
+{
+	long long v = scaled(value, decimals);
+
+	if (v < 0)
+	{
+		out += '-';
+		v = -v;
+	}
+
+	const long long integral = v / POWERS_OF_TEN[decimals];
+	long long fraction = v % POWERS_OF_TEN[decimals];
+	char digits[24];
+
+	// Leading zero is redundant, "0.5" is ".5"
+	if (integral != 0 || fraction == 0)
+	{
+		auto result = std::to_chars(digits, digits + sizeof(digits), integral);
+		out.append(digits, result.ptr);
+	}
+
+	if (fraction != 0)
+	{
+		int places = decimals;
+
+		while (fraction % 10 == 0)
+		{
+			fraction /= 10;
+			places--;
+		}
+
+		out += '.';
+		auto result = std::to_chars(digits, digits + sizeof(digits), fraction);
+		out.append(places - (result.ptr - digits), '0');
+		out.append(digits, result.ptr);
+	}
+}
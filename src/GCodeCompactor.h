@@ -0,0 +1,32 @@
+#ifndef _GCODECOMPACTOR_H
+#define _GCODECOMPACTOR_H
+#include "GCodePipeline.h"
+
+// Rewrites moves (G0-G3) to their shortest equivalent: numbers are rounded to the printer's resolution
+// and written without redundant digits, spaces are dropped and F is left out if it doesn't change.
+// "G1 X10.500 Y0.250 F1800" becomes "G1X10.5Y.25" after another move at F1800.
+// Anything else passes unchanged.
+class GCodeCompactor : public GCodeStage
+{
+public:
+	// decimals applies to positions and feedrates, E gets 2 more
+	GCodeCompactor(int decimals = 3);
+
+	const char* name() const override { return "compaction"; }
+
+	void process(std::string_view line, size_t endOffset, Output& out) override;
+	void reset(const GCodeState* state) override;
+
+	// Appends value rounded to the given number of decimals, e.g. ".25" or "-3"
+	static void formatNumber(double value, int decimals, std::string& out);
+private:
+	bool compact(std::string_view line);
+private:
+	const int m_decimals;
+	// Current feedrate as rounded when sent, if known
+	bool m_feedrateKnown = false;
+	long long m_feedrate = 0;
+	std::string m_line;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "GCodeDecimator.h"
+#include <cmath>
+
+static constexpr int DECIMALS = 4;
+// Enough for the sum to be exact
+static constexpr int E_DECIMALS = 6;
+
+GCodeDecimator::GCodeDecimator(double tolerance)
+: GCodeMoveStage(MAX_SEGMENTS), m_tolerance(tolerance)
+{
+}
+
+bool GCodeDecimator::fits(const Segment& segment) const
+{
+	const double dx = segment.x - m_runX, dy = segment.y - m_runY;
+	const double length = std::hypot(dx, dy);
+
+	if (length < 1e-4)
+		return false;
+
+	// Unit vector of the merged move
+	const double ux = dx / length, uy = dy / length;
+	double along = 0;
+
+	for (size_t i = 0; i < m_count; i++)
+	{
+		const double px = m_segments[i].x - m_runX, py = m_segments[i].y - m_runY;
+		const double t = px * ux + py * uy;
+
+		// Off the line, or going back along it
+		if (std::abs(px * uy - py * ux) > m_tolerance || t < along || t > length)
+			return false;
+
+		along = t;
+	}
+
+	return true;
+}
+
+bool GCodeDecimator::replaceRun(Output& out)
+{
+	if (m_count < 2)
+		return false;
+
+	m_line = "G1";
+	appendEndPoint(m_line, DECIMALS);
+	appendExtrusion(m_line, DECIMALS, E_DECIMALS);
+
+	out.line(m_line, m_segments[m_count - 1].endOffset);
+	return true;
+}
@@ -0,0 +1,25 @@
+#ifndef _GCODEDECIMATOR_H
+#define _GCODEDECIMATOR_H
+#include "GCodeMoveStage.h"
+
+// Merges consecutive G1 moves into one if none of the points in between is farther from the straight line than the tolerance.
+// Meant for collinear and sub-resolution segments, the extrusion of the merged moves is added up.
+class GCodeDecimator : public GCodeMoveStage
+{
+public:
+	// tolerance in mm
+	GCodeDecimator(double tolerance = 0.01);
+
+	const char* name() const override { return "decimation"; }
+
+	// Most G1 moves merged into one
+	static constexpr size_t MAX_SEGMENTS = 32;
+protected:
+	bool fits(const Segment& segment) const override;
+	bool replaceRun(Output& out) override;
+private:
+	const double m_tolerance;
+	std::string m_line;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "GCodeMoveStage.h"
+#include "GCodeCompactor.h"
+#include <charconv>
+#include <cmath>
+
+GCodeMoveStage::GCodeMoveStage(size_t maxSegments)
+: m_segments(maxSegments)
+{
+}
+
+void GCodeMoveStage::reset(const GCodeState* state)
+{
+	m_count = 0;
+	m_state = state ? *state : GCodeState();
+	// The head could be anywhere before the file moves it somewhere
+	m_xKnown = m_yKnown = (state != nullptr);
+}
+
+void GCodeMoveStage::process(std::string_view line, size_t endOffset, Output& out)
+{
+	if (!parseMove(line))
+	{
+		flush(out);
+		updatePosition(line);
+		out.line(line, endOffset);
+		return;
+	}
+
+	if (m_count > 0 && !extends(m_candidate))
+		flush(out);
+
+	if (m_count == 0)
+	{
+		m_runX = m_state.x;
+		m_runY = m_state.y;
+	}
+
+	Segment& segment = m_segments[m_count++];
+
+	segment.line.assign(line.data(), line.length());
+	segment.endOffset = endOffset;
+	segment.x = m_candidate.x;
+	segment.y = m_candidate.y;
+	segment.e = m_candidate.e;
+	segment.length = m_candidate.length;
+	segment.feedrate = m_candidate.feedrate;
+	segment.extrudes = m_candidate.extrudes;
+
+	m_state.apply(line);
+
+	if (m_count == m_segments.size())
+		flush(out);
+}
+
+void GCodeMoveStage::finish(Output& out)
+{
+	flush(out);
+}
+
+bool GCodeMoveStage::parseMove(std::string_view line)
+{
+	if (line.length() < 4 || line[0] != 'G' || line[1] != '1' || line[2] != ' ')
+		return false;
+
+	// Absolute coordinates in the output are only right if the starting point is
+	if (!m_state.relativePositioning && !(m_xKnown && m_yKnown))
+		return false;
+
+	double x = m_state.x, y = m_state.y;
+	bool hasXY = false;
+	size_t pos = 2;
+
+	m_candidate.e = 0;
+	m_candidate.feedrate = 0;
+	m_candidate.extrudes = false;
+
+	while (true)
+	{
+		while (pos < line.length() && line[pos] == ' ')
+			pos++;
+		if (pos >= line.length())
+			break;
+
+		size_t end = line.find(' ', pos);
+		if (end == std::string_view::npos)
+			end = line.length();
+
+		const char letter = line[pos];
+		const char* first = line.data() + pos + 1;
+		const char* last = line.data() + end;
+		double value;
+
+		// from_chars doesn't accept a leading '+'
+		if (first < last && *first == '+')
+			first++;
+
+		auto result = std::from_chars(first, last, value);
+		if (result.ec != std::errc() || result.ptr != last)
+			return false;
+
+		switch (letter)
+		{
+			case 'X':
+				x = m_state.relativePositioning ? (m_state.x + value) : value;
+				hasXY = true;
+				break;
+			case 'Y':
+				y = m_state.relativePositioning ? (m_state.y + value) : value;
+				hasXY = true;
+				break;
+			case 'E':
+				m_candidate.e = m_state.extruderRelativePositioning ? value : (value - m_state.e);
+				m_candidate.extrudes = true;
+				break;
+			case 'F':
+				m_candidate.feedrate = value;
+				break;
+			default:
+				// Z moves and anything else end the run
+				return false;
+		}
+
+		pos = end;
+	}
+
+	if (!hasXY)
+		return false;
+
+	m_candidate.x = x;
+	m_candidate.y = y;
+	m_candidate.length = std::hypot(x - m_state.x, y - m_state.y);
+
+	return m_candidate.length > 1e-4;
+}
+
+bool GCodeMoveStage::extends(const Segment& segment) const
+{
+	const Segment& first = m_segments[0];
+
+	if (segment.extrudes != first.extrudes)
+		return false;
+
+	// The run is sent with a single feedrate
+	if (segment.feedrate > 0 && segment.feedrate != m_state.feedrate)
+		return false;
+
+	if (first.extrudes)
+	{
+		const double rate = first.e / first.length;
+
+		if (std::abs(segment.e / segment.length - rate) > EXTRUSION_RATE_VARIANCE * std::abs(rate))
+			return false;
+	}
+
+	return fits(segment);
+}
+
+void GCodeMoveStage::flush(Output& out)
+{
+	if (m_count == 0)
+		return;
+
+	if (!replaceRun(out))
+	{
+		for (size_t i = 0; i < m_count; i++)
+			out.line(m_segments[i].line, m_segments[i].endOffset);
+	}
+
+	m_count = 0;
+}
+
+void GCodeMoveStage::appendEndPoint(std::string& line, int decimals) const
+{
+	const Segment& last = m_segments[m_count - 1];
+
+	line += " X";
+	GCodeCompactor::formatNumber(m_state.relativePositioning ? (last.x - m_runX) : last.x, decimals, line);
+	line += " Y";
+	GCodeCompactor::formatNumber(m_state.relativePositioning ? (last.y - m_runY) : last.y, decimals, line);
+}
+
+void GCodeMoveStage::appendExtrusion(std::string& line, int decimals, int eDecimals) const
+{
+	const Segment& first = m_segments[0];
+
+	if (first.extrudes)
+	{
+		// Runs are only flushed before the next line changes the state
+		double e = m_state.e;
+
+		if (m_state.extruderRelativePositioning)
+		{
+			e = 0;
+			for (size_t i = 0; i < m_count; i++)
+				e += m_segments[i].e;
+		}
+
+		line += " E";
+		GCodeCompactor::formatNumber(e, eDecimals, line);
+	}
+
+	if (first.feedrate > 0)
+	{
+		line += " F";
+		GCodeCompactor::formatNumber(first.feedrate, decimals, line);
+	}
+}
+
+void GCodeMoveStage::updatePosition(std::string_view line)
+{
+	const std::string_view code = GCodeState::commandCode(line);
+
+	if (code == "G28")
+	{
+		// Homed to wherever the endstops are
+		const bool all = line.find_first_of("XYZ", 3) == std::string_view::npos;
+
+		if (all || line.find('X', 3) != std::string_view::npos)
+			m_xKnown = false;
+		if (all || line.find('Y', 3) != std::string_view::npos)
+			m_yKnown = false;
+	}
+	else if (code == "G92" || (!m_state.relativePositioning && (code == "G0" || code == "G1" || code == "G2" || code == "G3")))
+	{
+		double value;
+
+		if (GCodeState::parameter(line, 'X', value))
+			m_xKnown = true;
+		if (GCodeState::parameter(line, 'Y', value))
+			m_yKnown = true;
+	}
+
+	m_state.apply(line);
+}
@@ -0,0 +1,59 @@
+#ifndef _GCODEMOVESTAGE_H
+#define _GCODEMOVESTAGE_H
+#include "GCodePipeline.h"
+
+// Base for stages replacing runs of G1 moves in the XY plane with fewer commands.
+// A run stays at the same Z, extrudes at the same rate per mm (or not at all) and doesn't change the feedrate.
+// Other commands pass unchanged and end the run.
+class GCodeMoveStage : public GCodeStage
+{
+public:
+	void process(std::string_view line, size_t endOffset, Output& out) override;
+	void finish(Output& out) override;
+	void reset(const GCodeState* state) override;
+
+	// Allowed difference in extrusion per mm between the moves of a run
+	static constexpr double EXTRUSION_RATE_VARIANCE = 0.05;
+protected:
+	// At most maxSegments moves are held back
+	GCodeMoveStage(size_t maxSegments);
+
+	struct Segment
+	{
+		std::string line;
+		size_t endOffset;
+		double x, y; // end point
+		double e; // extruded by this move
+		double length;
+		double feedrate; // F of the move, 0 if none
+		bool extrudes;
+	};
+
+	// Whether the move can be appended to the run, which has at least one segment
+	virtual bool fits(const Segment& segment) const = 0;
+	// Emits the run replaced by something shorter, returns false to send its lines as they are
+	virtual bool replaceRun(Output& out) = 0;
+
+	// " X.. Y.." of the run's end point, relative to its start if positioning is relative
+	void appendEndPoint(std::string& line, int decimals) const;
+	// " E.." for the whole run and " F.." if the run's first move had one
+	void appendExtrusion(std::string& line, int decimals, int eDecimals) const;
+protected:
+	GCodeState m_state;
+
+	// The run, starting at m_runX/m_runY
+	std::vector<Segment> m_segments;
+	size_t m_count = 0;
+	double m_runX = 0, m_runY = 0;
+private:
+	// Parses a G1 move that could be part of a run into m_candidate
+	bool parseMove(std::string_view line);
+	bool extends(const Segment& segment) const;
+	void flush(Output& out);
+	void updatePosition(std::string_view line);
+private:
+	bool m_xKnown = false, m_yKnown = false;
+	Segment m_candidate;
+};
+
+#endif
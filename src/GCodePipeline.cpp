@@ -0,0 +1,97 @@
+#include "GCodePipeline.h"
+#include <algorithm>
+
+GCodePipeline::GCodePipeline()
+: m_queue(16)
+{
+}
+
+void GCodePipeline::addStage(std::unique_ptr<GCodeStage> stage)
+{
+	m_stages.push_back(std::move(stage));
+	m_outputs.push_back(std::make_unique<StageOutput>(this, m_stages.size()));
+
+	m_stats.stages.emplace_back();
+	m_stats.stages.back().name = m_stages.back()->name();
+}
+
+void GCodePipeline::StageOutput::line(std::string_view line, size_t endOffset)
+{
+	m_pipeline->feed(m_next, line, endOffset);
+}
+
+void GCodePipeline::push(std::string_view line, size_t endOffset)
+{
+	m_stats.linesIn++;
+	m_stats.bytesIn += line.length();
+
+	feed(0, line, endOffset);
+}
+
+void GCodePipeline::feed(size_t stage, std::string_view line, size_t endOffset)
+{
+	if (stage > 0)
+		m_stats.stages[stage - 1].linesOut++;
+
+	if (stage == m_stages.size())
+		enqueue(line, endOffset);
+	else
+	{
+		m_stats.stages[stage].linesIn++;
+		m_stages[stage]->process(line, endOffset, *m_outputs[stage]);
+	}
+}
+
+void GCodePipeline::finish()
+{
+	// Lines flushed by a stage still go through the ones after it
+	for (size_t i = 0; i < m_stages.size(); i++)
+		m_stages[i]->finish(*m_outputs[i]);
+}
+
+void GCodePipeline::reset(const GCodeState* state)
+{
+	for (auto& stage : m_stages)
+		stage->reset(state);
+
+	m_head = m_count = 0;
+}
+
+void GCodePipeline::enqueue(std::string_view line, size_t endOffset)
+{
+	if (m_count == m_queue.size())
+	{
+		// Unwrap, then grow
+		std::rotate(m_queue.begin(), m_queue.begin() + m_head, m_queue.end());
+		m_head = 0;
+		m_queue.resize(m_queue.size() * 2);
+	}
+
+	Line& entry = m_queue[(m_head + m_count) % m_queue.size()];
+	entry.text.assign(line.data(), line.length());
+	entry.endOffset = endOffset;
+	m_count++;
+
+	m_stats.linesOut++;
+	m_stats.bytesOut += line.length();
+}
+
+bool GCodePipeline::front(std::string_view& line, size_t& endOffset) const
+{
+	if (m_count == 0)
+		return false;
+
+	const Line& entry = m_queue[m_head];
+	line = entry.text;
+	endOffset = entry.endOffset;
+	return true;
+}
+
+void GCodePipeline::pop()
+{
+	if (m_count == 0)
+		return;
+
+	m_head = (m_head + 1) % m_queue.size();
+	m_count--;
+}
@@ -0,0 +1,98 @@
+#ifndef _GCODEPIPELINE_H
+#define _GCODEPIPELINE_H
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "GCodeState.h"
+
+// A step rewriting the lines of a print job on their way to the printer.
+// Lines are stripped (see GCodeReader::stripLine()). Each output line carries the file offset
+// the job would continue from once the printer has confirmed it.
+class GCodeStage
+{
+public:
+	virtual ~GCodeStage() {}
+
+	// Short name for statistics, e.g. "arcs"
+	virtual const char* name() const = 0;
+
+	class Output
+	{
+	public:
+		virtual void line(std::string_view line, size_t endOffset) = 0;
+	};
+
+	// Lines may be held back, but only a bounded number of them
+	virtual void process(std::string_view line, size_t endOffset, Output& out) = 0;
+	// End of the file, emit whatever has been held back
+	virtual void finish(Output&) {}
+	// The job (re)starts in the given state, anything held back is dropped.
+	// state is nullptr when starting from the beginning, the printer's state is unknown then.
+	virtual void reset(const GCodeState*) {}
+};
+
+// Chain of stages with a queue of lines ready to be sent
+class GCodePipeline
+{
+public:
+	GCodePipeline();
+	GCodePipeline(const GCodePipeline&) = delete;
+	GCodePipeline& operator=(const GCodePipeline&) = delete;
+
+	void addStage(std::unique_ptr<GCodeStage> stage);
+	bool empty() const { return m_stages.empty(); }
+
+	void push(std::string_view line, size_t endOffset);
+	void finish();
+	void reset(const GCodeState* state);
+
+	// Oldest line ready to be sent, stays valid until pop()
+	bool front(std::string_view& line, size_t& endOffset) const;
+	void pop();
+
+	struct StageStats
+	{
+		std::string name;
+		size_t linesIn = 0, linesOut = 0;
+	};
+	struct Stats
+	{
+		size_t linesIn = 0, linesOut = 0;
+		size_t bytesIn = 0, bytesOut = 0;
+		// In the order of addStage()
+		std::vector<StageStats> stages;
+	};
+	const Stats& stats() const { return m_stats; }
+private:
+	class StageOutput : public GCodeStage::Output
+	{
+	public:
+		StageOutput(GCodePipeline* pipeline, size_t next) : m_pipeline(pipeline), m_next(next) {}
+		void line(std::string_view line, size_t endOffset) override;
+	private:
+		GCodePipeline* m_pipeline;
+		size_t m_next;
+	};
+
+	void feed(size_t stage, std::string_view line, size_t endOffset);
+	void enqueue(std::string_view line, size_t endOffset);
+private:
+	std::vector<std::unique_ptr<GCodeStage>> m_stages;
+	// m_outputs[i] passes the output of stage i on
+	std::vector<std::unique_ptr<StageOutput>> m_outputs;
+
+	struct Line
+	{
+		std::string text;
+		size_t endOffset;
+	};
+	// Ring buffer, the strings keep their capacity so that steady operation doesn't allocate
+	std::vector<Line> m_queue;
+	size_t m_head = 0, m_count = 0;
+
+	Stats m_stats;
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "GCodeReader.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+GCodeReader::GCodeReader(const char* path)
+{
+	int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		throw std::runtime_error("Cannot open GCODE file");
+
+	struct stat st;
+	if (::fstat(fd, &st) == -1)
+	{
+		::close(fd);
+		throw std::runtime_error("Cannot open GCODE file");
+	}
+
+	m_size = st.st_size;
+
+	if (m_size > 0)
+	{
+		void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED)
+		{
+			::close(fd);
+			throw std::runtime_error("Cannot map GCODE file");
+		}
+
+		::madvise(p, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<const char*>(p);
+	}
+
+	// The mapping stays valid
+	::close(fd);
+}
+
+GCodeReader::~GCodeReader()
+{
+	if (m_data)
+		::munmap(const_cast<char*>(m_data), m_size);
+}
+
+std::string_view GCodeReader::stripLine(std::string_view line)
+{
+	const size_t comment = line.find(';');
+	if (comment != std::string_view::npos)
+		line = line.substr(0, comment);
+
+	const char* ws = " \t\r\v\f";
+	const size_t first = line.find_first_not_of(ws);
+
+	if (first == std::string_view::npos)
+		return std::string_view();
+
+	return line.substr(first, line.find_last_not_of(ws) - first + 1);
+}
+
+bool GCodeReader::nextLine(std::string_view& line)
+{
+	while (m_position < m_size)
+	{
+		const char* start = m_data + m_position;
+		const char* eol = static_cast<const char*>(std::memchr(start, '\n', m_size - m_position));
+		const size_t length = eol ? (eol - start) : (m_size - m_position);
+
+		m_position += eol ? length + 1 : length;
+		line = stripLine(std::string_view(start, length));
+
+		if (!line.empty())
+			return true;
+	}
+
+	line = std::string_view();
+	return false;
+}
+
+void GCodeReader::seek(size_t offset)
+{
+	m_position = lineStart(std::min(offset, m_size));
+}
+
+void GCodeReader::seekToLine(size_t lineNo)
+{
+	m_position = lineOffset(lineNo);
+}
+
+size_t GCodeReader::lineStart(size_t offset) const
+{
+	while (offset > 0 && m_data[offset - 1] != '\n')
+		offset--;
+	return offset;
+}
+
+void GCodeReader::buildIndex() const
+{
+	std::call_once(m_indexed, [this]() {
+		size_t pos = 0;
+
+		while (pos < m_size)
+		{
+			if (m_lineCount % INDEX_STRIDE == 0)
+				m_lineIndex.push_back(pos);
+
+			m_lineCount++;
+
+			const char* eol = static_cast<const char*>(std::memchr(m_data + pos, '\n', m_size - pos));
+			if (!eol)
+				break;
+
+			pos = eol - m_data + 1;
+		}
+
+		m_lineIndex.shrink_to_fit();
+	});
+}
+
+size_t GCodeReader::lineCount() const
+{
+	buildIndex();
+	return m_lineCount;
+}
+
+size_t GCodeReader::lineAt(size_t offset) const
+{
+	buildIndex();
+
+	if (m_lineIndex.empty())
+		return 0;
+
+	// Last recorded line start not beyond offset
+	auto it = std::upper_bound(m_lineIndex.begin(), m_lineIndex.end(), uint64_t(offset));
+	const size_t block = (it - m_lineIndex.begin()) - 1;
+
+	size_t lineNo = block * INDEX_STRIDE;
+	size_t pos = m_lineIndex[block];
+
+	while (pos < offset && pos < m_size)
+	{
+		const char* eol = static_cast<const char*>(std::memchr(m_data + pos, '\n', m_size - pos));
+		if (!eol || size_t(eol - m_data) >= offset)
+			break;
+
+		pos = eol - m_data + 1;
+		lineNo++;
+	}
+
+	return std::min(lineNo, m_lineCount - 1);
+}
+
+size_t GCodeReader::lineOffset(size_t lineNo) const
+{
+	buildIndex();
+
+	if (lineNo >= m_lineCount)
+		return m_size;
+
+	size_t pos = m_lineIndex[lineNo / INDEX_STRIDE];
+
+	for (size_t i = lineNo % INDEX_STRIDE; i > 0; i--)
+		pos = static_cast<const char*>(std::memchr(m_data + pos, '\n', m_size - pos)) - m_data + 1;
+
+	return pos;
+}
@@ -0,0 +1,79 @@
+#ifndef _GCODEREADER_H
+#define _GCODEREADER_H
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+// Reads a G-code file mapped into memory. Lines are handed out as views into the mapping.
+// Line numbers are 0-based and count every line in the file, including comments and blank lines.
+class GCodeReader
+{
+public:
+	GCodeReader(const char* path);
+	GCodeReader(const GCodeReader&) = delete;
+	~GCodeReader();
+
+	GCodeReader& operator=(const GCodeReader&) = delete;
+
+	size_t size() const { return m_size; }
+	std::string_view data() const { return std::string_view(m_data, m_size); }
+
+	// Next line with a G-code command, with comments and surrounding whitespace removed.
+	// Returns false at the end of file.
+	bool nextLine(std::string_view& line);
+
+	// Offset right after the last line returned by nextLine()
+	size_t position() const { return m_position; }
+	// Continue reading at the start of the line containing offset
+	void seek(size_t offset);
+	void seekToLine(size_t lineNo);
+
+	// Start of the line containing offset
+	size_t lineStart(size_t offset) const;
+
+	// These build the line index on first use, from any thread
+	size_t lineCount() const;
+	size_t lineAt(size_t offset) const;
+	size_t lineOffset(size_t lineNo) const;
+
+	// Calls fn(line, offset) for each raw line starting in [begin, end), until fn returns false
+	template<typename Fn>
+	void forEachLine(size_t begin, size_t end, Fn fn) const;
+
+	// Removes the comment and surrounding whitespace
+	static std::string_view stripLine(std::string_view line);
+private:
+	void buildIndex() const;
+private:
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_position = 0;
+
+	// Only every INDEX_STRIDE-th line start is recorded, the rest is found by scanning forward
+	static const size_t INDEX_STRIDE = 64;
+	mutable std::vector<uint64_t> m_lineIndex;
+	mutable size_t m_lineCount = 0;
+	mutable std::once_flag m_indexed;
+};
+
+template<typename Fn>
+void GCodeReader::forEachLine(size_t begin, size_t end, Fn fn) const
+{
+	size_t pos = begin;
+
+	while (pos < end && pos < m_size)
+	{
+		const char* eol = static_cast<const char*>(std::memchr(m_data + pos, '\n', m_size - pos));
+		const size_t length = eol ? (eol - m_data - pos) : (m_size - pos);
+
+		if (!fn(std::string_view(m_data + pos, length), pos))
+			break;
+
+		pos += length + 1;
+	}
+}
+
+#endif
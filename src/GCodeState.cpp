@@ -0,0 +1,158 @@
+#include "GCodeState.h"
+#include <sstream>
+#include <iomanip>
+
+std::string_view GCodeState::commandCode(std::string_view line)
+{
+	return line.substr(0, line.find(' '));
+}
+
+bool GCodeState::parameter(std::string_view line, char letter, double& value)
+{
+	bool found = false;
+
+	forEachParameter(line, [&](char l, double v) {
+		if (l != letter)
+			return true;
+
+		value = v;
+		found = true;
+		return false;
+	});
+
+	return found;
+}
+
+void GCodeState::apply(std::string_view line)
+{
+	if (line.length() < 2)
+		return;
+
+	const std::string_view code = commandCode(line);
+	double value;
+
+	if (code[0] == 'G')
+	{
+		if (code == "G0" || code == "G1" || code == "G2" || code == "G3")
+		{
+			forEachParameter(line, [&](char letter, double v) {
+				switch (letter)
+				{
+					case 'X':
+						x = relativePositioning ? (x + v) : v;
+						break;
+					case 'Y':
+						y = relativePositioning ? (y + v) : v;
+						break;
+					case 'Z':
+						z = relativePositioning ? (z + v) : v;
+						break;
+					case 'E':
+						e = extruderRelativePositioning ? (e + v) : v;
+						break;
+					case 'F':
+						feedrate = v;
+						break;
+				}
+				return true;
+			});
+		}
+		else if (code == "G92")
+		{
+			forEachParameter(line, [&](char letter, double v) {
+				switch (letter)
+				{
+					case 'X':
+						x = v;
+						break;
+					case 'Y':
+						y = v;
+						break;
+					case 'Z':
+						z = v;
+						break;
+					case 'E':
+						e = v;
+						break;
+				}
+				return true;
+			});
+		}
+		else if (code == "G28")
+		{
+			const bool all = line.find_first_of("XYZ", 3) == std::string_view::npos;
+
+			if (all || line.find('X', 3) != std::string_view::npos)
+				x = 0;
+			if (all || line.find('Y', 3) != std::string_view::npos)
+				y = 0;
+			if (all || line.find('Z', 3) != std::string_view::npos)
+				z = 0;
+		}
+		else if (code == "G90")
+			relativePositioning = extruderRelativePositioning = false;
+		else if (code == "G91")
+			relativePositioning = extruderRelativePositioning = true;
+	}
+	else if (code[0] == 'M')
+	{
+		if (code == "M82")
+			extruderRelativePositioning = false;
+		else if (code == "M83")
+			extruderRelativePositioning = true;
+		else if (code == "M104" || code == "M109")
+		{
+			if (parameter(line, 'S', value) || parameter(line, 'R', value))
+				hotendTarget = value;
+		}
+		else if (code == "M140" || code == "M190")
+		{
+			if (parameter(line, 'S', value) || parameter(line, 'R', value))
+				bedTarget = value;
+		}
+		else if (code == "M106")
+			fanSpeed = parameter(line, 'S', value) ? int(value) : 255;
+		else if (code == "M107")
+			fanSpeed = 0;
+	}
+}
+
+void GCodeState::resumeCommands(std::vector<std::string>& commands) const
+{
+	auto fmt = [](double v) {
+		std::ostringstream ss;
+		ss << std::fixed << std::setprecision(3) << v;
+		return ss.str();
+	};
+
+	// Heat up first
+	if (bedTarget > 0)
+		commands.push_back("M140 S" + fmt(bedTarget));
+	if (hotendTarget > 0)
+		commands.push_back("M104 S" + fmt(hotendTarget));
+	if (bedTarget > 0)
+		commands.push_back("M190 S" + fmt(bedTarget));
+	if (hotendTarget > 0)
+		commands.push_back("M109 S" + fmt(hotendTarget));
+
+	// Lift the nozzle off the print, then home X and Y only
+	commands.push_back("G92 Z" + fmt(z));
+	commands.push_back("G91");
+	commands.push_back("G0 Z2");
+	commands.push_back("G90");
+	commands.push_back("G28 X Y");
+
+	// Go back to where the job was and lower the nozzle
+	commands.push_back("G0 X" + fmt(x) + " Y" + fmt(y) + " F3000");
+	commands.push_back("G0 Z" + fmt(z));
+	commands.push_back("G92 E" + fmt(e));
+
+	commands.push_back(fanSpeed > 0 ? "M106 S" + std::to_string(fanSpeed) : "M107");
+
+	if (relativePositioning)
+		commands.push_back("G91");
+	commands.push_back(extruderRelativePositioning ? "M83" : "M82");
+
+	if (feedrate > 0)
+		commands.push_back("G1 F" + fmt(feedrate));
+}
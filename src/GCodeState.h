@@ -0,0 +1,69 @@
+#ifndef _GCODESTATE_H
+#define _GCODESTATE_H
+#include <string_view>
+#include <string>
+#include <vector>
+#include <charconv>
+
+// Modal state of the printer as left behind by a sequence of G-code commands.
+// Used to continue a job from the middle without sending what came before.
+struct GCodeState
+{
+	bool relativePositioning = false;
+	bool extruderRelativePositioning = false;
+
+	double x = 0, y = 0, z = 0, e = 0;
+	double feedrate = 0; // mm/min, 0 if never set
+
+	float hotendTarget = 0, bedTarget = 0;
+	int fanSpeed = 0; // 0-255
+
+	// Updates the state with a stripped G-code line (see GCodeReader::stripLine())
+	void apply(std::string_view line);
+
+	// Commands that bring a freshly reset printer into this state.
+	// X and Y are homed, the head is assumed to still be at the recorded Z.
+	void resumeCommands(std::vector<std::string>& commands) const;
+
+	// "G1" for "G1 X10 Y20"
+	static std::string_view commandCode(std::string_view line);
+	// Value of the parameter with the given letter, e.g. 'X'
+	static bool parameter(std::string_view line, char letter, double& value);
+	// Calls fn(letter, value) for every parameter of the command in a single pass, until fn returns false
+	template<typename Fn>
+	static void forEachParameter(std::string_view line, Fn fn);
+};
+
+template<typename Fn>
+void GCodeState::forEachParameter(std::string_view line, Fn fn)
+{
+	// Skip the command code
+	size_t pos = line.find(' ');
+
+	while (pos != std::string_view::npos)
+	{
+		while (pos < line.length() && line[pos] == ' ')
+			pos++;
+		if (pos + 1 >= line.length())
+			break;
+
+		const char letter = line[pos];
+		const char* first = line.data() + pos + 1;
+		const char* last = line.data() + line.length();
+		double value;
+
+		// from_chars doesn't accept a leading '+'
+		if (*first == '+')
+			first++;
+
+		if (std::from_chars(first, last, value).ec == std::errc())
+		{
+			if (!fn(letter, value))
+				break;
+		}
+
+		pos = line.find(' ', pos);
+	}
+}
+
+#endif
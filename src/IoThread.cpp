@@ -0,0 +1,42 @@
+#include "IoThread.h"
+#include <boost/log/trivial.hpp>
+#include <pthread.h>
+
+IoThread::IoThread(const std::string& name)
+: m_io(std::make_shared<boost::asio::io_service>()), m_work(boost::asio::make_work_guard(*m_io))
+{
+	m_thread = std::thread([io = m_io, name]() {
+		::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+
+		while (!io->stopped())
+		{
+			try
+			{
+				io->run();
+			}
+			catch (const std::exception& e)
+			{
+				BOOST_LOG_TRIVIAL(error) << "Unhandled exception on thread " << name << ": " << e.what();
+			}
+		}
+	});
+}
+
+IoThread::~IoThread()
+{
+	stop();
+}
+
+void IoThread::stop()
+{
+	if (!m_thread.joinable())
+		return;
+
+	m_work.reset();
+	m_io->stop();
+
+	if (m_thread.get_id() == std::this_thread::get_id())
+		m_thread.detach();
+	else
+		m_thread.join();
+}
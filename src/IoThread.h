@@ -0,0 +1,32 @@
+#ifndef _IOTHREAD_H
+#define _IOTHREAD_H
+#include <boost/asio.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+
+// An io_service with a thread of its own running it until stop() or destruction.
+// Handlers throwing exceptions are logged, the thread carries on.
+class IoThread
+{
+public:
+	// name shows up in ps/top, up to 15 characters are kept
+	IoThread(const std::string& name);
+	IoThread(const IoThread&) = delete;
+	~IoThread();
+
+	IoThread& operator=(const IoThread&) = delete;
+
+	boost::asio::io_service& io() { return *m_io; }
+	std::thread::native_handle_type nativeHandle() { return m_thread.native_handle(); }
+
+	// Pending handlers are dropped. When called from the thread itself, it's left to finish on its own.
+	void stop();
+private:
+	// Shared with the thread, which may outlive this object (see stop())
+	std::shared_ptr<boost::asio::io_service> m_io;
+	boost::asio::executor_work_guard<boost::asio::io_service::executor_type> m_work;
+	std::thread m_thread;
+};
+
+#endif
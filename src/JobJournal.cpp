@@ -0,0 +1,209 @@
+#include "JobJournal.h"
+#include <stdexcept>
+#include <cstring>
+#include <boost/crc.hpp>
+#include <boost/log/trivial.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Minimum time between two writes (and syncs) of the journal
+static constexpr std::chrono::seconds UPDATE_INTERVAL(2);
+
+static constexpr uint32_t HEADER_MAGIC = 0x314a5044; // "DPJ1"
+static constexpr uint32_t ENTRY_MAGIC = 0x454a5044; // "DPJE"
+
+// The header is written once per job, entries alternate between two slots after it.
+// A torn write can only damage the slot being written, the other one still holds the previous entry.
+static constexpr size_t HEADER_SIZE = 4096;
+static constexpr size_t SLOT_SIZE = 512;
+static constexpr size_t MAX_JOB_NAME = HEADER_SIZE - 64;
+
+struct JournalHeader
+{
+	uint32_t magic;
+	uint32_t crc;
+	uint64_t fileSize;
+	uint32_t nameLength;
+	char name[MAX_JOB_NAME];
+};
+
+struct JournalSlot
+{
+	uint32_t magic;
+	uint32_t crc;
+	uint64_t sequence;
+	uint64_t offset;
+	float hotendTarget, bedTarget;
+	uint8_t relativePositioning, extruderRelativePositioning;
+	uint8_t reserved[6];
+};
+
+static_assert(sizeof(JournalHeader) <= HEADER_SIZE, "Journal header too big");
+static_assert(sizeof(JournalSlot) <= SLOT_SIZE, "Journal slot too big");
+
+template<typename T>
+static uint32_t checksum(T data)
+{
+	boost::crc_32_type crc;
+
+	data.crc = 0;
+	crc.process_bytes(&data, sizeof(data));
+	return crc.checksum();
+}
+
+JobJournal::JobJournal(const std::string& path, std::string_view jobName, uint64_t fileSize)
+: m_path(path)
+{
+	m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (m_fd == -1)
+		throw std::runtime_error("Cannot create the job journal");
+
+	JournalHeader header;
+	std::memset(&header, 0, sizeof(header));
+
+	header.magic = HEADER_MAGIC;
+	header.fileSize = fileSize;
+	header.nameLength = std::min(jobName.length(), MAX_JOB_NAME);
+	std::memcpy(header.name, jobName.data(), header.nameLength);
+	header.crc = checksum(header);
+
+	if (::pwrite(m_fd, &header, sizeof(header), 0) != sizeof(header) || ::fdatasync(m_fd) == -1)
+	{
+		::close(m_fd);
+		throw std::runtime_error("Cannot write the job journal");
+	}
+
+	m_thread = std::thread(&JobJournal::writerThread, this);
+}
+
+JobJournal::~JobJournal()
+{
+	stopWriter();
+
+	if (m_fd != -1)
+		::close(m_fd);
+}
+
+void JobJournal::stopWriter()
+{
+	if (!m_thread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+
+	m_cond.notify_one();
+	m_thread.join();
+}
+
+void JobJournal::update(const Entry& entry)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_entry = entry;
+		m_pending = true;
+	}
+
+	m_cond.notify_one();
+	m_nextUpdate = std::chrono::steady_clock::now() + UPDATE_INTERVAL;
+}
+
+void JobJournal::remove()
+{
+	stopWriter();
+
+	if (m_fd != -1)
+	{
+		::close(m_fd);
+		m_fd = -1;
+	}
+
+	::unlink(m_path.c_str());
+}
+
+void JobJournal::writerThread()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (true)
+	{
+		m_cond.wait(lock, [this]() { return m_pending || m_quit; });
+
+		if (m_pending)
+		{
+			Entry entry = m_entry;
+			m_pending = false;
+
+			// Don't hold up update() while waiting for the storage
+			lock.unlock();
+			writeEntry(entry);
+			lock.lock();
+		}
+		else if (m_quit)
+			break;
+	}
+}
+
+void JobJournal::writeEntry(const Entry& entry)
+{
+	JournalSlot slot;
+	std::memset(&slot, 0, sizeof(slot));
+
+	slot.magic = ENTRY_MAGIC;
+	slot.sequence = ++m_sequence;
+	slot.offset = entry.offset;
+	slot.hotendTarget = entry.hotendTarget;
+	slot.bedTarget = entry.bedTarget;
+	slot.relativePositioning = entry.relativePositioning;
+	slot.extruderRelativePositioning = entry.extruderRelativePositioning;
+	slot.crc = checksum(slot);
+
+	const off_t pos = HEADER_SIZE + (m_sequence % 2) * SLOT_SIZE;
+
+	if (::pwrite(m_fd, &slot, sizeof(slot), pos) != sizeof(slot) || ::fdatasync(m_fd) == -1)
+		BOOST_LOG_TRIVIAL(warning) << "Failed to update the job journal " << m_path << ": " << std::strerror(errno);
+}
+
+bool JobJournal::read(const std::string& path, Contents& contents)
+{
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return false;
+
+	JournalHeader header;
+	JournalSlot slots[2];
+	bool valid = false;
+
+	if (::pread(fd, &header, sizeof(header), 0) == sizeof(header) && header.magic == HEADER_MAGIC
+		&& header.crc == checksum(header) && header.nameLength <= MAX_JOB_NAME)
+	{
+		valid = true;
+		contents.jobName.assign(header.name, header.nameLength);
+		contents.fileSize = header.fileSize;
+		contents.entry = Entry();
+
+		uint64_t sequence = 0;
+
+		for (int i = 0; i < 2; i++)
+		{
+			const JournalSlot& slot = slots[i];
+
+			if (::pread(fd, &slots[i], sizeof(slot), HEADER_SIZE + i * SLOT_SIZE) != sizeof(slot))
+				continue;
+			if (slot.magic != ENTRY_MAGIC || slot.crc != checksum(slot) || slot.sequence <= sequence)
+				continue;
+
+			sequence = slot.sequence;
+			contents.entry.offset = slot.offset;
+			contents.entry.hotendTarget = slot.hotendTarget;
+			contents.entry.bedTarget = slot.bedTarget;
+			contents.entry.relativePositioning = slot.relativePositioning;
+			contents.entry.extruderRelativePositioning = slot.extruderRelativePositioning;
+		}
+	}
+
+	::close(fd);
+	return valid;
+}
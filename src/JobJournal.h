@@ -0,0 +1,63 @@
+#ifndef _JOBJOURNAL_H
+#define _JOBJOURNAL_H
+#include <string>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+// Crash-safe record of how far a print job got, so that it can be resumed after a power loss.
+// Updates are written out by a background thread and synced to disk at a bounded rate.
+class JobJournal
+{
+public:
+	struct Entry
+	{
+		uint64_t offset = 0; // Where the job would continue
+		bool relativePositioning = false;
+		bool extruderRelativePositioning = false;
+		float hotendTarget = 0, bedTarget = 0;
+	};
+
+	// Starts a new journal, replacing any previous one at path. Throws std::runtime_error.
+	JobJournal(const std::string& path, std::string_view jobName, uint64_t fileSize);
+	JobJournal(const JobJournal&) = delete;
+	~JobJournal();
+
+	JobJournal& operator=(const JobJournal&) = delete;
+
+	// Whether another update would be written out now, checked for every confirmed line
+	bool due() const { return std::chrono::steady_clock::now() >= m_nextUpdate; }
+	void update(const Entry& entry);
+
+	// The job has finished or has been stopped, there's nothing to resume
+	void remove();
+
+	struct Contents
+	{
+		std::string jobName;
+		uint64_t fileSize;
+		Entry entry;
+	};
+	// Returns false if there's no usable journal at path
+	static bool read(const std::string& path, Contents& contents);
+private:
+	void writerThread();
+	void writeEntry(const Entry& entry);
+	void stopWriter();
+private:
+	std::string m_path;
+	int m_fd;
+	uint64_t m_sequence = 0;
+	std::chrono::steady_clock::time_point m_nextUpdate;
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	Entry m_entry;
+	bool m_pending = false, m_quit = false;
+};
+
+#endif
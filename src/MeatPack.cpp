@@ -0,0 +1,147 @@
+#include "MeatPack.h"
+#include <array>
+
+static constexpr uint8_t NOT_PACKED = 0xf;
+static constexpr uint8_t SIGNAL_BYTE = 0xff;
+
+static constexpr uint8_t COMMAND_ENABLE = 0xfb;
+static constexpr uint8_t COMMAND_DISABLE = 0xfa;
+static constexpr uint8_t COMMAND_RESET = 0xf9;
+
+const std::string_view MeatPack::ENABLE("\xff\xff\xfb", 3);
+const std::string_view MeatPack::DISABLE("\xff\xff\xfa", 3);
+
+// The order defines the 4-bit codes
+static constexpr char PACKED_CHARS[] = "0123456789. \nGX";
+
+static constexpr std::array<uint8_t, 256> makePackingTable()
+{
+	std::array<uint8_t, 256> table = {};
+
+	for (size_t i = 0; i < table.size(); i++)
+		table[i] = NOT_PACKED;
+	for (uint8_t i = 0; i < sizeof(PACKED_CHARS) - 1; i++)
+		table[uint8_t(PACKED_CHARS[i])] = i;
+
+	return table;
+}
+
+static constexpr std::array<uint8_t, 256> PACKING_TABLE = makePackingTable();
+
+void MeatPack::pack(std::string_view line, std::string& out)
+{
+	for (size_t i = 0; i < line.length(); i += 2)
+	{
+		const char first = line[i];
+		// The firmware ignores whatever follows a newline in the same byte
+		const char second = (i + 1 < line.length()) ? line[i + 1] : ' ';
+		const uint8_t firstCode = PACKING_TABLE[uint8_t(first)];
+		const uint8_t secondCode = PACKING_TABLE[uint8_t(second)];
+
+		out += char(firstCode | (secondCode << 4));
+
+		if (firstCode == NOT_PACKED)
+			out += first;
+		if (secondCode == NOT_PACKED)
+			out += second;
+	}
+}
+
+void MeatPack::Unpacker::feed(std::string_view data, std::string& out)
+{
+	for (char c : data)
+	{
+		const uint8_t byte = uint8_t(c);
+
+		if (m_commandNext)
+		{
+			m_commandNext = false;
+			handleCommand(byte);
+		}
+		else if (byte == SIGNAL_BYTE)
+		{
+			// Two signal bytes in a row announce a command, a single one is data
+			if (m_signalBytes == 1)
+			{
+				m_signalBytes = 0;
+				m_commandNext = true;
+			}
+			else
+				m_signalBytes = 1;
+		}
+		else
+		{
+			if (m_signalBytes == 1)
+			{
+				m_signalBytes = 0;
+				handleByte(SIGNAL_BYTE, out);
+			}
+			handleByte(byte, out);
+		}
+	}
+}
+
+void MeatPack::Unpacker::handleCommand(uint8_t command)
+{
+	switch (command)
+	{
+		case COMMAND_ENABLE:
+			m_active = true;
+			break;
+		case COMMAND_DISABLE:
+		case COMMAND_RESET:
+			m_active = false;
+			break;
+	}
+
+	m_fullChars = 0;
+	m_pendingChar = 0;
+}
+
+void MeatPack::Unpacker::handleByte(uint8_t byte, std::string& out)
+{
+	if (!m_active)
+	{
+		out += char(byte);
+		return;
+	}
+
+	if (m_fullChars > 0)
+	{
+		out += char(byte);
+
+		// The second character was packed, but comes after the first one sent in full
+		if (m_pendingChar)
+		{
+			out += m_pendingChar;
+			m_pendingChar = 0;
+		}
+
+		m_fullChars--;
+		return;
+	}
+
+	const uint8_t firstCode = byte & 0xf, secondCode = byte >> 4;
+
+	if (firstCode == NOT_PACKED)
+	{
+		m_fullChars++;
+
+		if (secondCode == NOT_PACKED)
+			m_fullChars++;
+		else
+			m_pendingChar = PACKED_CHARS[secondCode];
+	}
+	else
+	{
+		out += PACKED_CHARS[firstCode];
+
+		if (PACKED_CHARS[firstCode] != '\n')
+		{
+			if (secondCode == NOT_PACKED)
+				m_fullChars++;
+			else
+				out += PACKED_CHARS[secondCode];
+		}
+	}
+}
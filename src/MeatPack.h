@@ -0,0 +1,38 @@
+#ifndef _MEATPACK_H
+#define _MEATPACK_H
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// MeatPack wire compression: the 15 characters most common in G-code are packed into 4 bits,
+// two of them per byte. Anything else is sent in full after the packed byte.
+// Lines are packed independently of each other, which keeps resends simple.
+class MeatPack
+{
+public:
+	// Appends the packed form of line, which must end with '\n'
+	static void pack(std::string_view line, std::string& out);
+
+	// Signal sequences switching the firmware's unpacker on and off
+	static const std::string_view ENABLE;
+	static const std::string_view DISABLE;
+
+	// What the firmware does with the received data
+	class Unpacker
+	{
+	public:
+		void feed(std::string_view data, std::string& out);
+		bool active() const { return m_active; }
+	private:
+		void handleCommand(uint8_t command);
+		void handleByte(uint8_t byte, std::string& out);
+	private:
+		bool m_active = false;
+		bool m_commandNext = false;
+		int m_signalBytes = 0;
+		int m_fullChars = 0;
+		char m_pendingChar = 0;
+	};
+};
+
+#endif
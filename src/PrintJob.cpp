@@ -3,68 +3,419 @@
 //
 
 #include "PrintJob.h"
+#include "GCodeState.h"
+#include "GCodeCompactor.h"
+#include "GCodeArcFitter.h"
+#include "GCodeDecimator.h"
 #include <stdexcept>
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/filesystem.hpp>
+#include <sstream>
+#include <cmath>
+#include <cctype>
+#include <algorithm>
+
+// How often M73 is sent to the printer for files that don't contain it
+static constexpr std::chrono::seconds PROGRESS_COMMAND_INTERVAL(30);
+// Distance between the entries mapping the file on the SD card to the job's file
+static constexpr size_t SD_MAP_INTERVAL = 4096;
+// Marlin terminates the lines it writes with "\r\n"
+static constexpr size_t SD_LINE_TERMINATOR = 2;
+
+// "M73 P45 R12" as emitted by PrusaSlicer and others
+static inline bool isProgressCommand(std::string_view line)
+{
+	return line.length() >= 3 && line[0] == 'M' && line[1] == '7' && line[2] == '3' && (line.length() == 3 || line[3] == ' ');
+}
 
 PrintJob::PrintJob(std::shared_ptr<Printer> printer, std::string_view fileName, const char* filePath)
-: m_printer(printer), m_printerUniqueName(printer->uniqueName()), m_jobName(fileName)
+: m_reader(filePath), m_printer(printer), m_printerUniqueName(printer->uniqueName()), m_jobName(fileName)
+{
+	m_size = m_reader.size();
+	loadTimeTable(filePath);
+}
+
+PrintJob::~PrintJob()
 {
-	m_file.open(filePath);
+	if (m_estimatorThread.joinable())
+	{
+		m_cancelEstimate = true;
+		m_estimatorThread.join();
+	}
+}
+
+void PrintJob::loadTimeTable(const std::string& filePath)
+{
+	const std::string tablePath = TimeTable::pathFor(filePath);
+	int64_t modifiedTime;
+
+	try
+	{
+		modifiedTime = boost::filesystem::last_write_time(filePath);
+	}
+	catch (const std::exception& e)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Print job on " << m_printerUniqueName << " has no time estimate: " << e.what();
+		return;
+	}
+
+	auto table = std::make_shared<TimeTable>();
+
+	if (table->load(tablePath, m_size, modifiedTime))
+	{
+		m_timeTable = table;
+		return;
+	}
+
+	// Takes a few seconds for big files, the job may start meanwhile.
+	// The thread only reads the mapped file, which stays there until it's joined.
+	m_estimatorThread = std::thread([=]() {
+		auto start = std::chrono::steady_clock::now();
+
+		if (!TimeEstimator::estimate(m_reader, *table, &m_cancelEstimate))
+			return;
 
-	if (!m_file.is_open())
-		throw std::runtime_error("Cannot open GCODE file");
+		BOOST_LOG_TRIVIAL(info) << "Estimated print time of " << m_jobName << ": " << int(table->totalTime()) << " s, computed in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms";
 
-	m_file.seekg(0, std::ios_base::end);
-	m_size = m_file.tellg();
+		try
+		{
+			table->save(tablePath, m_size, modifiedTime);
+		}
+		catch (const std::exception& e)
+		{
+			BOOST_LOG_TRIVIAL(warning) << "Time estimate of " << m_jobName << " not stored: " << e.what();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_timeTable = table;
+	});
 }
 
 void PrintJob::start()
 {
 	if (m_state != State::Paused)
 	{
-		m_timeElapsed = std::chrono::seconds::zero();
-		m_file.seekg(0, std::ios_base::beg);
+		startAt(0);
+		return;
 	}
-	else
+
+	if (m_sdPhase != SdPhase::None)
 	{
-		std::shared_ptr<Printer> printer = m_printer.lock();
+		resumeFromSd();
+		return;
+	}
 
-		if (printer)
-		{
-			// Move the extruder back
-			printer->sendCommand("G0 Z-5", nullptr);
+	std::vector<std::string> preamble;
+
+	// Move the extruder back
+	preamble.push_back("G0 Z-5");
+
+	// Restore the original positioning mode
+	if (!m_positioningBeforePause.relativePositioning)
+	{
+		preamble.push_back("G90");
+		if (m_positioningBeforePause.extruderRelativePositioning)
+			preamble.push_back("M83");
+	}
+	else if (!m_positioningBeforePause.extruderRelativePositioning)
+		preamble.push_back("M82");
+
+	// Moves made while paused may have changed the feedrate, the job's lines don't necessarily repeat it
+	if (m_positioningBeforePause.feedrate > 0)
+	{
+		std::ostringstream cmd;
+		cmd << "G1 F" << m_positioningBeforePause.feedrate;
+		preamble.push_back(cmd.str());
+	}
+
+	preamble.push_back("M117 Job resumed");
+
+	run(preamble);
+}
+
+PrintJob::StartPoint PrintJob::startPoint(size_t offset) const
+{
+	StartPoint start;
+
+	start.offset = m_reader.lineStart(std::min(offset, m_size));
+
+	if (start.offset > 0)
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		m_reader.forEachLine(0, start.offset, [&](std::string_view line, size_t lineOffset) {
+			line = GCodeReader::stripLine(line);
+			start.state.apply(line);
+
+			if (isProgressCommand(line))
+				parseProgressCommand(line, lineOffset, start.reported);
+			return true;
+		});
+
+		BOOST_LOG_TRIVIAL(info) << "Print job on " << m_printerUniqueName << ": state at offset " << start.offset << " restored in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count() << " ms";
+	}
+
+	return start;
+}
+
+void PrintJob::startAt(const StartPoint& start)
+{
+	if (m_state == State::Running)
+		return;
+
+	const size_t offset = start.offset;
+	m_reader.seek(offset);
+
+	m_timeElapsed = std::chrono::seconds::zero();
+	m_position = m_readPosition = m_reportedPosition = offset;
+	m_eof = false;
+	m_havePeekedLine = false;
+
+	m_reported = start.reported;
+	m_emitProgress = true;
+	m_nextProgressCommand = std::chrono::steady_clock::now();
+
+	std::vector<std::string> preamble;
+
+	if (offset > 0)
+	{
+		start.state.resumeCommands(preamble);
+		preamble.push_back("M117 Job resumed");
+
+		BOOST_LOG_TRIVIAL(info) << "Print job on " << m_printerUniqueName << " starting at offset " << offset;
+	}
+
+	setupPipeline((offset > 0) ? &start.state : nullptr);
+	setupSdOffload(offset);
+	run(preamble);
+}
+
+void PrintJob::setupSdOffload(size_t offset)
+{
+	std::shared_ptr<Printer> printer = m_printer.lock();
+
+	// A previous attempt may still be open, e.g. paused
+	if (printer && m_sdPhase == SdPhase::Printing)
+		printer->sendCommand("M524", nullptr);
+
+	m_sdStatusConnection.disconnect();
+	m_sdPhase = SdPhase::None;
+	m_sdStarted = false;
+
+	if (!printer || !printer->sdOffload())
+		return;
+
+	if (!printer->hasCapability("SDCARD"))
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Printer " << m_printerUniqueName << " has no SD card, the job is sent from here";
+		return;
+	}
+
+	m_sdPhase = SdPhase::Uploading;
+	m_sdFileName = sdFileName(m_jobName);
+	m_sdMap.assign(1, std::make_pair(size_t(0), offset));
+	m_sdBytes = 0;
+	m_uploadStart = m_uploadPosition = offset;
+}
+
+std::string PrintJob::sdFileName(std::string_view jobName)
+{
+	const size_t slash = jobName.rfind('/');
+	if (slash != std::string_view::npos)
+		jobName.remove_prefix(slash + 1);
+
+	std::string name;
 
-			// Restore the original positioning mode
-			if (!m_positioningBeforePause.relativePositioning)
+	for (char c : jobName.substr(0, jobName.rfind('.')))
+	{
+		if (std::isalnum((unsigned char) c))
+			name += std::toupper((unsigned char) c);
+		if (name.length() == 8)
+			break;
+	}
+
+	if (name.empty())
+		name = "DASHPRNT";
+
+	return name + ".GCO";
+}
+
+void PrintJob::setupPipeline(const GCodeState* state)
+{
+	std::shared_ptr<Printer> printer = m_printer.lock();
+
+	m_pipeline.reset();
+
+	if (!printer)
+		return;
+
+	auto pipeline = std::make_unique<GCodePipeline>();
+
+	// Straight runs are merged before looking for arcs, arcs are compacted too
+	if (printer->decimation())
+		pipeline->addStage(std::make_unique<GCodeDecimator>(printer->decimationTolerance()));
+	if (printer->arcFitting())
+		pipeline->addStage(std::make_unique<GCodeArcFitter>(printer->arcTolerance()));
+	if (printer->compaction())
+		pipeline->addStage(std::make_unique<GCodeCompactor>(printer->compactionDecimals()));
+
+	// Lines go straight from the file without any stages
+	if (pipeline->empty())
+		return;
+
+	pipeline->reset(state);
+	m_pipeline = std::move(pipeline);
+}
+
+void PrintJob::run(const std::vector<std::string>& preamble)
+{
+	std::shared_ptr<Printer> printer = m_printer.lock();
+
+	try
+	{
+		if (!printer)
+			throw std::runtime_error("The printer is gone");
+		if (printer->state() != Printer::State::Connected)
+			throw std::runtime_error("The printer is not connected");
+	}
+	catch (const std::exception& e)
+	{
+		setError(e.what());
+		return;
+	}
+
+	for (const std::string& cmd : preamble)
+		printer->sendCommand(cmd.c_str(), nullptr);
+
+	if (m_sdPhase == SdPhase::Uploading)
+	{
+		std::weak_ptr<PrintJob> weakSelf = shared_from_this();
+		const std::string fileName = m_sdFileName;
+
+		// The job's lines go into the file until M29, checked and resent like any other lines
+		printer->sendCommand(("M28 " + m_sdFileName).c_str(), [weakSelf, fileName](const std::vector<std::string>& reply) {
+			std::shared_ptr<PrintJob> self = weakSelf.lock();
+
+			for (const std::string& line : reply)
 			{
-				printer->sendCommand("G90", nullptr);
-				if (m_positioningBeforePause.extruderRelativePositioning)
-					printer->sendCommand("M83", nullptr);
+				if (self && boost::starts_with(line, "open failed"))
+					self->setError("Cannot write " + fileName + " to the SD card");
 			}
-			else if (!m_positioningBeforePause.extruderRelativePositioning)
-				printer->sendCommand("M82", nullptr);
+		});
 
-			printer->sendCommand("M117 Job resumed", nullptr);
-		}
+		m_uploadStartTime = std::chrono::steady_clock::now();
 	}
 
+	m_progressInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(printer->progressRate() > 0 ? (1 / printer->progressRate()) : 0));
+	m_progressMinDelta = size_t(m_size * printer->progressMinDelta() / 100);
+
 	setState(State::Running);
 	m_startTime = std::chrono::steady_clock::now();
-	printLine();
+
+	// Nothing to resume from here if the host goes away, the printer carries on with an SD print
+	if (!m_journal && !printer->journalPath().empty() && m_sdPhase == SdPhase::None)
+	{
+		try
+		{
+			m_journal.reset(new JobJournal(printer->journalPath(), m_jobName, m_size));
+			updateJournal();
+		}
+		catch (const std::exception& e)
+		{
+			BOOST_LOG_TRIVIAL(warning) << "Print job on " << m_printerUniqueName << " runs without a journal: " << e.what();
+		}
+	}
+
+	// The printer pulls the lines from now on, after the preamble
+	printer->setJobSource(shared_from_this());
+}
+
+size_t PrintJob::lineOffset(size_t line) const
+{
+	if (line >= m_reader.lineCount())
+		throw std::out_of_range("No such line");
+
+	return m_reader.lineOffset(line);
+}
+
+// Layer change comments of Cura, PrusaSlicer/SuperSlicer and Simplify3D
+static bool isLayerMarker(std::string_view line)
+{
+	const size_t start = line.find_first_not_of(" \t");
+
+	if (start == std::string_view::npos || line[start] != ';')
+		return false;
+
+	line = line.substr(start);
+	return boost::starts_with(line, ";LAYER:") || boost::starts_with(line, ";LAYER_CHANGE")
+		|| boost::starts_with(line, "; layer ");
+}
+
+size_t PrintJob::layerOffset(size_t layer) const
+{
+	size_t found = std::string::npos, markers = 0;
+
+	m_reader.forEachLine(0, m_reader.size(), [&](std::string_view line, size_t offset) {
+		if (isLayerMarker(line) && markers++ == layer)
+		{
+			found = offset;
+			return false;
+		}
+		return true;
+	});
+
+	if (markers == 0)
+	{
+		// No comments from the slicer, each move to a new highest Z starts a layer
+		GCodeState state;
+		double maxZ = 0;
+		size_t layers = 0;
+
+		m_reader.forEachLine(0, m_reader.size(), [&](std::string_view line, size_t offset) {
+			line = GCodeReader::stripLine(line);
+			state.apply(line);
+
+			// G92 only redefines the position
+			if (state.z > maxZ && GCodeState::commandCode(line) != "G92")
+			{
+				maxZ = state.z;
+				if (layers++ == layer)
+				{
+					found = offset;
+					return false;
+				}
+			}
+			return true;
+		});
+	}
+
+	if (found == std::string::npos)
+		throw std::out_of_range("No such layer");
+
+	return found;
 }
 
 void PrintJob::stop()
 {
 	m_timeElapsed += std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_startTime);
+
+	const SdPhase sdPhase = m_sdPhase;
 	setState(State::Stopped);
 
 	std::shared_ptr<Printer> printer = m_printer.lock();
 
 	if (printer)
 	{
+		// Close the file being written, or abort printing it
+		if (sdPhase == SdPhase::Uploading)
+			printer->sendCommand(("M29 " + m_sdFileName).c_str(), nullptr);
+		else if (sdPhase == SdPhase::Printing)
+			printer->sendCommand("M524", nullptr);
+
 		// Disable steppers
 		printer->sendCommand("M18", nullptr);
 		// Fan off
@@ -90,14 +441,24 @@ void PrintJob::pause()
 	setState(State::Paused);
 
 	std::shared_ptr<Printer> printer = m_printer.lock();
+
+	// While uploading, the lines just stop coming. The firmware parks the head itself when pausing an SD print.
+	if (m_sdPhase == SdPhase::Uploading)
+		return;
+	if (m_sdPhase == SdPhase::Printing)
+	{
+		printer->sendCommand("M25", nullptr);
+		return;
+	}
+
 	m_positioningBeforePause = printer->positioningState();
 
-	// Pause sequence (move extruder away)
+	// Pause sequence (move extruder away), ahead of anything else waiting to be sent
 	if (!m_positioningBeforePause.relativePositioning)
-		printer->sendCommand("G91", nullptr);
-	printer->sendCommand("G0 Z5", nullptr);
+		printer->sendPriorityCommand("G91", nullptr);
+	printer->sendPriorityCommand("G0 Z5", nullptr);
 
-	printer->sendCommand("M117 Job paused", nullptr);
+	printer->sendPriorityCommand("M117 Job paused", nullptr);
 }
 
 void PrintJob::setError(std::string_view error)
@@ -112,69 +473,113 @@ void PrintJob::setError(std::string_view error)
 	setState(State::Error);
 }
 
-std::string PrintJob::nextLine()
+bool PrintJob::peekLine(std::string_view& line)
 {
-	std::string line;
+	if (m_state != State::Running)
+		return false;
 
-	do
+	if (!m_havePeekedLine)
 	{
-		std::getline(m_file, line);
+		if (m_eof || !nextLine())
+		{
+			m_eof = true;
+			checkDone();
+			return false;
+		}
 
-		std::string::size_type pos = line.find(';');
-		if (pos != std::string::npos)
-			line.resize(pos);
+		m_havePeekedLine = true;
 
-		boost::algorithm::trim(line);
+		// Uploading isn't printing, the progress is taken from the SD print later
+		if (m_peekedLine[0] == 'M' && m_sdPhase == SdPhase::None && isProgressCommand(m_peekedLine))
+			parseProgressCommand(m_peekedLine, m_readPosition, m_reported);
 	}
-	while (line.empty() && !m_file.eof() && !m_file.bad());
 
-	m_position = m_file.tellg();
-	if (m_file.eof())
-		m_position = m_size;
-	return line;
+	line = m_peekedLine;
+	return true;
 }
 
-void PrintJob::printLine()
+bool PrintJob::nextLine()
 {
-	std::shared_ptr<Printer> printer = m_printer.lock();
-
-	try
+	if (!m_pipeline)
 	{
-		std::string line = nextLine();
+		if (!m_reader.nextLine(m_peekedLine))
+			return false;
 
-		if (!printer)
-			throw std::runtime_error("The printer is gone");
-		if (printer->state() != Printer::State::Connected)
-			throw std::runtime_error("The printer is not connected");
+		m_readPosition = m_reader.position();
+		return true;
+	}
+
+	std::string_view line;
 
-		if (!line.empty())
+	// Stages may swallow lines or hold them back
+	while (!m_pipeline->front(m_peekedLine, m_readPosition))
+	{
+		if (!m_reader.nextLine(line))
 		{
-			// Send another line to the printer
-			printer->sendCommand(line.c_str(), std::bind(&PrintJob::lineProcessed, this, std::placeholders::_1));
+			m_pipeline->finish();
+			return m_pipeline->front(m_peekedLine, m_readPosition);
 		}
-		else
-		{
-			// Print job done
-			m_timeElapsed += std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_startTime);
 
-			setState(State::Done);
-		}
+		m_pipeline->push(line, m_reader.position());
 	}
-	catch (const std::exception& e)
+
+	return true;
+}
+
+size_t PrintJob::lineSent()
+{
+	if (m_sdPhase == SdPhase::Uploading)
 	{
-		setError(e.what());
-		return;
+		m_sdBytes += m_peekedLine.length() + SD_LINE_TERMINATOR;
+
+		if (m_sdBytes >= m_sdMap.back().first + SD_MAP_INTERVAL)
+			m_sdMap.emplace_back(m_sdBytes, m_readPosition);
 	}
+
+	if (m_pipeline)
+		m_pipeline->pop();
+
+	m_havePeekedLine = false;
+	m_linesQueued++;
+
+	return m_readPosition;
 }
 
-void PrintJob::lineProcessed(const std::vector<std::string>& resp)
+void PrintJob::lineDone(size_t position, bool success)
 {
+	m_linesQueued--;
+
 	try
 	{
-		m_progressChangeSignal(m_position);
+		if (!success)
+		{
+			std::shared_ptr<Printer> printer = m_printer.lock();
+
+			if (m_state == State::Running && (!printer || printer->state() != Printer::State::Connected))
+				throw std::runtime_error("The printer is not connected");
+			return;
+		}
+
+		if (m_sdPhase == SdPhase::Uploading)
+		{
+			m_uploadPosition = position;
+			checkDone();
+			return;
+		}
 
-		if (m_state == State::Running)
-			printLine();
+		const auto now = std::chrono::steady_clock::now();
+
+		m_position = position;
+		if (now >= m_nextProgressEvent && m_position >= m_reportedPosition + m_progressMinDelta)
+			reportProgress(now);
+
+		if (m_journal && m_journal->due())
+			updateJournal();
+
+		if (m_emitProgress && now >= m_nextProgressCommand)
+			sendProgressCommand();
+
+		checkDone();
 	}
 	catch (const std::exception &e)
 	{
@@ -182,10 +587,93 @@ void PrintJob::lineProcessed(const std::vector<std::string>& resp)
 	}
 }
 
+void PrintJob::reportProgress(std::chrono::steady_clock::time_point now)
+{
+	m_nextProgressEvent = now + m_progressInterval;
+	m_reportedPosition = m_position;
+	m_progressChangeSignal(m_position);
+}
+
+void PrintJob::checkDone()
+{
+	if (m_state == State::Running && m_eof && m_linesQueued == 0)
+	{
+		// The printer tells when an SD print is done
+		if (m_sdPhase == SdPhase::Uploading)
+			finishUpload();
+		if (m_sdPhase != SdPhase::None)
+			return;
+
+		// Print job done
+		m_timeElapsed += std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_startTime);
+
+		setState(State::Done);
+	}
+}
+
+void PrintJob::updateJournal()
+{
+	std::shared_ptr<Printer> printer = m_printer.lock();
+	JobJournal::Entry entry;
+
+	entry.offset = m_position;
+
+	if (printer)
+	{
+		Printer::PositioningState positioning = printer->positioningState();
+		auto temperatures = printer->getTemperatures();
+
+		entry.relativePositioning = positioning.relativePositioning;
+		entry.extruderRelativePositioning = positioning.extruderRelativePositioning;
+		entry.hotendTarget = temperatures["T"].target;
+		entry.bedTarget = temperatures["B"].target;
+	}
+
+	m_journal->update(entry);
+}
+
 void PrintJob::setState(State state)
 {
 	if (state != m_state)
 	{
+		// Deliver the last position held back by coalescing
+		if (m_state == State::Running && m_position != m_reportedPosition)
+			reportProgress(std::chrono::steady_clock::now());
+
+		if (m_pipeline && (state == State::Done || state == State::Stopped))
+		{
+			const GCodePipeline::Stats& stats = m_pipeline->stats();
+
+			BOOST_LOG_TRIVIAL(info) << "Print job on " << m_printerUniqueName << " sent " << stats.linesOut << " lines, "
+				<< stats.bytesOut << " bytes instead of " << stats.linesIn << " lines, " << stats.bytesIn << " bytes";
+
+			for (const GCodePipeline::StageStats& stage : stats.stages)
+				BOOST_LOG_TRIVIAL(info) << "  " << stage.name << ": " << stage.linesIn << " -> " << stage.linesOut << " lines";
+		}
+
+		// The printer's reports aren't needed anymore
+		if (m_sdPhase != SdPhase::None && (state == State::Done || state == State::Stopped || state == State::Error))
+		{
+			std::shared_ptr<Printer> printer = m_printer.lock();
+
+			m_sdStatusConnection.disconnect();
+			if (printer && m_sdPhase == SdPhase::Printing)
+				printer->setSdStatusReports(false);
+			m_sdPhase = SdPhase::None;
+		}
+
+		if (m_journal)
+		{
+			// Keep the journal unless the job could still be resumed
+			if (state == State::Done || state == State::Stopped)
+			{
+				m_journal->remove();
+				m_journal.reset();
+			}
+			else if (m_state == State::Running)
+				updateJournal();
+		}
+
 		m_state = state;
 		m_stateChangeSignal(state, m_errorString);
 	}
@@ -226,6 +714,238 @@ void PrintJob::progress(size_t& pos, size_t& total) const
 	total = m_size;
 }
 
+void PrintJob::lineProgress(size_t& line, size_t& total) const
+{
+	total = m_reader.lineCount();
+	line = (m_state == State::Done) ? total : m_reader.lineAt(m_position);
+}
+
+std::shared_ptr<const TimeTable> PrintJob::timeTable() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_timeTable;
+}
+
+bool PrintJob::timeProgress(double& done, double& total) const
+{
+	std::shared_ptr<const TimeTable> table = timeTable();
+
+	if (!table)
+		return false;
+
+	total = table->totalTime();
+	done = (m_state == State::Done) ? total : table->timeAt(m_position);
+	return true;
+}
+
+bool PrintJob::remainingTime(int& seconds) const
+{
+	if (m_state == State::Done)
+	{
+		seconds = 0;
+		return true;
+	}
+
+	std::shared_ptr<const TimeTable> table = timeTable();
+
+	if (m_reported.remaining >= 0)
+	{
+		double remaining = m_reported.remaining;
+
+		// M73 usually comes once a minute, count down in between using the estimate
+		if (table && m_position > m_reported.remainingOffset)
+			remaining -= table->timeAt(m_position) - table->timeAt(m_reported.remainingOffset);
+
+		seconds = std::max(0, int(remaining));
+		return true;
+	}
+
+	if (!table)
+		return false;
+
+	seconds = int(table->totalTime() - table->timeAt(m_position));
+	return true;
+}
+
+void PrintJob::parseProgressCommand(std::string_view line, size_t offset, ReportedProgress& reported)
+{
+	// The Q and S variants are for the silent mode of Prusa printers
+	GCodeState::forEachParameter(line, [&](char letter, double value) {
+		if (letter == 'P')
+			reported.percent = int(value);
+		else if (letter == 'R')
+		{
+			reported.remaining = value * 60;
+			reported.remainingOffset = offset;
+		}
+		return true;
+	});
+
+	reported.present = true;
+}
+
+void PrintJob::sendProgressCommand()
+{
+	if (m_reported.present)
+	{
+		m_emitProgress = false;
+		return;
+	}
+
+	// Wait for the estimate, it also tells if there's M73 further in the file
+	std::shared_ptr<const TimeTable> table = timeTable();
+	if (!table)
+	{
+		m_nextProgressCommand = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		return;
+	}
+
+	m_nextProgressCommand = std::chrono::steady_clock::now() + PROGRESS_COMMAND_INTERVAL;
+
+	if (table->hasProgressCommands())
+	{
+		m_emitProgress = false;
+		return;
+	}
+
+	std::shared_ptr<Printer> printer = m_printer.lock();
+	if (!printer)
+		return;
+
+	const double total = table->totalTime();
+	const double done = table->timeAt(m_position);
+	std::ostringstream cmd;
+
+	cmd << "M73 P" << int(total > 0 ? (done * 100 / total) : 100) << " R" << int(std::ceil((total - done) / 60));
+	printer->sendCommand(cmd.str().c_str(), nullptr);
+}
+
+void PrintJob::resumeFromSd()
+{
+	std::shared_ptr<Printer> printer = m_printer.lock();
+
+	if (!printer || printer->state() != Printer::State::Connected)
+	{
+		setError("The printer is not connected");
+		return;
+	}
+
+	setState(State::Running);
+	m_startTime = std::chrono::steady_clock::now();
+
+	if (m_sdPhase == SdPhase::Printing)
+		printer->sendCommand("M24", nullptr);
+	else
+		printer->setJobSource(shared_from_this());
+}
+
+void PrintJob::finishUpload()
+{
+	std::shared_ptr<Printer> printer = m_printer.lock();
+	if (!printer)
+		return;
+
+	const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_uploadStartTime).count();
+
+	BOOST_LOG_TRIVIAL(info) << "Print job on " << m_printerUniqueName << " uploaded to " << m_sdFileName << ": " << m_sdBytes << " bytes in "
+		<< int(duration * 1000) << " ms, " << int(m_sdBytes / std::max(duration, 0.001) / 1024) << " kB/s";
+
+	m_sdMap.emplace_back(m_sdBytes, m_size);
+	m_sdPhase = SdPhase::Printing;
+	m_uploadPosition = m_size;
+
+	std::weak_ptr<PrintJob> weakSelf = shared_from_this();
+	const std::string fileName = m_sdFileName;
+
+	m_sdStatusConnection = printer->sdStatusSignal().connect([weakSelf](Printer::SdStatus status) {
+		if (std::shared_ptr<PrintJob> self = weakSelf.lock())
+			self->sdStatusReport(status);
+	});
+
+	printer->sendCommand(("M29 " + m_sdFileName).c_str(), nullptr);
+	printer->sendCommand(("M23 " + m_sdFileName).c_str(), [weakSelf, fileName](const std::vector<std::string>& reply) {
+		std::shared_ptr<PrintJob> self = weakSelf.lock();
+
+		for (const std::string& line : reply)
+		{
+			if (self && boost::starts_with(line, "open failed"))
+				self->setError("Cannot open " + fileName + " on the SD card");
+		}
+	});
+	printer->sendCommand("M24", nullptr);
+	printer->setSdStatusReports(true);
+}
+
+void PrintJob::sdStatusReport(Printer::SdStatus status)
+{
+	if (m_sdPhase != SdPhase::Printing || !inProgress())
+		return;
+
+	switch (status.state)
+	{
+		case Printer::SdStatus::State::Printing:
+		{
+			const auto now = std::chrono::steady_clock::now();
+
+			m_sdStarted = true;
+			m_position = sdToFilePosition(status.position);
+
+			if (m_state == State::Running && now >= m_nextProgressEvent && m_position >= m_reportedPosition + m_progressMinDelta)
+				reportProgress(now);
+
+			if (m_emitProgress && now >= m_nextProgressCommand)
+				sendProgressCommand();
+			break;
+		}
+		case Printer::SdStatus::State::Done:
+			m_position = m_size;
+			m_timeElapsed += std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_startTime);
+			setState(State::Done);
+			break;
+		case Printer::SdStatus::State::NotPrinting:
+			// Aborted on the printer itself
+			if (m_sdStarted)
+				setError("The printer is not printing from the SD card anymore");
+			break;
+	}
+}
+
+size_t PrintJob::sdToFilePosition(size_t sdPosition) const
+{
+	auto it = std::upper_bound(m_sdMap.begin(), m_sdMap.end(), sdPosition, [](size_t value, const std::pair<size_t, size_t>& entry) {
+		return value < entry.first;
+	});
+
+	if (it == m_sdMap.begin())
+		return m_sdMap.front().second;
+	if (it == m_sdMap.end())
+		return m_sdMap.back().second;
+
+	const std::pair<size_t, size_t>& before = *(it - 1);
+	const std::pair<size_t, size_t>& after = *it;
+
+	return before.second + (after.second - before.second) * (sdPosition - before.first) / (after.first - before.first);
+}
+
+bool PrintJob::uploadProgress(size_t& done, size_t& total) const
+{
+	if (m_sdPhase != SdPhase::Uploading)
+		return false;
+
+	done = m_uploadPosition - m_uploadStart;
+	total = m_size - m_uploadStart;
+	return true;
+}
+
+bool PrintJob::pipelineStats(GCodePipeline::Stats& stats) const
+{
+	if (!m_pipeline)
+		return false;
+
+	stats = m_pipeline->stats();
+	return true;
+}
+
 std::chrono::seconds PrintJob::timeElapsed() const
 {
 	auto s = m_timeElapsed;
@@ -4,20 +4,49 @@
 
 #ifndef DASHPRINT_PRINTJOB_H
 #define DASHPRINT_PRINTJOB_H
-#include <fstream>
 #include <memory>
 #include <boost/signals2.hpp>
 #include <mutex>
 #include <chrono>
 #include <string_view>
 #include "Printer.h"
+#include "GCodeReader.h"
+#include "JobJournal.h"
+#include "TimeEstimator.h"
+#include "GCodePipeline.h"
+#include <thread>
+#include <atomic>
 
-class PrintJob : public std::enable_shared_from_this<PrintJob>
+class PrintJob : public Printer::JobSource, public std::enable_shared_from_this<PrintJob>
 {
 public:
 	PrintJob(std::shared_ptr<Printer> printer, std::string_view fileName, const char* filePath);
+	~PrintJob();
+
+	// Last M73 seen in the file
+	struct ReportedProgress
+	{
+		int percent = -1;
+		double remaining = -1; // s
+		size_t remainingOffset = 0;
+		bool present = false;
+	};
+
+	// Where startAt() continues and the state that the skipped part of the file leaves the printer in.
+	// Replays the whole skipped part, but only reads the file, so it's meant to be made off the printer's thread.
+	struct StartPoint
+	{
+		size_t offset = 0;
+		GCodeState state;
+		ReportedProgress reported;
+	};
+	StartPoint startPoint(size_t offset) const;
 
 	void start();
+	// Starts from the line containing offset instead of the beginning, unless the job is running.
+	// The state that the skipped part would have left the printer in is restored first.
+	void startAt(size_t offset) { startAt(startPoint(offset)); }
+	void startAt(const StartPoint& start);
 	void stop();
 	void pause();
 
@@ -34,7 +63,33 @@ public:
 	static const char* stateString(State state);
 	std::string errorString() const;
 	void progress(size_t& pos, size_t& total) const;
+	size_t fileSize() const { return m_size; }
+	// Line being printed (0-based) and the total line count
+	void lineProgress(size_t& line, size_t& total) const;
+	// Estimated print time in seconds, based on a simulation of the printer's motion.
+	// Returns false while the estimate isn't available yet.
+	bool timeProgress(double& done, double& total) const;
+	// Seconds left, from M73 R in the file if it has any, otherwise from the estimate.
+	// Returns false if neither is available.
+	bool remainingTime(int& seconds) const;
+	// Percentage done as reported by M73 P in the file, -1 if the file doesn't report it
+	int reportedProgress() const { return m_reported.percent; }
+	// Lines and bytes read from the file vs. handed over to the printer after rewriting.
+	// Returns false if the lines are sent as they are.
+	bool pipelineStats(GCodePipeline::Stats& stats) const;
 	const std::string& name() const { return m_jobName; }
+
+	// The job is uploaded to the printer's SD card and printed from there, see Printer::sdOffload().
+	// Progress stays at the start until the upload is done.
+	bool printingFromSd() const { return m_sdPhase != SdPhase::None; }
+	// Started with a journal that's still there, see Printer::journalPath()
+	bool hasJournal() const { return !!m_journal; }
+	// File bytes uploaded so far and in total, returns false unless uploading
+	bool uploadProgress(size_t& done, size_t& total) const;
+
+	// Offsets for startAt(), line and layer are 0-based. Throw std::out_of_range if there's no such line/layer.
+	size_t lineOffset(size_t line) const;
+	size_t layerOffset(size_t layer) const;
 	inline bool inProgress() const { return m_state == State::Running || m_state == State::Paused; }
 
 	std::chrono::seconds timeElapsed() const;
@@ -43,13 +98,34 @@ public:
 	boost::signals2::signal<void(size_t)>& progressChangeSignal() { return m_progressChangeSignal; }
 protected:
 	void setError(std::string_view error);
+
+	// Printer::JobSource
+	bool peekLine(std::string_view& line) override;
+	size_t lineSent() override;
+	void lineDone(size_t position, bool success) override;
 private:
-	void printLine();
-	void lineProcessed(const std::vector<std::string>& resp);
+	void run(const std::vector<std::string>& preamble);
+	void setupPipeline(const GCodeState* state);
+	bool nextLine();
+	void updateJournal();
+	void loadTimeTable(const std::string& filePath);
+	std::shared_ptr<const TimeTable> timeTable() const;
+	static void parseProgressCommand(std::string_view line, size_t offset, ReportedProgress& reported);
+	void sendProgressCommand();
+	void reportProgress(std::chrono::steady_clock::time_point now);
+	void checkDone();
 	void setState(State state);
-	std::string nextLine();
+
+	void setupSdOffload(size_t offset);
+	void resumeFromSd();
+	void finishUpload();
+	void sdStatusReport(Printer::SdStatus status);
+	// Maps a byte of the file on the SD card to the job's file
+	size_t sdToFilePosition(size_t sdPosition) const;
+	// An 8.3 name, as some firmwares won't take anything else
+	static std::string sdFileName(std::string_view jobName);
 private:
-	std::ifstream m_file;
+	GCodeReader m_reader;
 	const std::string m_printerUniqueName;
 	std::weak_ptr<Printer> m_printer;
 	State m_state = State::Stopped;
@@ -59,13 +135,54 @@ private:
 
 	boost::signals2::signal<void(State, std::string)> m_stateChangeSignal;
 	boost::signals2::signal<void(size_t)> m_progressChangeSignal;
-	size_t m_position = 0, m_size;
+	size_t m_position = 0, m_readPosition = 0, m_size;
+	// Lines handed over to the printer, but not confirmed yet
+	size_t m_linesQueued = 0;
+	bool m_eof = false;
+
+	// Read ahead by peekLine(), ends at m_readPosition
+	std::string_view m_peekedLine;
+	bool m_havePeekedLine = false;
+
+	// Optional stages rewriting the lines, e.g. GCodeCompactor
+	std::unique_ptr<GCodePipeline> m_pipeline;
 
 	const std::string m_jobName;
 	std::chrono::steady_clock::time_point m_startTime;
 	std::chrono::seconds m_timeElapsed;
 
 	Printer::PositioningState m_positioningBeforePause;
+	std::unique_ptr<JobJournal> m_journal;
+
+	// Set once loaded or computed by m_estimatorThread, protected by m_mutex
+	std::shared_ptr<const TimeTable> m_timeTable;
+	std::thread m_estimatorThread;
+	std::atomic<bool> m_cancelEstimate = false;
+
+	ReportedProgress m_reported;
+
+	// m_progressChangeSignal is coalesced, see Printer::progressRate()
+	std::chrono::steady_clock::duration m_progressInterval;
+	size_t m_progressMinDelta = 0; // bytes
+	size_t m_reportedPosition = 0;
+	std::chrono::steady_clock::time_point m_nextProgressEvent;
+
+	// M73 sent to the printer's display for files without their own
+	bool m_emitProgress = true;
+	std::chrono::steady_clock::time_point m_nextProgressCommand;
+
+	enum class SdPhase { None, Uploading, Printing };
+	SdPhase m_sdPhase = SdPhase::None;
+	std::string m_sdFileName;
+	// Bytes written to the SD card and the job's file offsets they correspond to, a pair every few kB
+	std::vector<std::pair<size_t, size_t>> m_sdMap;
+	size_t m_sdBytes = 0;
+	// File offsets where the upload started and up to which it has been confirmed
+	size_t m_uploadStart = 0, m_uploadPosition = 0;
+	std::chrono::steady_clock::time_point m_uploadStartTime;
+	// M27 has reported the print running
+	bool m_sdStarted = false;
+	boost::signals2::scoped_connection m_sdStatusConnection;
 
 	friend class Printer;
 };
@@ -13,30 +13,103 @@
 
 #include "Printer.h"
 #include "PrintJob.h"
+#include "MeatPack.h"
+#include "VirtualPrinter.h"
+#include "CaptureReplayer.h"
+#include "SerialCapture.h"
+#include "IoThread.h"
+#include "RealtimeScheduling.h"
 #include <iostream>
 #include <sys/ioctl.h>
 #include <termios.h>
 #include <cstring>
+#include <charconv>
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/log/trivial.hpp>
 
 #include <ctype.h>
 #include <termios.h>
 
 static const boost::posix_time::seconds RECONNECT_DELAY(5);
-static const std::chrono::minutes MAX_TEMPERATURE_HISTORY(30);
+static const boost::posix_time::seconds TEMPERATURE_POLL_INTERVAL(5);
+static const boost::posix_time::seconds SD_STATUS_INTERVAL(2);
+// Temperature reports missed before falling back to polling
+static const int MISSED_TEMPERATURE_REPORTS = 3;
+// How long to wait for the firmware to reject lines that followed a line it wants resent
+static const boost::posix_time::milliseconds RESEND_SETTLE_DELAY(100);
+// Wake-up probes while connected, often only when the thread is meant to run in real time
+static constexpr std::chrono::milliseconds WAKEUP_PROBE_INTERVAL(10);
+static constexpr std::chrono::milliseconds IDLE_WAKEUP_PROBE_INTERVAL(1000);
 static constexpr int DATA_TIMEOUT = 5000;
 static constexpr int MAX_LINENO = 10000;
+static constexpr size_t MAX_IN_FLIGHT = 32;
+static constexpr size_t READ_CHUNK_SIZE = 512;
+static constexpr size_t MAX_REPLY_LINE_LENGTH = 4096; // incomplete data beyond this is dropped
+static const std::string RESET_LINENO_COMMAND = "M110 N0";
+
+static std::string_view commandCode(std::string_view cmd)
+{
+	return cmd.substr(0, cmd.find(' '));
+}
+
+Printer::Printer()
+		: Printer(std::make_unique<IoThread>("printer"))
+{
+	post([this]() { m_realtime = RealtimeScheduling::enter(); });
+}
 
 Printer::Printer(boost::asio::io_service &io)
-		: m_io(io), m_serial(io), m_socket(io), m_reconnectTimer(io), m_timeoutTimer(io), m_temperatureTimer(io)
+		: Printer(io, nullptr)
 {
 }
 
+Printer::Printer(std::unique_ptr<IoThread>&& thread)
+		: Printer(thread->io(), std::move(thread))
+{
+}
+
+Printer::Printer(boost::asio::io_service &io, std::unique_ptr<IoThread>&& thread)
+		: m_snapshot(std::make_shared<Snapshot>()), m_thread(std::move(thread)), m_io(io), m_serial(io), m_socket(io),
+		m_reconnectTimer(io), m_timeoutTimer(io), m_temperatureTimer(io), m_resendTimer(io), m_sdStatusTimer(io),
+		m_wakeupTimer(io)
+{
+	// Enough for most lines, so that the history doesn't allocate while streaming
+	for (GCodeEvent& event : m_gcodeHistory)
+		event.data.reserve(128);
+}
+
 Printer::~Printer()
 {
-	reset();
+	if (m_thread)
+	{
+		// Nothing may run on the thread anymore once the members start going away
+		call([this]() {
+			m_wakeupTimer.cancel();
+			reset();
+		});
+		m_thread->stop();
+	}
+	else
+	{
+		m_wakeupTimer.cancel();
+		reset();
+	}
+}
+
+void Printer::post(std::function<void()> fn)
+{
+	m_io.post(std::move(fn));
+}
+
+void Printer::publishSnapshot()
+{
+	auto snapshot = std::make_shared<Snapshot>();
+
+	snapshot->state = m_state;
+	snapshot->errorMessage = m_errorMessage;
+	snapshot->printJob = m_printJob;
+
+	std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
 }
 
 void Printer::load(const boost::property_tree::ptree& tree)
@@ -47,6 +120,23 @@ void Printer::load(const boost::property_tree::ptree& tree)
 	m_printArea.width = tree.get<int>("width");
 	m_printArea.height = tree.get<int>("height");
 	m_printArea.depth = tree.get<int>("depth");
+	m_streaming = tree.get<bool>("streaming", false);
+	m_meatPackAllowed = tree.get<bool>("meatpack", true);
+	m_compaction = tree.get<bool>("compaction", false);
+	setCompactionDecimals(tree.get<int>("compaction_decimals", 3));
+	m_arcFitting = tree.get<bool>("arc_fitting", false);
+	setArcTolerance(tree.get<double>("arc_tolerance", 0.05));
+	m_decimation = tree.get<bool>("decimation", false);
+	setDecimationTolerance(tree.get<double>("decimation_tolerance", 0.01));
+	m_rxBufferSize = tree.get<int>("rx_buffer_size", 127);
+	setProgressRate(tree.get<double>("progress_rate", 4));
+	setProgressMinDelta(tree.get<double>("progress_min_delta", 0));
+	setTemperatureReportInterval(tree.get<int>("temperature_report_interval", 2));
+	m_sdOffload = tree.get<bool>("sd_offload", false);
+	m_serialTuning.lowLatency = tree.get<bool>("low_latency", true);
+	m_serialTuning.vmin = tree.get<int>("vmin", 1);
+	m_serialTuning.vtime = tree.get<int>("vtime", 0);
+	m_serialTuning.usbCdc = tree.get<bool>("usb_cdc", false);
 
 	if (!tree.get<bool>("stopped"))
 		start();
@@ -61,6 +151,23 @@ void Printer::save(boost::property_tree::ptree& tree)
 	tree.put("width", m_printArea.width);
 	tree.put("height", m_printArea.height);
 	tree.put("depth", m_printArea.depth);
+	tree.put("streaming", m_streaming);
+	tree.put("meatpack", m_meatPackAllowed);
+	tree.put("compaction", m_compaction);
+	tree.put("compaction_decimals", m_compactionDecimals);
+	tree.put("arc_fitting", m_arcFitting);
+	tree.put("arc_tolerance", m_arcTolerance);
+	tree.put("decimation", m_decimation);
+	tree.put("decimation_tolerance", m_decimationTolerance);
+	tree.put("rx_buffer_size", m_rxBufferSize);
+	tree.put("progress_rate", m_progressRate);
+	tree.put("progress_min_delta", m_progressMinDelta);
+	tree.put("temperature_report_interval", m_temperatureReportInterval);
+	tree.put("sd_offload", m_sdOffload);
+	tree.put("low_latency", m_serialTuning.lowLatency);
+	tree.put("vmin", m_serialTuning.vmin);
+	tree.put("vtime", m_serialTuning.vtime);
+	tree.put("usb_cdc", m_serialTuning.usbCdc);
 }
 
 const char* Printer::stateName(State state)
@@ -112,6 +219,25 @@ void Printer::setBaudRate(int rate)
 	}
 }
 
+void Printer::setSerialTuning(const SerialTuning& tuning)
+{
+	if (m_serialTuning != tuning)
+	{
+		m_serialTuning = tuning;
+		deviceSettingsChanged();
+	}
+}
+
+void Printer::setStreaming(bool streaming)
+{
+	m_streaming = streaming;
+}
+
+void Printer::setRxBufferSize(int size)
+{
+	m_rxBufferSize = std::max(size, 32);
+}
+
 void Printer::deviceSettingsChanged()
 {
 	if (m_state != State::Stopped)
@@ -140,6 +266,67 @@ void Printer::stop()
 	reset();
 }
 
+void Printer::startCapture(const std::string& path)
+{
+	// Replays start at the next connection, the firmware's state before it is unknown
+	auto capture = std::make_shared<SerialCapture>(path);
+
+	std::unique_lock<std::mutex> lock(m_captureMutex);
+	m_capture = capture;
+
+	BOOST_LOG_TRIVIAL(info) << "Capturing the traffic of printer " << m_uniqueName << " into " << path;
+}
+
+void Printer::stopCapture()
+{
+	std::shared_ptr<SerialCapture> capture;
+
+	{
+		std::unique_lock<std::mutex> lock(m_captureMutex);
+		capture.swap(m_capture);
+	}
+
+	// Written out as the last reference goes away
+	if (capture)
+		BOOST_LOG_TRIVIAL(info) << "Stopped capturing the traffic of printer " << m_uniqueName;
+}
+
+std::shared_ptr<SerialCapture> Printer::capture() const
+{
+	std::unique_lock<std::mutex> lock(m_captureMutex);
+	return m_capture;
+}
+
+PrinterStats Printer::stats() const
+{
+	std::unique_lock<std::mutex> lock(m_statsMutex);
+	return m_stats;
+}
+
+void Printer::resetStats()
+{
+	std::unique_lock<std::mutex> lock(m_statsMutex);
+	m_stats = PrinterStats();
+}
+
+void Printer::probeWakeup()
+{
+	m_wakeupTimer.expires_after(RealtimeScheduling::options().enabled() ? WAKEUP_PROBE_INTERVAL : IDLE_WAKEUP_PROBE_INTERVAL);
+	m_wakeupTimer.async_wait([=](const boost::system::error_code& ec) {
+		if (ec || m_state != State::Connected)
+			return;
+
+		const auto late = std::chrono::steady_clock::now() - m_wakeupTimer.expiry();
+
+		{
+			std::unique_lock<std::mutex> lock(m_statsMutex);
+			m_stats.wakeupLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(late));
+		}
+
+		probeWakeup();
+	});
+}
+
 void Printer::reset()
 {
 	boost::system::error_code ec;
@@ -152,8 +339,24 @@ void Printer::reset()
 
 	m_reconnectTimer.cancel(ec);
 	m_timeoutTimer.cancel(ec);
-	m_executingCommand.clear();
-	m_temperatures.clear();
+	m_resendTimer.cancel(ec);
+	m_sdStatusTimer.cancel(ec);
+
+	{
+		std::lock_guard<std::mutex> lock(m_temperaturesMutex);
+		m_temperatureHistory.clear();
+		m_lastReport = TemperatureReport();
+	}
+
+	m_writeBuffer.clear();
+	m_writing = false;
+	m_freeSlots = -1;
+	m_pendingResend = -1;
+	m_meatPackActive = false;
+	m_autoReportTemperatures = false;
+	m_sdWriting = false;
+	m_sdStatusReports = false;
+	m_streamBuf.consume(m_streamBuf.size());
 
 	resetCommandQueue();
 }
@@ -162,113 +365,262 @@ void Printer::resetCommandQueue()
 {
 	m_replyLines.clear();
 	m_pendingError.clear();
+	m_commandsBeforeJob = 0;
+
+	abandonInFlightCommands(false);
+
+	while (!m_priorityQueue.empty())
+	{
+		PendingCommand pc = std::move(m_priorityQueue.front());
+		m_priorityQueue.pop_front();
+
+		if (pc.callback)
+			pc.callback(m_replyLines);
+	}
 
 	while (!m_commandQueue.empty())
 	{
+		PendingCommand pc = std::move(m_commandQueue.front());
+		m_commandQueue.pop_front();
+
+		if (pc.fromJob && m_jobSource)
+			m_jobSource->lineDone(pc.jobCookie, false);
+
 		// m_replyLines is empty, which will indicate failure
-		if (m_commandQueue.front().callback)
-			m_commandQueue.front().callback(m_replyLines);
-		m_commandQueue.pop();
+		if (pc.callback)
+			pc.callback(m_replyLines);
 	}
 }
 
+void Printer::abandonInFlightCommands(bool requeue)
+{
+	const uint64_t begin = m_ackedPos, end = m_sentEnd;
+
+	// Whatever is in flight or awaiting retransmission won't get confirmed anymore
+	m_ackedPos = m_transmitPos = m_sentEnd;
+	m_inFlightBytes = 0;
+	m_staleReplies = 0;
+
+	if (requeue)
+	{
+		// Walk backwards, so that the original order is preserved
+		for (uint64_t pos = end; pos-- > begin; )
+		{
+			SentCommand& sc = sentCommand(pos);
+
+			m_commandQueue.push_front({ sc.command, sc.tag, std::move(sc.callback), sc.fromJob, sc.jobCookie });
+			sc.callback = nullptr;
+			sc.fromJob = false;
+		}
+	}
+	else
+	{
+		for (uint64_t pos = begin; pos < end; pos++)
+			completeCommand(sentCommand(pos), false);
+	}
+}
+
+void Printer::completeCommand(SentCommand& sc, bool success)
+{
+	// Clear the callback, a later resend may rewind to this command
+	CommandCallback cb = std::move(sc.callback);
+	sc.callback = nullptr;
+
+	if (sc.fromJob)
+	{
+		sc.fromJob = false;
+		if (m_jobSource)
+			m_jobSource->lineDone(sc.jobCookie, success);
+	}
+
+	// m_replyLines is empty on failure
+	if (cb)
+		cb(m_replyLines);
+}
+
+void Printer::detachJobCommands()
+{
+	// Lines of the previous job still on their way aren't reported to the new one
+	for (uint64_t pos = m_ackedPos; pos < m_sentEnd; pos++)
+		sentCommand(pos).fromJob = false;
+
+	for (PendingCommand& pc : m_commandQueue)
+		pc.fromJob = false;
+}
+
+void Printer::startTemperatureReports()
+{
+	if (m_temperatureReportInterval > 0 && hasCapability("AUTOREPORT_TEMP"))
+	{
+		sendCommand(("M155 S" + std::to_string(m_temperatureReportInterval)).c_str(), nullptr);
+		m_autoReportTemperatures = true;
+		expectTemperatureReport();
+	}
+	else
+	{
+		// Once connected
+		m_io.post([this]() { getTemperature(); });
+	}
+}
+
+void Printer::expectTemperatureReport()
+{
+	// Job lines may hold up the reports while the printer's buffers are full, allow for some slack
+	m_temperatureTimer.expires_from_now(boost::posix_time::seconds(m_temperatureReportInterval * MISSED_TEMPERATURE_REPORTS + 2));
+	m_temperatureTimer.async_wait([=](const boost::system::error_code& ec) {
+		if (ec || !m_autoReportTemperatures || m_state != State::Connected)
+			return;
+
+		BOOST_LOG_TRIVIAL(warning) << "No temperature reports from printer " << m_uniqueName << ", polling instead";
+
+		m_autoReportTemperatures = false;
+		getTemperature();
+	});
+}
+
 void Printer::getTemperature()
 {
 	if (m_state != State::Connected)
 		return;
 
+	auto scheduleNext = [=]() {
+		m_temperatureTimer.expires_from_now(TEMPERATURE_POLL_INTERVAL);
+		m_temperatureTimer.async_wait([=](const boost::system::error_code& ec) {
+			if (!ec)
+				getTemperature();
+		});
+	};
+
+	// It would end up in the file being uploaded
+	if (m_sdWriting)
+	{
+		scheduleNext();
+		return;
+	}
+
 	sendCommand("M105", [=](const std::vector<std::string>& response) {
 		if (!response.empty())
 		{
 			parseTemperatures(response[response.size()-1]);
 		}
 
-		m_temperatureTimer.expires_from_now(boost::posix_time::seconds(5));
-		m_temperatureTimer.async_wait([=](const boost::system::error_code& ec) {
-			if (!ec)
-				getTemperature();
-		});
+		scheduleNext();
 	});
 }
 
-void Printer::parseTemperatures(const std::string& line)
+void Printer::setSdStatusReports(bool enabled)
 {
-	std::map<std::string, std::string> values;
-	std::map<std::string, float> changes;
+	m_io.post([=]() {
+		boost::system::error_code ec;
 
-	kvParse(line, values);
+		if (enabled == m_sdStatusReports || m_state != State::Connected)
+			return;
 
-	TemperaturePoint point;
-	TemperaturePoint* prevPoint = nullptr;
+		m_sdStatusReports = enabled;
 
-	point.when = std::chrono::system_clock::now();
+		if (hasCapability("AUTOREPORT_SD_STATUS"))
+			sendCommand(enabled ? ("M27 S" + std::to_string(SD_STATUS_INTERVAL.total_seconds())).c_str() : "M27 S0", nullptr);
+		else if (enabled)
+			pollSdStatus();
+		else
+			m_sdStatusTimer.cancel(ec);
+	});
+}
 
-	std::unique_lock<std::mutex> lock(m_temperaturesMutex);
-	if (!m_temperatures.empty())
-		prevPoint = &m_temperatures.back();
+void Printer::pollSdStatus()
+{
+	if (!m_sdStatusReports || m_state != State::Connected)
+		return;
 
-	lock.unlock();
+	// The reply is picked up by parseSdStatus()
+	sendCommand("M27", [=](const std::vector<std::string>&) {
+		m_sdStatusTimer.expires_from_now(SD_STATUS_INTERVAL);
+		m_sdStatusTimer.async_wait([=](const boost::system::error_code& ec) {
+			if (!ec)
+				pollSdStatus();
+		});
+	});
+}
 
-	for (auto it : values)
-	{
-		// TODO: Multiple tools support
-		// TODO: Temp updates (e.g. during preheat) don't contain all the keys as M105 replies
-		if (it.first != "T" && it.first != "B")
-			continue;
+void Printer::parseSdStatus(std::string_view line)
+{
+	SdStatus status;
 
-		Temperature& temp = point.values[it.first];
-		Temperature* prevTemp = nullptr;
-		ssize_t slash;
+	if (boost::starts_with(line, "SD printing byte "))
+	{
+		// "SD printing byte 1024/52311"
+		const char* p = line.data() + 17;
+		const char* end = line.data() + line.length();
+		auto result = std::from_chars(p, end, status.position);
 
-		if (prevPoint != nullptr)
+		if (result.ec != std::errc() || result.ptr == end || *result.ptr != '/'
+			|| std::from_chars(result.ptr + 1, end, status.size).ec != std::errc())
 		{
-			auto it2 = prevPoint->values.find(it.first);
-			if (it2 != prevPoint->values.end())
-				prevTemp = &it2->second;
+			BOOST_LOG_TRIVIAL(warning) << "Failed to parse SD status on " << m_uniqueName << ": " << line;
+			return;
 		}
 
-		try
-		{
-			float value;
+		status.state = SdStatus::State::Printing;
+		m_sdFileSize = status.size;
+	}
+	else if (boost::starts_with(line, "Done printing file"))
+	{
+		status.state = SdStatus::State::Done;
+		status.position = status.size = m_sdFileSize;
+	}
+	else
+		status.state = SdStatus::State::NotPrinting;
 
-			slash = it.second.find('/');
-			value = std::stof(it.second);
+	m_sdStatusSignal(status);
+}
 
-			if (!prevTemp || value != prevTemp->current)
-				changes.emplace(it.first + ".current", value);
-			temp.current = value;
+bool Printer::isReport(const ReplyTokenizer::Reply& reply) const
+{
+	return (m_autoReportTemperatures && reply.kind == ReplyTokenizer::Kind::Temperature)
+		|| (m_sdStatusReports && reply.kind == ReplyTokenizer::Kind::SdStatus);
+}
 
-			if (slash != std::string::npos)
-			{
-				value = std::stof(it.second.substr(slash + 1));
+void Printer::parseTemperatures(std::string_view line)
+{
+	TemperatureReport report;
 
-				if (!prevTemp || value != prevTemp->target)
-					changes.emplace(it.first + ".target", value);
-				temp.target = value;
-			}
-		}
-		catch (const std::exception& e)
-		{
-			BOOST_LOG_TRIVIAL(warning) << "Failed to parse temperatures on " << m_uniqueName << ": " << line;
-		}
+	if (!report.parse(line))
+	{
+		BOOST_LOG_TRIVIAL(debug) << "No temperatures in a reply on " << m_uniqueName << ": " << line;
+		return;
 	}
 
-	lock.lock();
-	m_temperatures.push_back(point);
-	while (point.when - m_temperatures.front().when > MAX_TEMPERATURE_HISTORY)
-		m_temperatures.pop_front();
+	std::unique_lock<std::mutex> lock(m_temperaturesMutex);
+
+	// Reports during M109/M190 only list some of the heaters, so compare against all the ones seen so far
+	const uint32_t changed = m_lastReport.changes(report);
+	m_lastReport.merge(report);
+	m_temperatureHistory.record(std::chrono::system_clock::now(), m_lastReport);
+
 	lock.unlock();
 
-	if (!changes.empty())
+	if (changed)
 	{
+		std::map<std::string, float> changes;
+
+		for (int i = 0; i < TemperatureReport::SENSORS; i++)
+		{
+			const std::string name = TemperatureReport::sensorName(i);
+
+			if (changed & (TemperatureReport::CURRENT_CHANGED << (2 * i)))
+				changes.emplace(name + ".current", report.readings[i].current);
+			if (changed & (TemperatureReport::TARGET_CHANGED << (2 * i)))
+				changes.emplace(name + ".target", report.readings[i].target);
+		}
+
 		m_temperatureChangeSignal(changes);
 	}
 }
 
-std::list<Printer::TemperaturePoint> Printer::getTemperatureHistory() const
+TemperatureHistory::Series Printer::getTemperatureHistory(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to, size_t maxPoints) const
 {
-	std::unique_lock<std::mutex> lock(m_temperaturesMutex);
-	return m_temperatures;
+	std::lock_guard<std::mutex> lock(m_temperaturesMutex);
+	return m_temperatureHistory.query(from, to, maxPoints);
 }
 
 void Printer::setState(State state)
@@ -278,28 +630,68 @@ void Printer::setState(State state)
 		BOOST_LOG_TRIVIAL(trace) << "State change on printer " << m_uniqueName << ": " << stateName(state);
 
 		if (state == State::Initializing || (state == State::Disconnected && m_state == State::Initializing))
-		{
-			std::lock_guard<std::mutex> lock(m_gcodeHistoryMutex);
-			m_gcodeHistory.clear();
-		}
+			m_gcodeHistorySize = 0;
 		if (state == State::Error)
 			resetCommandQueue();
 
 		if (state == State::Connected)
+		{
 			m_errorMessage.clear();
+			probeWakeup();
+		}
+		else if (m_state == State::Connected)
+			m_wakeupTimer.cancel();
 
 		m_state = state;
+		publishSnapshot();
 		m_stateChangeSignal(state);
 	}
 }
 
 void Printer::sendCommand(const char* cmd, CommandCallback cb, const std::string& gcodeTag)
 {
+	if (isEmergencyCommand(commandCode(cmd)))
+	{
+		sendPriorityCommand(cmd, cb, gcodeTag);
+		return;
+	}
+
 	std::string cmdCopy(cmd);
 	std::string tagCopy(gcodeTag);
 
+	m_io.post([this, cmdCopy = std::move(cmdCopy), tagCopy = std::move(tagCopy), cb = std::move(cb)]() mutable {
+		m_commandQueue.push_back({ std::move(cmdCopy), std::move(tagCopy), std::move(cb) });
+		doWrite();
+	});
+}
+
+void Printer::sendPriorityCommand(const char* cmd, CommandCallback cb, const std::string& gcodeTag)
+{
+	PendingCommand pc;
+	pc.command = cmd;
+	pc.tag = gcodeTag;
+	pc.callback = cb;
+	pc.queued = std::chrono::steady_clock::now();
+
+	m_io.post([this, pc = std::move(pc)]() mutable {
+		m_priorityQueue.push_back(std::move(pc));
+		doWrite();
+	});
+}
+
+void Printer::setJobSource(std::shared_ptr<JobSource> source)
+{
+	m_pendingJobSources++;
+
 	m_io.post([=]() {
-		m_commandQueue.push({ std::move(cmdCopy), std::move(tagCopy), cb });
+		if (source != m_jobSource)
+		{
+			detachJobCommands();
+			m_jobSource = source;
+		}
+
+		m_commandsBeforeJob = m_commandQueue.size();
+		m_pendingJobSources--;
 		doWrite();
 	});
 }
@@ -313,19 +705,45 @@ void Printer::doConnect()
 	{
 		if (!boost::starts_with(m_devicePath, "tcp:"))
 		{
+			std::string path = m_devicePath;
+
+			if (boost::starts_with(m_devicePath, "sim:") || boost::starts_with(m_devicePath, "replay:"))
+			{
+				// Keeps its state across reconnects, like real firmware
+				if (m_simulatorSpec != m_devicePath)
+				{
+					m_simulator.reset();
+					m_replayer.reset();
+					m_simulatorSpec.clear();
+
+					const size_t colon = m_devicePath.find(':');
+					const std::string_view spec = std::string_view(m_devicePath).substr(colon + 1);
+
+					if (colon == 3)
+						m_simulator = std::make_unique<VirtualPrinter>(m_io, VirtualPrinter::Options::parse(spec));
+					else
+						m_replayer = std::make_unique<CaptureReplayer>(m_io, CaptureReplayer::Options::parse(spec));
+
+					m_simulatorSpec = m_devicePath;
+				}
+
+				path = m_simulator ? m_simulator->devicePath() : m_replayer->devicePath();
+			}
+
 			m_usingSocket = false;
-			BOOST_LOG_TRIVIAL(debug) << "Opening serial port " << m_devicePath;
+			BOOST_LOG_TRIVIAL(debug) << "Opening serial port " << path;
 
-			m_serial.open(m_devicePath.c_str());
+			m_serial.open(path.c_str());
 
 			::ioctl(m_serial.native_handle(), TIOCEXCL);
 			setNoResetOnReopen();
 
-			m_serial.set_option(boost::asio::serial_port_base::baud_rate(m_baudRate));
 			m_serial.set_option(boost::asio::serial_port_base::character_size(8));
 			m_serial.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
 			m_serial.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none));
 			m_serial.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none));
+			// Last, asio's options would reset a non-standard baud rate
+			m_serialTuningResult = m_serialTuning.apply(m_serial.native_handle(), m_baudRate);
 
 			connected();
 		}
@@ -342,6 +760,7 @@ void Printer::doConnect()
 			int port = atoi(m_devicePath.c_str() + lpos + 1);
 
 			m_usingSocket = true;
+			m_serialTuningResult = SerialTuning::Result();
 			boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(address), port);
 
 			BOOST_LOG_TRIVIAL(debug) << "Opening TCP connection to " << endpoint;
@@ -391,6 +810,9 @@ void Printer::setupReconnect()
 
 void Printer::connected()
 {
+	if (auto capture = this->capture())
+		capture->record(SerialCapture::Event::Connected);
+
 	setState(State::Initializing);
 	doRead();
 
@@ -416,16 +838,20 @@ void Printer::connected()
 		sendCommand("M115", [=](const std::vector<std::string>& reply) {
 			if (reply.size() >= 2)
 			{
-				kvParse(reply[reply.size() - 2], m_baseParameters);
+				parseFirmwareInfo(reply, m_baseParameters);
 				for (auto it = m_baseParameters.begin(); it != m_baseParameters.end(); it++)
 					std::cout << it->first << " -> " << it->second << std::endl;
+
+				if (m_meatPackAllowed && hasCapability("MEATPACK"))
+					enableMeatPack();
 			}
 
 			if (!reply.empty())
 			{
-				setState(State::Connected);
+				// Queued ahead of the commands of those told about the connection, which may be on other threads
 				showStartupMessage();
-				getTemperature();
+				startTemperatureReports();
+				setState(State::Connected);
 			}
 		});
 
@@ -465,13 +891,18 @@ void Printer::timeoutCheck(const boost::system::error_code& ec)
 	if (ec)
 		return;
 
-	if (!m_commandQueue.empty())
+	if (!m_commandQueue.empty() || inFlightCount() > 0)
 	{
 		auto now = std::chrono::steady_clock::now();
 		if (std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastIncomingData).count() > DATA_TIMEOUT)
 		{
 			BOOST_LOG_TRIVIAL(error) << "Comm timeout on printer " << m_uniqueName;
 
+			{
+				std::unique_lock<std::mutex> lock(m_statsMutex);
+				m_stats.timeouts++;
+			}
+
 			setState(State::Disconnected);
 			reset();
 			doConnect();
@@ -496,67 +927,46 @@ void Printer::ioError(const boost::system::error_code& ec)
 
 void Printer::doRead()
 {
+	auto buffers = m_streamBuf.prepare(READ_CHUNK_SIZE);
+	auto handler = std::bind(&Printer::readDone, this, std::placeholders::_1, std::placeholders::_2);
+
 	if (!m_usingSocket)
-	{
-		boost::asio::async_read_until(m_serial, m_streamBuf, '\n',
-			std::bind(&Printer::readDone, this, std::placeholders::_1));
-	}
+		m_serial.async_read_some(buffers, handler);
 	else
-	{
-		boost::asio::async_read_until(m_socket, m_streamBuf, '\n',
-			std::bind(&Printer::readDone, this, std::placeholders::_1));
-	}
+		m_socket.async_read_some(buffers, handler);
 }
 
-static std::istream& safeGetline(std::istream& is, std::string& t)
+// Parses Marlin's ADVANCED_OK reply, e.g. "ok N10 P15 B3"
+static bool parseAdvancedOk(std::string_view line, int& lastLineNo, int& freeSlots)
 {
-    t.clear();
+	size_t i = 2;
 
-    // The characters in the stream are read one-by-one using a std::streambuf.
-    // That is faster than reading them one-by-one using the std::istream.
-    // Code that uses streambuf this way must be guarded by a sentry object.
-    // The sentry object performs various tasks,
-    // such as thread synchronization and updating the stream state.
+	lastLineNo = freeSlots = -1;
 
-    std::istream::sentry se(is, true);
-    std::streambuf* sb = is.rdbuf();
+	while (i < line.length())
+	{
+		while (i < line.length() && line[i] == ' ')
+			i++;
 
-    for(;;) {
-        int c = sb->sbumpc();
-        switch (c) {
-        case '\n':
-            return is;
-        case '\r':
-            if(sb->sgetc() == '\n')
-                sb->sbumpc();
-            return is;
-        case std::streambuf::traits_type::eof():
-            // Also handle the case when the last line has no line ending
-            if(t.empty())
-                is.setstate(std::ios::eofbit);
-            return is;
-        default:
-            t += (char)c;
-        }
-    }
-}
+		if (i + 1 >= line.length() || !isdigit(line[i + 1]))
+			break;
 
-void Printer::workaroundOverconfirmationBug(std::istream& is)
-{
-	if (m_streamBuf.size() > 0)
-	{
-		while (!is.bad() && !is.eof() && !is.fail())
-		{
-			std::string l;
-			safeGetline(is, l);
+		const char key = line[i++];
+		int value = 0;
 
-			if (!l.empty())
-				m_replyLines.push_back(l);
-		}
+		while (i < line.length() && isdigit(line[i]))
+			value = value * 10 + (line[i++] - '0');
+
+		if (key == 'N')
+			lastLineNo = value;
+		else if (key == 'B')
+			freeSlots = value;
 	}
+
+	return freeSlots != -1;
 }
 
-void Printer::readDone(const boost::system::error_code& ec)
+void Printer::readDone(const boost::system::error_code& ec, size_t bytesRead)
 {
 	if (ec)
 	{
@@ -564,142 +974,237 @@ void Printer::readDone(const boost::system::error_code& ec)
 		return;
 	}
 
-	std::istream is(&m_streamBuf);
-	std::string line;
+	m_streamBuf.commit(bytesRead);
+	m_lastIncomingData = m_readTime = std::chrono::steady_clock::now();
 
-	safeGetline(is, line);
+	{
+		std::unique_lock<std::mutex> lock(m_statsMutex);
+		m_stats.bytesReceived += bytesRead;
+	}
 
-	m_lastIncomingData = std::chrono::steady_clock::now();
+	if (auto capture = this->capture())
+	{
+		auto data = m_streamBuf.data();
+		capture->record(SerialCapture::Event::Received, static_cast<const char*>(data.data()) + data.size() - bytesRead, bytesRead);
+	}
 
-	BOOST_LOG_TRIVIAL(debug) << "Read on printer " << m_uniqueName << ": " << line;
+	// Lines are handled straight from the receive buffer, which stays untouched until consume() below
+	const char* data = static_cast<const char*>(m_streamBuf.data().data());
+	const size_t length = m_streamBuf.size();
+	size_t offset = 0, consumed;
+	ReplyTokenizer::Reply reply;
 
-	m_replyLines.push_back(line);
+	while ((consumed = ReplyTokenizer::next(data + offset, length - offset, reply)) > 0)
+	{
+		offset += consumed;
+		offset += handleReply(reply, data + offset, length - offset);
+	}
+
+	m_streamBuf.consume(offset);
 
+	if (m_streamBuf.size() >= MAX_REPLY_LINE_LENGTH)
 	{
-		GCodeEvent event;
-		event.commandId = m_nextCommandId;
-		event.outgoing = false;
-		event.data = line;
-		event.tag = m_executingTag;
-		
-		raiseGCodeEvent(event);
+		BOOST_LOG_TRIVIAL(warning) << "Discarding overlong line from printer " << m_uniqueName;
+		m_streamBuf.consume(m_streamBuf.size());
 	}
 
-	// This is the final line
-	if (boost::starts_with(line, "ok ") || line == "ok")
+	doRead();
+}
+
+size_t Printer::workaroundOverconfirmationBug(const char* data, size_t length)
+{
+	ReplyTokenizer::Reply reply;
+	size_t offset = 0, consumed;
+
+	while ((consumed = ReplyTokenizer::next(data + offset, length - offset, reply)) > 0)
 	{
-		workaroundOverconfirmationBug(is);
+		offset += consumed;
+
+		if (reply.kind == ReplyTokenizer::Kind::SdStatus)
+			parseSdStatus(reply.line);
+
+		if (m_autoReportTemperatures && reply.kind == ReplyTokenizer::Kind::Temperature)
+		{
+			parseTemperatures(reply.line);
+			expectTemperatureReport();
+		}
+		else if (!reply.line.empty() && !isReport(reply))
+			m_replyLines.emplace_back(reply.line);
+	}
+
+	return offset;
+}
+
+size_t Printer::handleReply(const ReplyTokenizer::Reply& reply, const char* rest, size_t restLength)
+{
+	size_t extraConsumed = 0;
+
+	BOOST_LOG_TRIVIAL(debug) << "Read on printer " << m_uniqueName << ": " << reply.line;
+
+	// Replies always belong to the oldest command in flight
+	const SentCommand* executing = (inFlightCount() > 0) ? &sentCommand(m_ackedPos) : nullptr;
+
+	// Only commands with a callback get to see their reply, reports don't belong to any
+	if (executing && executing->callback && !isReport(reply))
+		m_replyLines.emplace_back(reply.line);
 
-		// Handle command re-sending
-		int resendLine = -1;
-		for (const std::string& line : m_replyLines)
+	raiseGCodeEvent(executing ? executing->commandId : m_nextCommandId, false, reply.line, executing ? std::string_view(executing->tag) : std::string_view());
+
+	switch (reply.kind)
+	{
+		// This is the final line
+		case ReplyTokenizer::Kind::Ok:
 		{
-			if (boost::starts_with(line, "Resend:"))
+			const int resendLine = m_pendingResend;
+			m_pendingResend = -1;
+
+			// With more lines in flight (or rejected ones), the extra lines are replies to those
+			if (inFlightCount() <= 1 && m_staleReplies == 0)
+				extraConsumed = workaroundOverconfirmationBug(rest, restLength);
+
+			if (m_staleReplies > 0)
 			{
-				std::string lineNo = line.substr(7);
-				boost::algorithm::trim(lineNo);
+				// The printer is rejecting lines we had sent before the resend request.
+				// Nothing has been retransmitted yet, so this cannot be anything else.
+				m_pendingError.clear();
 
-				try
+				if (--m_staleReplies == 0)
 				{
-					resendLine = std::stoi(lineNo);
+					boost::system::error_code ec;
+					m_resendTimer.cancel(ec);
 				}
-				catch (const std::exception& e)
-				{
-					BOOST_LOG_TRIVIAL(debug) << "Failed to parse resend line: " << e.what();
-				}
-
-				break;
 			}
-		}
-
-		// Indicates we've just executed an M110 command not present in the queue
-		if (m_nextLineNo == 0)
-		{
-			m_nextLineNo = 1;
-		}
-		else
-		{
-			if (resendLine != -1)
+			else if (resendLine != -1 && resendLine != m_nextLineNo)
 			{
 				BOOST_LOG_TRIVIAL(warning) << "Handling resend for line " << resendLine;
-					
+
 				handleResend(resendLine);
 			}
 			else if (!m_pendingError.empty())
 			{
 				raiseError(m_pendingError);
+				return extraConsumed;
+			}
+			else if (inFlightCount() > 0)
+			{
+				// A resend request for the next line indicates a potential FW bug, but let's carry on
+				acknowledgeCommand(reply.line);
+			}
 
-				doRead();
-				return;
+			m_replyLines.clear();
+
+			doWrite();
+			break;
+		}
+		case ReplyTokenizer::Kind::Resend:
+			// Acted upon once the following ok arrives
+			if (m_pendingResend == -1 && reply.number != -1)
+				m_pendingResend = reply.number;
+			break;
+		case ReplyTokenizer::Kind::Temperature:
+			if (m_autoReportTemperatures)
+			{
+				parseTemperatures(reply.line);
+				expectTemperatureReport();
 			}
-			else
+			else if (executing && (commandCode(executing->command) == "M190" || commandCode(executing->command) == "M109"))
+				parseTemperatures(reply.line);
+			break;
+		case ReplyTokenizer::Kind::SdStatus:
+			parseSdStatus(reply.line);
+			break;
+		case ReplyTokenizer::Kind::Start:
+		{
+			m_replyLines.clear();
+			m_pendingResend = -1;
+
+			// The firmware has lost everything in flight along with its line counter.
+			// Unless a job was running, try again with whatever has not been confirmed.
+			abandonInFlightCommands(m_state == State::Initializing);
+			m_historyStart = m_sentEnd;
+			m_freeSlots = -1;
+			m_nextLineNo = MAX_LINENO;
+			m_sdWriting = false;
+
+			// The unpacker is off after a reset
+			if (m_meatPackActive)
+				enableMeatPack();
+
+			if (m_state == State::Connected || m_state == State::Error)
 			{
-				if (!m_commandQueue.empty())
+				// The job should be failed already
+				if (m_state != State::Error && m_printJob)
 				{
-					auto cb = m_commandQueue.front().callback;
-					if (cb)
-						cb(m_replyLines);
-					m_commandQueue.pop();
+					// Fail running print jobs
+					m_printJob->setError("Printer reset");
 				}
+
+				showStartupMessage();
+
+				// The firmware has forgotten about M155
+				if (m_autoReportTemperatures)
+					startTemperatureReports();
+
+				doWrite();
 			}
+			break;
 		}
+		case ReplyTokenizer::Kind::Error:
+			// Klipper's "!!" only reports a failed command, nothing that would stop the printer
+			if (boost::starts_with(reply.line, "Error:"))
+			{
+				m_pendingError = reply.line.substr(6);
+				// Don't raise errors if there's a Resend before the following ok
+			}
+			break;
+		default:
+			break;
+	}
+
+	return extraConsumed;
+}
 
-		m_replyLines.clear();
-		m_executingCommand.clear();
+void Printer::acknowledgeCommand(std::string_view line)
+{
+	SentCommand& sc = sentCommand(m_ackedPos++);
+
+	m_inFlightBytes -= sc.wireLength;
 
-		doWrite();
-	}
-	else if (m_executingCommand == "M190" || m_executingCommand == "M109")
 	{
-		parseTemperatures(line);
+		std::unique_lock<std::mutex> lock(m_statsMutex);
+		m_stats.recordLatency(sc.command, std::chrono::duration_cast<std::chrono::microseconds>(m_readTime - sc.written));
 	}
-	else if (line == "start")
-	{
-		m_replyLines.clear();
-		m_executingCommand.clear();
 
-		if (m_state == State::Connected || m_state == State::Error)
+	int lastLineNo, freeSlots;
+	if (parseAdvancedOk(line, lastLineNo, freeSlots))
+	{
+		// Lines the firmware hasn't received yet aren't accounted for in its report
+		int unseen = 0;
+		for (uint64_t pos = m_ackedPos; pos < m_transmitPos; pos++)
 		{
-			// The job should be failed already
-			if (m_state != State::Error)
-			{
-				// Fail running print jobs
-				std::unique_lock<std::mutex> lock(m_printJobMutex);
-				if (m_printJob)
-					m_printJob->setError("Printer reset");
-			}
-
-			// Reset line counter
-			m_nextLineNo = MAX_LINENO;
-			showStartupMessage();
-			doWrite();
+			if (lastLineNo == -1 || sentCommand(pos).lineNo > lastLineNo)
+				unseen++;
 		}
-	}
-	else if (boost::starts_with(line, "Error:"))
-	{
-		m_pendingError = line.substr(6);
-		// Don't raise errors if there's a Resend before the following ok
-		// raiseError(std::string_view(line).substr(6));
+		m_freeSlots = std::max(freeSlots - unseen, 0);
 	}
 
-	doRead();
+	completeCommand(sc, true);
 }
 
-void Printer::raiseError(std::string_view message)
+void Printer::raiseError(std::string_view msg)
 {
+	// msg may refer to m_pendingError, which resetCommandQueue() clears
+	const std::string message(msg);
+
 	BOOST_LOG_TRIVIAL(error) << "Error on printer " << m_uniqueName << ": " << message;
 	resetCommandQueue();
 
 	if (m_state != State::Error)
 	{
-		{
-			std::unique_lock<std::mutex> lock(m_miscMutex);
-			m_errorMessage = message;
-		}
-
+		// Published along with the state
+		m_errorMessage = message;
 		setState(State::Error);
 
-		std::unique_lock<std::mutex> lock(m_printJobMutex);
 		if (m_printJob)
 			m_printJob->setError(message);
 	}
@@ -707,134 +1212,343 @@ void Printer::raiseError(std::string_view message)
 
 std::string Printer::errorMessage() const
 {
-	std::unique_lock<std::mutex> lock(m_miscMutex);
-	return m_errorMessage;
+	return snapshot()->errorMessage;
 }
 
 void Printer::handleResend(int resendLine)
 {
-	if (m_nextLineNo == resendLine)
-		return; // Indicates a potential FW bug, but let's carry on
+	uint64_t resendPos = m_sentEnd;
+	uint64_t first = std::max(m_historyStart, (m_sentEnd > MAX_RESEND_HISTORY) ? (m_sentEnd - MAX_RESEND_HISTORY) : 0);
 
-	auto resendStart = m_resendHistory.end();
-	for (auto it = m_resendHistory.begin(); it != m_resendHistory.end(); it++)
+	for (uint64_t pos = first; pos < m_transmitPos; pos++)
 	{
-		if (std::get<0>(*it) == resendLine)
+		if (sentCommand(pos).lineNo == resendLine)
 		{
-			resendStart = it;
+			resendPos = pos;
 			break;
 		}
 	}
 
-	if (resendStart == m_resendHistory.end())
+	if (resendPos == m_sentEnd)
 	{
 		raiseError("Insufficient line history for resend");
+		return;
 	}
-	else
-	{
-		auto queueCopy = m_commandQueue;
-		auto it = resendStart;
 
-		m_commandQueue = std::queue<PendingCommand>();
+	// Every other line in flight will be rejected by the printer as well, unless it drops them silently.
+	// Hold off retransmitting until that's settled, so that a rejected retransmission cannot be mistaken for those.
+	m_staleReplies = int(inFlightCount()) - 1;
+	m_pendingError.clear();
 
-		// Omit the last item in resend history, because it is now in queueCopy
-		auto end = --m_resendHistory.end();
-		for (auto it = resendStart; it != end; it++)
-			m_commandQueue.push({ std::get<1>(*it), std::string(), nullptr });
-		while (!queueCopy.empty())
-		{
-			m_commandQueue.push(queueCopy.front());
-			queueCopy.pop();
-		}
+	if (m_staleReplies > 0)
+	{
+		m_resendTimer.expires_from_now(RESEND_SETTLE_DELAY);
+		m_resendTimer.async_wait([=](const boost::system::error_code& ec) {
+			if (!ec && m_staleReplies > 0)
+			{
+				m_staleReplies = 0;
+				doWrite();
+			}
+		});
+	}
 
-		m_resendHistory.erase(resendStart, m_resendHistory.end());
-		m_nextLineNo = resendLine;
+	// Commands before m_ackedPos have already been confirmed once
+	for (uint64_t pos = resendPos; pos < m_ackedPos; pos++)
+	{
+		sentCommand(pos).callback = nullptr;
+		sentCommand(pos).fromJob = false;
+	}
 
-		BOOST_LOG_TRIVIAL(debug) << "Queue size after resend handling: " << m_commandQueue.size();
+	{
+		std::unique_lock<std::mutex> lock(m_statsMutex);
+		m_stats.resendRequests++;
+		m_stats.linesResent += m_sentEnd - resendPos;
 	}
-}
 
-static std::string extractCommandCode(const std::string& cmd)
-{
-	auto pos = cmd.find(' ');
-	if (pos != std::string::npos)
-		return cmd.substr(0, pos);
-	return cmd;
+	m_ackedPos = m_transmitPos = resendPos;
+	m_inFlightBytes = 0;
+	m_nextLineNo = resendLine;
+
+	BOOST_LOG_TRIVIAL(debug) << "Commands to retransmit after resend handling: " << (m_sentEnd - resendPos);
 }
 
-bool Printer::useLineNumberForExecutingCommand() const
+bool Printer::useLineNumber(std::string_view code)
 {
 	// Omit for the line-setting command
-	if (m_executingCommand == "M110")
+	if (code == "M110")
 		return false;
 
 	// Omit for printer reset
-	if (m_executingCommand == "M999")
+	if (code == "M999")
 		return false;
 	
 	return true;
 }
 
-void Printer::doWrite()
+// Handled by Marlin's EMERGENCY_PARSER (and similar) as soon as received, even while the firmware is busy
+bool Printer::isEmergencyCommand(std::string_view code)
 {
-	if (!m_executingCommand.empty() || m_commandQueue.empty())
-		return;
+	return code == "M112" || code == "M108" || code == "M410";
+}
 
-	m_replyLines.clear();
-	m_executingTag.clear();
+bool Printer::windowHasRoom(size_t length, bool numbered) const
+{
+	const size_t inFlight = inFlightCount();
+
+	// Rejected lines are still being replied to
+	if (m_staleReplies > 0)
+		return false;
+
+	if (inFlight == 0)
+		return true;
+
+	// Classic ping-pong: wait for each "ok"
+	if (!m_streaming)
+		return false;
+
+	// Unnumbered commands must be alone in flight
+	if (!numbered || sentCommand(m_ackedPos).lineNo == -1)
+		return false;
+
+	if (inFlight >= MAX_IN_FLIGHT || m_freeSlots == 0)
+		return false;
 
-	if (m_nextLineNo < MAX_LINENO)
+	return m_inFlightBytes + length <= size_t(m_rxBufferSize);
+}
+
+static void appendNumber(std::string& out, unsigned int value)
+{
+	char buf[16];
+	auto result = std::to_chars(buf, buf + sizeof(buf), value);
+	out.append(buf, result.ptr - buf);
+}
+
+void Printer::enableMeatPack()
+{
+	BOOST_LOG_TRIVIAL(info) << "Using MeatPack on printer " << m_uniqueName;
+
+	// Takes effect for everything written after it
+	m_writeBuffer += MeatPack::ENABLE;
+	m_meatPackActive = true;
+	flushWrites();
+}
+
+// Reuses the capacity of out, so that no allocation takes place once it has grown big enough
+void Printer::encodeCommand(std::string_view cmd, int lineNo, std::string& out)
+{
+	out.clear();
+
+	if (lineNo != -1)
+	{
+		// Prepend next line number
+		out += 'N';
+		appendNumber(out, lineNo);
+		out += ' ';
+	}
+
+	out += cmd;
+
+	if (lineNo != -1)
+	{
+		out += ' ';
+
+		unsigned int cs = checksum(out);
+		out += '*';
+		appendNumber(out, cs);
+	}
+
+	out += '\n';
+}
+
+void Printer::doWrite()
+{
+	for (;;)
 	{
-		const PendingCommand &pc = m_commandQueue.front();
-		std::stringstream ss;
+		const bool retransmit = m_transmitPos < m_sentEnd;
+		std::string_view command;
+		bool fromJob = false, priority = false;
 
-		m_executingCommand = extractCommandCode(pc.command);
-		processCommandEffects(pc.command);
+		if (retransmit)
+			command = sentCommand(m_transmitPos).command;
+		else if (!m_priorityQueue.empty())
+		{
+			command = m_priorityQueue.front().command;
+			priority = true;
+		}
+		else if (m_jobSource && m_commandsBeforeJob == 0 && m_pendingJobSources == 0
+			&& (m_commandQueue.empty() || (m_jobTurn && !m_commandQueue.front().fromJob))
+			&& m_jobSource->peekLine(command))
+		{
+			fromJob = true;
+		}
+		else if (!m_commandQueue.empty())
+			command = m_commandQueue.front().command;
+		else
+			break;
 
-		const bool useLineNumber = useLineNumberForExecutingCommand();
-		if (useLineNumber)
+		std::string_view code = commandCode(command);
+		bool numbered = useLineNumber(code);
+		bool resetLineNo = false;
+		const bool emergency = priority && isEmergencyCommand(code);
+
+		// No waiting for the line counter reset either
+		if (emergency && m_nextLineNo >= MAX_LINENO)
+			numbered = false;
+		// While uploading to the SD card, M110 would end up in the file
+		else if (numbered && m_nextLineNo >= MAX_LINENO && !m_sdWriting)
 		{
-			m_resendHistory.push_back({ m_nextLineNo, pc.command });
-			if (m_resendHistory.size() > MAX_RESEND_HISTORY)
-				m_resendHistory.pop_front();
+			// Reset the line counter once everything sent so far has been confirmed
+			if (inFlightCount() > 0 || retransmit)
+				break;
 
-			// Prepend next line number
-			ss << 'N' << m_nextLineNo++ << ' ';
+			command = RESET_LINENO_COMMAND;
+			code = commandCode(command);
+			numbered = false;
+			resetLineNo = true;
 		}
 
-		ss << pc.command;
+		encodeCommand(command, numbered ? m_nextLineNo : -1, m_lineBuffer);
 
-		if (useLineNumber)
+		std::string_view wire = m_lineBuffer;
+		if (m_meatPackActive)
 		{
-			ss << ' ';
+			m_packedBuffer.clear();
+
+			// The emergency parser only recognizes plain text at the start of a line,
+			// it ignores the rest of anything else up to a line end
+			if (emergency)
+			{
+				m_packedBuffer += MeatPack::DISABLE;
+				m_packedBuffer += '\n';
+				m_packedBuffer += m_lineBuffer;
+				m_packedBuffer += MeatPack::ENABLE;
+			}
+			else
+				MeatPack::pack(m_lineBuffer, m_packedBuffer);
+
+			wire = m_packedBuffer;
+		}
+
+		if (!emergency && !windowHasRoom(wire.length(), numbered))
+			break;
+
+		SentCommand* sc;
+		if (retransmit)
+			sc = &sentCommand(m_transmitPos);
+		else
+		{
+			sc = &sentCommand(m_sentEnd++);
+
+			if (resetLineNo)
+			{
+				sc->command = RESET_LINENO_COMMAND;
+				sc->tag.clear();
+				sc->callback = nullptr;
+				sc->fromJob = false;
+			}
+			else if (priority)
+			{
+				PendingCommand& pc = m_priorityQueue.front();
+
+				processCommandEffects(code, pc.command);
+
+				const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - pc.queued);
+
+				BOOST_LOG_TRIVIAL(info) << "Priority command " << pc.command << " written to " << m_uniqueName << " after " << latency.count() << " us";
+
+				{
+					std::unique_lock<std::mutex> lock(m_statsMutex);
+					m_stats.priorityLatency.record(latency);
+				}
+
+				sc->command = std::move(pc.command);
+				sc->tag = std::move(pc.tag);
+				sc->callback = std::move(pc.callback);
+				sc->fromJob = false;
+				m_priorityQueue.pop_front();
+			}
+			else if (fromJob)
+			{
+				processCommandEffects(code, command);
+
+				// The command's storage is reused, the job line itself may go away now
+				sc->command.assign(command.data(), command.length());
+				sc->tag.clear();
+				sc->callback = nullptr;
+				sc->fromJob = true;
+				sc->jobCookie = m_jobSource->lineSent();
+			}
+			else
+			{
+				PendingCommand& pc = m_commandQueue.front();
+
+				processCommandEffects(code, pc.command);
+
+				sc->command = std::move(pc.command);
+				sc->tag = std::move(pc.tag);
+				sc->callback = std::move(pc.callback);
+				sc->fromJob = pc.fromJob;
+				sc->jobCookie = pc.jobCookie;
+				m_commandQueue.pop_front();
+
+				if (m_commandsBeforeJob > 0)
+					m_commandsBeforeJob--;
+			}
+
+			if (!resetLineNo && !priority)
+				m_jobTurn = !fromJob;
+		}
+
+		m_transmitPos++;
+
+		sc->lineNo = numbered ? m_nextLineNo++ : -1;
+		sc->wireLength = wire.length();
+		sc->commandId = ++m_nextCommandId;
+		sc->written = std::chrono::steady_clock::now();
+		m_inFlightBytes += sc->wireLength;
+
+		if (m_freeSlots > 0)
+			m_freeSlots--;
 
-			unsigned int cs = checksum(ss.str());
-			ss << '*' << cs;
+		// While uploading to the SD card, M110 only goes into the file and the firmware's numbering carries on
+		if (commandCode(sc->command) == "M110" && !m_sdWriting)
+		{
+			// Line numbers restart, older lines cannot be resent anymore
+			auto npos = sc->command.find('N', 4);
+			m_nextLineNo = (npos != std::string::npos) ? std::atoi(sc->command.c_str() + npos + 1) + 1 : 1;
+			m_historyStart = m_transmitPos;
 		}
 
-		ss << '\n';
+		BOOST_LOG_TRIVIAL(debug) << "Write on printer " << m_uniqueName << ": " << m_lineBuffer.substr(0, m_lineBuffer.length()-1);
+
+		raiseGCodeEvent(sc->commandId, true, m_lineBuffer, sc->tag);
 
-		m_commandBuffer = ss.str();
-		m_executingTag = pc.tag;
+		m_writeBuffer += wire;
 	}
-	else
+
 	{
-		// Reset the line counter
-		m_commandBuffer = "M110 N0\n";
-		m_executingCommand = "M110";
-		m_nextLineNo = 0; // Will bump to 1 in readDone()
+		std::unique_lock<std::mutex> lock(m_statsMutex);
+		m_stats.recordQueueDepth(m_commandQueue.size() + m_priorityQueue.size(), inFlightCount());
 	}
 
-	BOOST_LOG_TRIVIAL(debug) << "Write on printer " << m_uniqueName << ": " << m_commandBuffer.substr(0, m_commandBuffer.length()-1);
+	flushWrites();
+}
 
-	{
-		GCodeEvent event;
-		event.commandId = ++m_nextCommandId;
-		event.outgoing = true;
-		event.data = m_commandBuffer;
-		event.tag = m_executingTag;
+void Printer::flushWrites()
+{
+	if (m_writing || m_writeBuffer.empty())
+		return;
 
-		raiseGCodeEvent(event);
+	m_writing = true;
+	m_commandBuffer.swap(m_writeBuffer);
+	m_writeBuffer.clear();
+
+	if (auto capture = this->capture())
+		capture->record(SerialCapture::Event::Sent, m_commandBuffer.c_str(), m_commandBuffer.length());
+
+	{
+		std::unique_lock<std::mutex> lock(m_statsMutex);
+		m_stats.bytesSent += m_commandBuffer.length();
 	}
 
 	if (!m_usingSocket)
@@ -852,7 +1566,7 @@ void Printer::doWrite()
 	m_lastIncomingData = std::chrono::steady_clock::now();
 }
 
-unsigned int Printer::checksum(std::string cmd)
+unsigned int Printer::checksum(std::string_view cmd)
 {
 	unsigned int cs = 0;
 
@@ -870,50 +1584,75 @@ void Printer::writeDone(const boost::system::error_code& ec)
 		return;
 	}
 
-	// Now we wait for the reply to arrive.
-	// Only then we clear m_executingCommand.
+	m_writing = false;
+
+	// Lines queued up while writing (streaming mode)
+	flushWrites();
 }
 
-void Printer::processCommandEffects(const std::string& line)
+void Printer::processCommandEffects(std::string_view code, std::string_view line)
 {
-	if (m_executingCommand == "M104" || m_executingCommand == "M109")
+	if (m_sdWriting)
+	{
+		// Only written to the file, nothing is executed
+		if (code == "M29")
+			m_sdWriting = false;
+		return;
+	}
+
+	if (code == "M28")
+	{
+		m_sdWriting = true;
+		return;
+	}
+
+	// Compacted moves have no spaces, e.g. "G1X10F1800"
+	if (line.length() >= 2 && line[0] == 'G' && line[1] >= '0' && line[1] <= '3' && (line.length() == 2 || line[2] < '0' || line[2] > '9'))
+	{
+		const size_t pos = line.find('F');
+		double feedrate;
+
+		if (pos != std::string_view::npos && std::from_chars(line.data() + pos + 1, line.data() + line.length(), feedrate).ec == std::errc())
+			m_positioningState.feedrate = feedrate;
+	}
+	else if (code == "M104" || code == "M109")
 	{
 		// Extruder target temp change
 		if (line.length() > 6 && line[5] == 'S')
 			Printer::processTargetTempSetting("T", line);
 	}
-	else if (m_executingCommand == "M140" || m_executingCommand == "M190")
+	else if (code == "M140" || code == "M190")
 	{
 		// Heatbed target temp change
 		if (line.length() > 6 && line[5] == 'S')
 			Printer::processTargetTempSetting("B", line);
 	}
-	else if (m_executingCommand == "G91")
+	else if (code == "G91")
 	{
-		m_positioningState = { true, true };
+		m_positioningState.relativePositioning = m_positioningState.extruderRelativePositioning = true;
 	}
-	else if (m_executingCommand == "G90")
+	else if (code == "G90")
 	{
-		m_positioningState = { false, false };
+		m_positioningState.relativePositioning = m_positioningState.extruderRelativePositioning = false;
 	}
-	else if (m_executingCommand == "M83")
+	else if (code == "M83")
 	{
 		m_positioningState.extruderRelativePositioning = true;
 	}
-	else if (m_executingCommand == "M82")
+	else if (code == "M82")
 	{
 		m_positioningState.extruderRelativePositioning = false;
 	}
 }
 
-void Printer::processTargetTempSetting(const char* elem, const std::string& line)
+void Printer::processTargetTempSetting(const char* elem, std::string_view line)
 {
 	// std::unique_lock<std::mutex> lock(m_temperaturesMutex);
 
 	try
 	{
 		Temperature temp = getTemperatures()[elem];
-		float value = std::stof(line.substr(6));
+		float value = std::stof(std::string(line.substr(6)));
 
 		if (value != temp.target)
 		{
@@ -971,6 +1710,35 @@ ignore:
 	}
 }
 
+void Printer::parseFirmwareInfo(const std::vector<std::string>& reply, std::map<std::string,std::string>& values)
+{
+	values.clear();
+
+	for (const std::string& line : reply)
+	{
+		if (boost::starts_with(line, "Cap:"))
+		{
+			const size_t colon = line.find(':', 4);
+
+			if (colon != std::string::npos)
+				values["Cap:" + line.substr(4, colon - 4)] = line.substr(colon + 1);
+		}
+		else if (line.find("FIRMWARE_NAME:") != std::string::npos)
+		{
+			std::map<std::string,std::string> kv;
+
+			kvParse(line, kv);
+			values.insert(kv.begin(), kv.end());
+		}
+	}
+}
+
+bool Printer::hasCapability(std::string_view name) const
+{
+	auto it = m_baseParameters.find("Cap:" + std::string(name));
+	return it != m_baseParameters.end() && it->second == "1";
+}
+
 /*
 void Printer::regenerateApiKey()
 {
@@ -983,68 +1751,87 @@ void Printer::regenerateApiKey()
 
 std::map<std::string, Printer::Temperature> Printer::getTemperatures() const
 {
+	std::map<std::string, Printer::Temperature> temperatures;
 	std::lock_guard<std::mutex> lock(m_temperaturesMutex);
-	if (!m_temperatures.empty())
-		return m_temperatures.back().values;
-	else
-		return std::map<std::string, Printer::Temperature>();
+
+	for (int i = 0; i < TemperatureReport::SENSORS; i++)
+	{
+		if (m_lastReport.has(i))
+		{
+			const TemperatureReport::Reading& reading = m_lastReport.readings[i];
+			temperatures.emplace(TemperatureReport::sensorName(i), Temperature{ reading.current, reading.target });
+		}
+	}
+
+	return temperatures;
 }
 
 std::shared_ptr<PrintJob> Printer::printJob() const
 {
-	std::lock_guard<std::mutex> lock(m_printJobMutex);
-	return m_printJob;
+	return snapshot()->printJob;
 }
 
 bool Printer::hasPrintJob() const
 {
-	std::lock_guard<std::mutex> lock(m_printJobMutex);
-	return !!m_printJob;
+	return !!snapshot()->printJob;
 }
 
 void Printer::setPrintJob(std::shared_ptr<PrintJob> job)
 {
-	std::unique_lock<std::mutex> lock(m_printJobMutex);
-
 	if (job)
 	{
 		if (m_printJob && (m_printJob->state() == PrintJob::State::Running || m_printJob->state() == PrintJob::State::Paused))
 			throw job_exists("Printer already has a print job");
 
 		m_printJob = job;
-
-		lock.unlock();
+		publishSnapshot();
 		m_hasJobChangeSignal(true);
 	}
 	else if (m_printJob)
 	{
 		m_printJob.reset();
-
-		lock.unlock();
+		publishSnapshot();
 		m_hasJobChangeSignal(false);
 	}
 }
 
-std::list<Printer::GCodeEvent> Printer::gcodeHistory() const
+std::vector<Printer::GCodeEvent> Printer::gcodeHistory() const
 {
-	std::lock_guard<std::mutex> lock(m_gcodeHistoryMutex);
-	return m_gcodeHistory;
+	return call([this]() {
+		std::vector<GCodeEvent> history;
+
+		history.reserve(m_gcodeHistorySize);
+		for (size_t i = 0; i < m_gcodeHistorySize; i++)
+			history.push_back(m_gcodeHistory[(m_gcodeHistoryStart + i) % MAX_GCODE_HISTORY]);
+
+		return history;
+	});
 }
 
-void Printer::raiseGCodeEvent(const GCodeEvent& e)
+void Printer::raiseGCodeEvent(uint64_t commandId, bool outgoing, std::string_view data, std::string_view tag)
 {
-	std::lock_guard<std::mutex> lock(m_gcodeHistoryMutex);
-	if (m_gcodeHistory.size() >= MAX_GCODE_HISTORY)
+	// Whole commands make room, not just their first line
+	if (m_gcodeHistorySize == MAX_GCODE_HISTORY)
 	{
-		auto first = m_gcodeHistory.front();
+		const uint64_t first = m_gcodeHistory[m_gcodeHistoryStart].commandId;
 		do
 		{
-			m_gcodeHistory.pop_front();
+			m_gcodeHistoryStart = (m_gcodeHistoryStart + 1) % MAX_GCODE_HISTORY;
+			m_gcodeHistorySize--;
 		}
-		while (m_gcodeHistory.front().commandId == first.commandId);
+		while (m_gcodeHistorySize > 0 && m_gcodeHistory[m_gcodeHistoryStart].commandId == first);
 	}
-	m_gcodeHistory.push_back(e);
-	m_gcodeSignal(e);
+
+	GCodeEvent& event = m_gcodeHistory[(m_gcodeHistoryStart + m_gcodeHistorySize) % MAX_GCODE_HISTORY];
+
+	event.commandId = commandId;
+	event.outgoing = outgoing;
+	event.data.assign(data);
+	event.tag.assign(tag);
+	m_gcodeHistorySize++;
+
+	if (!m_gcodeSignal.empty())
+		m_gcodeSignal(event);
 }
 
 void Printer::resetPrinter()
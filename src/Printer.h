@@ -25,12 +25,31 @@
 #include <list>
 #include <chrono>
 #include <list>
+#include <deque>
+#include <array>
+#include <algorithm>
+#include <future>
+#include <atomic>
+#include "ReplyTokenizer.h"
+#include "PrinterStats.h"
+#include "TemperatureHistory.h"
+#include "SerialTuning.h"
 
 class PrintJob;
-
+class VirtualPrinter;
+class CaptureReplayer;
+class SerialCapture;
+class IoThread;
+
+// The printer's state belongs to the thread running its io_service and is only changed there.
+// Other threads go through post() and call(), or read snapshot(). sendCommand(), setJobSource(),
+// the temperatures, stats and captures are fine from any thread.
 class Printer
 {
 public:
+	// On a thread of its own
+	Printer();
+	// On the thread(s) running io
 	Printer(boost::asio::io_service& io);
 	Printer(const Printer& orig) = delete;
 	virtual ~Printer();
@@ -39,6 +58,15 @@ public:
 	void save(boost::property_tree::ptree& tree);
 	
 	Printer& operator=(const Printer& orig) = delete;
+
+	// Runs fn on the printer's thread
+	void post(std::function<void()> fn);
+	// Runs fn on the printer's thread and waits for its result, exceptions included.
+	// Runs it right away if already there.
+	template<typename F> auto call(F&& fn) const -> decltype(fn());
+	boost::asio::io_service& io() { return m_io; }
+	// The printer's own thread, nullptr if constructed with an io_service
+	IoThread* thread() { return m_thread.get(); }
 	
 	const char* uniqueName() const { return m_uniqueName.c_str(); }
 	void setUniqueName(const char* name);
@@ -49,8 +77,78 @@ public:
 	int baudRate() const { return m_baudRate; }
 	void setBaudRate(int rate);
 
+	const SerialTuning& serialTuning() const { return m_serialTuning; }
+	void setSerialTuning(const SerialTuning& tuning);
+	// What the serial port got on the last connection
+	const SerialTuning::Result& serialTuningResult() const { return m_serialTuningResult; }
+
 	const char* name() const { return m_name.c_str(); }
 	void setName(const char* name) { m_name = name; }
+
+	// Where print jobs keep their JobJournal, empty if they shouldn't
+	const std::string& journalPath() const { return m_journalPath; }
+	void setJournalPath(const std::string& path) { m_journalPath = path; }
+
+	// Records everything sent and received into a new SerialCapture at path, replacing a running capture.
+	// Throws std::runtime_error.
+	void startCapture(const std::string& path);
+	void stopCapture();
+	// The running capture, if any
+	std::shared_ptr<SerialCapture> capture() const;
+
+	// Command latencies and link counters since start or the last resetStats()
+	PrinterStats stats() const;
+	void resetStats();
+	// Whether the printer's thread got the real-time policy from the "Realtime" config section
+	bool realtime() const { return m_realtime; }
+
+	// Keep several numbered lines in flight instead of waiting for each "ok"
+	bool streaming() const { return m_streaming; }
+	void setStreaming(bool streaming);
+
+	// Size of the firmware's serial RX buffer, bounds the bytes in flight when streaming
+	int rxBufferSize() const { return m_rxBufferSize; }
+	void setRxBufferSize(int size);
+
+	// Compress commands with MeatPack if the firmware supports it
+	bool meatPack() const { return m_meatPackAllowed; }
+	void setMeatPack(bool meatPack) { m_meatPackAllowed = meatPack; }
+
+	// Print job lines are shortened before sending, numbers are rounded to compactionDecimals() places
+	bool compaction() const { return m_compaction; }
+	void setCompaction(bool compaction) { m_compaction = compaction; }
+	int compactionDecimals() const { return m_compactionDecimals; }
+	void setCompactionDecimals(int decimals) { m_compactionDecimals = std::clamp(decimals, 0, 4); }
+
+	// Print job moves along curves are sent as G2/G3 arcs deviating at most arcTolerance() mm from the original path.
+	// The firmware has to support arcs.
+	bool arcFitting() const { return m_arcFitting; }
+	void setArcFitting(bool arcFitting) { m_arcFitting = arcFitting; }
+	double arcTolerance() const { return m_arcTolerance; }
+	void setArcTolerance(double tolerance) { m_arcTolerance = std::clamp(tolerance, 0.001, 1.0); }
+
+	// Consecutive print job moves deviating at most decimationTolerance() mm from a straight line are merged
+	bool decimation() const { return m_decimation; }
+	void setDecimation(bool decimation) { m_decimation = decimation; }
+	double decimationTolerance() const { return m_decimationTolerance; }
+	void setDecimationTolerance(double tolerance) { m_decimationTolerance = std::clamp(tolerance, 0.001, 0.5); }
+
+	// Seconds between the temperature reports requested with M155 if the firmware has AUTOREPORT_TEMP,
+	// 0 to poll with M105 instead. Takes effect on the next connection.
+	int temperatureReportInterval() const { return m_temperatureReportInterval; }
+	void setTemperatureReportInterval(int seconds) { m_temperatureReportInterval = std::clamp(seconds, 0, 60); }
+
+	// Print jobs are uploaded to the printer's SD card (M28/M29) and printed from there if the firmware has
+	// Cap:SDCARD, taking the host out of the timing loop. Progress then comes from M27.
+	bool sdOffload() const { return m_sdOffload; }
+	void setSdOffload(bool offload) { m_sdOffload = offload; }
+
+	// Print job progress events are coalesced to at most progressRate() per second (0 for no limit),
+	// each one at least progressMinDelta() percent further than the last one
+	double progressRate() const { return m_progressRate; }
+	void setProgressRate(double rate) { m_progressRate = std::max(rate, 0.0); }
+	double progressMinDelta() const { return m_progressMinDelta; }
+	void setProgressMinDelta(double percent) { m_progressMinDelta = std::clamp(percent, 0.0, 100.0); }
 	
 	// Connect to the printer and maintain the connection
 	void start();
@@ -67,27 +165,55 @@ public:
 		Error,
 	};
 	static const char* stateName(State state);
+
+	// What other threads get to see without asking the printer's thread, replaced as a whole on every change
+	struct Snapshot
+	{
+		State state = State::Stopped;
+		std::string errorMessage;
+		std::shared_ptr<PrintJob> printJob;
+	};
+	std::shared_ptr<const Snapshot> snapshot() const { return std::atomic_load(&m_snapshot); }
 	
-	State state() const { return m_state; }
+	State state() const { return snapshot()->state; }
 
 	typedef std::function<void(const std::vector<std::string>& reply)> CommandCallback;
+	// M112, M108 and M410 always go through the priority lane
 	void sendCommand(const char* cmd, CommandCallback cb, const std::string& gcodeTag = std::string());
+	// Sends the command ahead of queued commands and job lines, only retransmissions go first.
+	// Emergency commands are written out even if the printer has no room for them, the firmware's
+	// emergency parser picks them up as they arrive.
+	void sendPriorityCommand(const char* cmd, CommandCallback cb, const std::string& gcodeTag = std::string());
+
+	// Supplies the lines of a print job. The printer pulls them whenever there's room to write,
+	// taking turns with commands from sendCommand().
+	class JobSource
+	{
+	public:
+		virtual ~JobSource() {}
+
+		// Next line to send, without consuming it. Returns false if there's nothing to send right now.
+		// The line must stay valid until lineSent() is called.
+		virtual bool peekLine(std::string_view& line) = 0;
+		// The line from peekLine() has been sent, returns a cookie identifying it in lineDone()
+		virtual size_t lineSent() = 0;
+		// The printer has confirmed the line, or it never will (success == false)
+		virtual void lineDone(size_t cookie, bool success) = 0;
+	};
+
+	// Also call this when a source that returned false from peekLine() has more lines
+	void setJobSource(std::shared_ptr<JobSource> source);
 
 	boost::signals2::signal<void(State)>& stateChangeSignal() { return m_stateChangeSignal; }
 
-	// TODO: save 30 mins worth of data
 	struct Temperature
 	{
 		float current = 0;
 		float target = 0;
 	};
-	struct TemperaturePoint
-	{
-		std::chrono::system_clock::time_point when;
-		std::map<std::string, Temperature> values;
-	};
 	std::map<std::string, Temperature> getTemperatures() const;
-	std::list<TemperaturePoint> getTemperatureHistory() const;
+	// See TemperatureHistory::query()
+	TemperatureHistory::Series getTemperatureHistory(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to, size_t maxPoints = 0) const;
 
 	boost::signals2::signal<void(std::map<std::string, float>)>& temperatureChangeSignal() { return m_temperatureChangeSignal; }
 
@@ -102,6 +228,18 @@ public:
 	const PrintArea& printArea() const { return m_printArea; }
 	void setPrintArea(PrintArea area);
 
+	// What M27 says, or the firmware once an SD print is over
+	struct SdStatus
+	{
+		enum class State { Printing, NotPrinting, Done } state;
+		// Bytes of the file being printed
+		size_t position = 0, size = 0;
+	};
+	// Asks for SD status reports every few seconds (M27 S), or polls with M27 if the firmware
+	// doesn't have Cap:AUTOREPORT_SD_STATUS
+	void setSdStatusReports(bool enabled);
+	boost::signals2::signal<void(SdStatus)>& sdStatusSignal() { return m_sdStatusSignal; }
+
 	class job_exists : public std::runtime_error { using std::runtime_error::runtime_error; };
 
 	void setPrintJob(std::shared_ptr<PrintJob> job);
@@ -118,23 +256,34 @@ public:
 		bool outgoing;
 		std::string data, tag;
 	};
-	boost::signals2::signal<void(GCodeEvent)>& gcodeSignal() { return m_gcodeSignal; }
+	// Raised on the printer's thread, the event is only valid during the call
+	boost::signals2::signal<void(const GCodeEvent&)>& gcodeSignal() { return m_gcodeSignal; }
 
-	std::list<GCodeEvent> gcodeHistory() const;
+	// Copied on the printer's thread, see call(). Oldest first.
+	std::vector<GCodeEvent> gcodeHistory() const;
 
 	// Parse 'key:some value' pairs
 	static void kvParse(const std::string& line, std::map<std::string,std::string>& values);
+	// Parse the reply to M115, capabilities ("Cap:NAME:1" lines) are stored as "Cap:NAME"
+	static void parseFirmwareInfo(const std::vector<std::string>& reply, std::map<std::string,std::string>& values);
+	// Whether the M115 reply advertised the capability
+	bool hasCapability(std::string_view name) const;
 
 	struct PositioningState
 	{
 		bool relativePositioning;
 		bool extruderRelativePositioning;
+		double feedrate; // of the last move with F, 0 if none
 	};
 	PositioningState positioningState() const { return m_positioningState; }
 
 	std::string errorMessage() const;
 private:
+	Printer(std::unique_ptr<IoThread>&& thread);
+	Printer(boost::asio::io_service& io, std::unique_ptr<IoThread>&& thread);
+
 	void setState(State state);
+	void publishSnapshot();
 
 	void deviceSettingsChanged();
 	void doConnect();
@@ -142,9 +291,11 @@ private:
 	void setupReconnect();
 
 	void doRead();
-	void readDone(const boost::system::error_code& ec);
+	void readDone(const boost::system::error_code& ec, size_t bytesRead);
+	size_t handleReply(const ReplyTokenizer::Reply& reply, const char* rest, size_t restLength);
 
 	void doWrite();
+	void flushWrites();
 	void writeDone(const boost::system::error_code& ec);
 
 	void reset();
@@ -152,58 +303,166 @@ private:
 
 	void setupTimeoutCheck();
 	void timeoutCheck(const boost::system::error_code& ec);
+	// Measures how late the thread wakes up for a timer, into PrinterStats::wakeupLatency. Runs while connected.
+	void probeWakeup();
 
+	void startTemperatureReports();
+	// Falls back to polling unless another report arrives in time
+	void expectTemperatureReport();
 	void getTemperature();
-	void parseTemperatures(const std::string& line);
+	void parseTemperatures(std::string_view line);
+	void pollSdStatus();
+	void parseSdStatus(std::string_view line);
+	// Lines that aren't part of a command's reply
+	bool isReport(const ReplyTokenizer::Reply& reply) const;
 
-	void processCommandEffects(const std::string& line);
-	void processTargetTempSetting(const char* elem, const std::string& line);
+	void processCommandEffects(std::string_view code, std::string_view line);
+	void processTargetTempSetting(const char* elem, std::string_view line);
 
-	static unsigned int checksum(std::string cmd);
+	static unsigned int checksum(std::string_view cmd);
+	static void encodeCommand(std::string_view cmd, int lineNo, std::string& out);
 	void setNoResetOnReopen();
 
 	void showStartupMessage();
-	void raiseGCodeEvent(const GCodeEvent& e);
+	// Records the line into the history ring, the signal only gets it with slots connected
+	void raiseGCodeEvent(uint64_t commandId, bool outgoing, std::string_view data, std::string_view tag);
 	void resetCommandQueue();
 
 	void handleResend(int resendLine);
+	void acknowledgeCommand(std::string_view line);
+	void abandonInFlightCommands(bool requeue);
+	struct SentCommand;
+	void completeCommand(SentCommand& sc, bool success);
+	void detachJobCommands();
 	void raiseError(std::string_view message);
-	void workaroundOverconfirmationBug(std::istream& is);
+	size_t workaroundOverconfirmationBug(const char* data, size_t length);
 
-	bool useLineNumberForExecutingCommand() const;
+	static bool useLineNumber(std::string_view code);
+	static bool isEmergencyCommand(std::string_view code);
+	bool windowHasRoom(size_t length, bool numbered) const;
+	void enableMeatPack();
 private:
 	std::string m_uniqueName; // As used in REST API URLs
-	std::string m_devicePath, m_name;
+	std::string m_devicePath, m_name, m_journalPath;
 	int m_baudRate = 115200;
+	SerialTuning m_serialTuning;
+	SerialTuning::Result m_serialTuningResult;
 	State m_state = State::Stopped;
+	std::shared_ptr<const Snapshot> m_snapshot;
+	// Stopped before the members below are destroyed
+	std::unique_ptr<IoThread> m_thread;
 	boost::asio::io_service& m_io;
 
 	boost::asio::serial_port m_serial;
 	boost::asio::ip::tcp::socket m_socket;
 	bool m_usingSocket;
+	// For "sim:" and "replay:" device paths, created with the options following the prefix
+	std::unique_ptr<VirtualPrinter> m_simulator;
+	std::unique_ptr<CaptureReplayer> m_replayer;
+	std::string m_simulatorSpec;
+
+	std::shared_ptr<SerialCapture> m_capture;
+	mutable std::mutex m_captureMutex;
+
+	PrinterStats m_stats;
+	mutable std::mutex m_statsMutex;
+	// When the data being handled by readDone() arrived
+	std::chrono::steady_clock::time_point m_readTime;
 
-	boost::asio::deadline_timer m_reconnectTimer, m_timeoutTimer, m_temperatureTimer;
+	boost::asio::deadline_timer m_reconnectTimer, m_timeoutTimer, m_temperatureTimer, m_resendTimer, m_sdStatusTimer;
+	boost::asio::steady_timer m_wakeupTimer;
+	std::atomic<bool> m_realtime { false };
 
 	struct PendingCommand
 	{
 		std::string command, tag;
 		CommandCallback callback;
+		bool fromJob = false;
+		size_t jobCookie = 0;
+		std::chrono::steady_clock::time_point queued; // Priority commands only
 	};
 	std::vector<std::string> m_replyLines;
-	std::queue<PendingCommand> m_commandQueue;
+	// From a "Resend:" line, handled with the following "ok"
+	int m_pendingResend = -1;
+	std::deque<PendingCommand> m_commandQueue;
+	std::deque<PendingCommand> m_priorityQueue;
 
-	std::string m_executingCommand, m_executingTag;
-	std::string m_commandBuffer;
+	// A command that has been written out, kept around for resends
+	struct SentCommand
+	{
+		int lineNo; // -1 if sent without a line number
+		std::string command, tag;
+		CommandCallback callback;
+		size_t wireLength;
+		uint64_t commandId;
+		bool fromJob; // line of m_jobSource, identified by jobCookie
+		size_t jobCookie;
+		std::chrono::steady_clock::time_point written; // last (re)transmission
+	};
+	static const size_t MAX_RESEND_HISTORY = 64;
+	std::array<SentCommand, MAX_RESEND_HISTORY> m_sentCommands; // ring buffer indexed by the positions below
+	SentCommand& sentCommand(uint64_t pos) { return m_sentCommands[pos % MAX_RESEND_HISTORY]; }
+	const SentCommand& sentCommand(uint64_t pos) const { return m_sentCommands[pos % MAX_RESEND_HISTORY]; }
+
+	// [m_ackedPos, m_transmitPos) are in flight, [m_transmitPos, m_sentEnd) await retransmission
+	uint64_t m_ackedPos = 0, m_transmitPos = 0, m_sentEnd = 0;
+	// Commands before this position cannot be resent (line numbers were reset since)
+	uint64_t m_historyStart = 0;
+	size_t inFlightCount() const { return m_transmitPos - m_ackedPos; }
+	size_t m_inFlightBytes = 0;
+
+	// Free command slots as last reported by ADVANCED_OK, -1 if unknown
+	int m_freeSlots = -1;
+	// Replies possibly still coming for lines sent before the last resend request
+	int m_staleReplies = 0;
+
+	std::shared_ptr<JobSource> m_jobSource;
+	// Alternates between job lines and other commands when both are waiting
+	bool m_jobTurn = false;
+	// Commands queued before the job source was set (e.g. resume sequence), these go first
+	size_t m_commandsBeforeJob = 0;
+	// setJobSource() calls yet to be handled. Commands sent before them are still being queued,
+	// so the job waits until they can be counted in m_commandsBeforeJob.
+	std::atomic<int> m_pendingJobSources = 0;
+
+	bool m_streaming = false;
+	int m_rxBufferSize = 127;
+	double m_progressRate = 4, m_progressMinDelta = 0;
+	bool m_meatPackAllowed = true;
+	bool m_compaction = false;
+	int m_compactionDecimals = 3;
+	bool m_arcFitting = false;
+	double m_arcTolerance = 0.05;
+	bool m_decimation = false;
+	double m_decimationTolerance = 0.01;
+	// The firmware's unpacker has been switched on
+	bool m_meatPackActive = false;
+	int m_temperatureReportInterval = 2;
+	// The firmware sends temperatures by itself (M155), these are handled out of band
+	bool m_autoReportTemperatures = false;
+	bool m_sdOffload = false;
+	// Between M28 and M29 everything goes into a file on the SD card instead of being executed
+	bool m_sdWriting = false;
+	// SD status lines are handled out of band, the firmware may be sending them by itself
+	bool m_sdStatusReports = false;
+	// Size of the file from the last M27 report
+	size_t m_sdFileSize = 0;
+
+	std::string m_commandBuffer, m_writeBuffer, m_lineBuffer, m_packedBuffer;
+	bool m_writing = false;
 	boost::asio::streambuf m_streamBuf;
 
 	boost::signals2::signal<void(State)> m_stateChangeSignal;
 	boost::signals2::signal<void(std::map<std::string, float>)> m_temperatureChangeSignal;
-	boost::signals2::signal<void(GCodeEvent)> m_gcodeSignal;
+	boost::signals2::signal<void(const GCodeEvent&)> m_gcodeSignal;
+	boost::signals2::signal<void(SdStatus)> m_sdStatusSignal;
 
 	// M115 result
 	std::map<std::string, std::string> m_baseParameters;
 
-	std::list<TemperaturePoint> m_temperatures;
+	TemperatureHistory m_temperatureHistory;
+	// All the heaters reported so far on this connection
+	TemperatureReport m_lastReport;
 	mutable std::mutex m_temperaturesMutex;
 
 	PrintArea m_printArea;
@@ -216,21 +475,30 @@ private:
 	uint64_t m_nextCommandId = 0;
 
 	std::shared_ptr<PrintJob> m_printJob;
-	mutable std::mutex m_printJobMutex;
 	boost::signals2::signal<void(bool)> m_hasJobChangeSignal;
 
-	mutable std::mutex m_gcodeHistoryMutex;
 	static const size_t MAX_GCODE_HISTORY = 100; // max line count
-	std::list<GCodeEvent> m_gcodeHistory;
-
-	static const size_t MAX_RESEND_HISTORY = 50;
-	std::list<std::tuple<int, std::string>> m_resendHistory;
+	// A ring, allocated up front. Its strings keep their buffers for the lines that replace them.
+	std::vector<GCodeEvent> m_gcodeHistory = std::vector<GCodeEvent>(MAX_GCODE_HISTORY);
+	size_t m_gcodeHistoryStart = 0, m_gcodeHistorySize = 0;
 
-	PositioningState m_positioningState = { false, false };
+	PositioningState m_positioningState = { false, false, 0 };
 
-	mutable std::mutex m_miscMutex;
 	std::string m_errorMessage;
 };
 
+template<typename F>
+auto Printer::call(F&& fn) const -> decltype(fn())
+{
+	if (m_io.get_executor().running_in_this_thread())
+		return fn();
+
+	std::packaged_task<decltype(fn())()> task(std::forward<F>(fn));
+	auto result = task.get_future();
+
+	m_io.post([&task]() { task(); });
+	return result.get();
+}
+
 #endif /* PRINTER_H */
 
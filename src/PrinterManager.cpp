@@ -16,10 +16,13 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
+#include <boost/filesystem.hpp>
+#include <ctime>
 #include "util.h"
+#include "PrintJob.h"
 
-PrinterManager::PrinterManager(boost::asio::io_service& io, boost::property_tree::ptree& config)
-: m_io(io), m_config(config)
+PrinterManager::PrinterManager(boost::property_tree::ptree& config)
+: m_config(config)
 {
 	load();
 }
@@ -30,15 +33,24 @@ PrinterManager::~PrinterManager()
 
 void PrinterManager::save()
 {
-	boost::property_tree::ptree& printers = m_config.put_child("printers", boost::property_tree::ptree());
-	printers.put("default", m_defaultPrinter);
+	std::unique_lock<std::mutex> saveLock(m_saveMutex);
+	boost::property_tree::ptree printers;
+	std::map<std::string, std::shared_ptr<Printer>, std::less<>> copy;
 
-	for (auto it : m_printers)
+	{
+		std::unique_lock<std::mutex> lock(m_printersMutex);
+		copy = m_printers;
+		printers.put("default", m_defaultPrinter);
+	}
+
+	// Not under m_printersMutex, the printers' threads take it in signal handlers
+	for (auto it : copy)
 	{
 		boost::property_tree::ptree& printer = printers.put_child(it.first, boost::property_tree::ptree());
-		it.second->save(printer);
+		it.second->call([&]() { it.second->save(printer); });
 	}
 
+	m_config.put_child("printers", printers);
 	m_config.put("octoprint_api_key", m_octoprintApiKey);
 
 	saveConfig();
@@ -56,9 +68,21 @@ void PrinterManager::load()
 			if (it.second.empty()) // not a subtree
 				continue;
 
-			std::shared_ptr<Printer> printer = std::make_shared<Printer>(m_io);
-			printer->setUniqueName(it.first.c_str());
-			printer->load(it.second);
+			std::shared_ptr<Printer> printer = std::make_shared<Printer>();
+
+			printer->call([&]() {
+				printer->setUniqueName(it.first.c_str());
+				printer->setJournalPath(journalPath(it.first));
+				printer->load(it.second);
+			});
+
+			JobJournal::Contents job;
+			if (JobJournal::read(printer->journalPath(), job))
+			{
+				BOOST_LOG_TRIVIAL(info) << "Printer " << it.first << " was interrupted while printing " << job.jobName
+					<< ", it can be resumed from offset " << job.entry.offset;
+				m_interruptedJobs.emplace(it.first, job);
+			}
 
 			m_printers.emplace(it.first, printer);
 		}
@@ -69,9 +93,116 @@ void PrinterManager::load()
 		regenerateApiKey();
 }
 
-void PrinterManager::saveSettings()
+std::string PrinterManager::journalPath(std::string_view name) const
+{
+	boost::filesystem::path path(::getenv("HOME"));
+	boost::system::error_code ec;
+
+	path /= ".local/share/dashprint/journal";
+	boost::filesystem::create_directories(path, ec);
+
+	path /= std::string(name) + ".journal";
+	return path.string();
+}
+
+bool PrinterManager::startProbe(const std::vector<std::string>& devicePaths)
+{
+	std::unique_lock<std::mutex> lock(m_probeMutex);
+
+	if (m_probing)
+		return false;
+
+	if (!m_probeThread)
+		m_probeThread = std::make_unique<IoThread>("probe");
+
+	m_probing = true;
+	m_probeThread->io().post([=]() {
+		std::vector<PrinterProbe::Result> results = PrinterProbe::probe(devicePaths);
+
+		{
+			std::unique_lock<std::mutex> lock(m_probeMutex);
+			m_probeResults = std::move(results);
+			m_probing = false;
+		}
+
+		m_probeDoneSignal();
+	});
+
+	return true;
+}
+
+bool PrinterManager::probeResults(std::vector<PrinterProbe::Result>& results) const
+{
+	std::unique_lock<std::mutex> lock(m_probeMutex);
+
+	results = m_probeResults;
+	return m_probing;
+}
+
+std::string PrinterManager::capturePath(std::string_view name) const
+{
+	boost::filesystem::path path(::getenv("HOME"));
+	boost::system::error_code ec;
+
+	path /= ".local/share/dashprint/captures";
+	boost::filesystem::create_directories(path, ec);
+
+	std::time_t now = std::time(nullptr);
+	char when[sizeof "20111008-070709"];
+	std::strftime(when, sizeof when, "%Y%m%d-%H%M%S", std::localtime(&now));
+
+	path /= std::string(name) + "-" + when + ".dpcap";
+	return path.string();
+}
+
+bool PrinterManager::interruptedJob(std::string_view name, JobJournal::Contents& job) const
 {
 	std::unique_lock<std::mutex> lock(m_printersMutex);
+	auto it = m_interruptedJobs.find(name);
+
+	if (it == m_interruptedJobs.end())
+		return false;
+
+	job = it->second;
+	return true;
+}
+
+void PrinterManager::discardInterruptedJob(std::string_view name)
+{
+	std::shared_ptr<Printer> printer;
+
+	{
+		std::unique_lock<std::mutex> lock(m_printersMutex);
+		auto it = m_interruptedJobs.find(name);
+
+		if (it == m_interruptedJobs.end())
+			return;
+
+		m_interruptedJobs.erase(it);
+
+		auto pit = m_printers.find(name);
+		if (pit != m_printers.end())
+			printer = pit->second;
+	}
+
+	if (!printer)
+		return;
+
+	// Unless a new job has started and written its own journal there. A job that's only
+	// been set up (e.g. submitted as "Stopped") has none yet, the file is still the old one.
+	printer->call([&]() {
+		std::shared_ptr<PrintJob> job = printer->printJob();
+
+		if (!job || !job->hasJournal())
+		{
+			boost::system::error_code ec;
+			boost::filesystem::remove(printer->journalPath(), ec);
+		}
+	});
+}
+
+void PrinterManager::saveSettings()
+{
 	save();
 }
 
@@ -85,7 +216,7 @@ void PrinterManager::regenerateApiKey()
 
 std::shared_ptr<Printer> PrinterManager::newPrinter()
 {
-	return std::make_shared<Printer>(m_io);
+	return std::make_shared<Printer>();
 }
 
 std::shared_ptr<Printer> PrinterManager::printer(std::string_view name)
@@ -102,22 +233,29 @@ std::shared_ptr<Printer> PrinterManager::printer(std::string_view name)
 
 void PrinterManager::addPrinter(std::shared_ptr<Printer> printer)
 {
-	std::unique_lock<std::mutex> lock(m_printersMutex);
-	std::string origName = printer->uniqueName();
-	int idx = 2;
-	
-	while (m_printers.find(printer->uniqueName()) != m_printers.end())
+	// call() is never made under m_printersMutex, the printers' threads take it in signal handlers
+	const std::string origName = printer->call([&]() { return std::string(printer->uniqueName()); });
+	std::string name = origName;
+
 	{
-		std::string newName = origName + std::to_string(idx++);
-		printer->setUniqueName(newName.c_str());
+		std::unique_lock<std::mutex> lock(m_printersMutex);
+		int idx = 2;
+
+		while (m_printers.find(name) != m_printers.end())
+			name = origName + std::to_string(idx++);
+
+		m_printers.insert(std::make_pair(name, printer));
+		if (m_defaultPrinter.empty())
+			m_defaultPrinter = name;
 	}
 
-	BOOST_LOG_TRIVIAL(info) << "Adding a new printer, unique name: \""
-							<< printer->uniqueName() << "\", device: " << printer->devicePath();
-	
-	m_printers.insert(std::make_pair(printer->uniqueName(), printer));
-	if (m_defaultPrinter.empty())
-		m_defaultPrinter = printer->uniqueName();
+	printer->call([&]() {
+		printer->setUniqueName(name.c_str());
+		printer->setJournalPath(journalPath(name));
+
+		BOOST_LOG_TRIVIAL(info) << "Adding a new printer, unique name: \""
+								<< name << "\", device: " << printer->devicePath();
+	});
 
 	save();
 	m_printerListChangeSignal();
@@ -125,24 +263,30 @@ void PrinterManager::addPrinter(std::shared_ptr<Printer> printer)
 
 bool PrinterManager::deletePrinter(std::string_view name)
 {
-	std::unique_lock<std::mutex> lock(m_printersMutex);
-	auto it = m_printers.find(name);
-	
-	if (it != m_printers.end())
-		m_printers.erase(it);
-	else
-		return false;
-
-	BOOST_LOG_TRIVIAL(info) << "Printer " << name << "has been deleted";
+	// Destroyed after the lock is released, ~Printer waits for the printer's thread
+	std::shared_ptr<Printer> printer;
 
-	if (name == m_defaultPrinter)
 	{
-		if (!m_printers.empty())
-			m_defaultPrinter = m_printers.begin()->first;
-		else
-			m_defaultPrinter.clear();
+		std::unique_lock<std::mutex> lock(m_printersMutex);
+		auto it = m_printers.find(name);
+
+		if (it == m_printers.end())
+			return false;
+
+		printer = it->second;
+		m_printers.erase(it);
+
+		if (name == m_defaultPrinter)
+		{
+			if (!m_printers.empty())
+				m_defaultPrinter = m_printers.begin()->first;
+			else
+				m_defaultPrinter.clear();
+		}
 	}
 
+	BOOST_LOG_TRIVIAL(info) << "Printer " << name << " has been deleted";
+
 	save();
 	m_printerListChangeSignal();
 
@@ -22,11 +22,15 @@
 #include <boost/asio.hpp>
 #include <boost/signals2.hpp>
 #include "Printer.h"
+#include "JobJournal.h"
+#include "PrinterProbe.h"
+#include "IoThread.h"
 
 class PrinterManager
 {
 public:
-	PrinterManager(boost::asio::io_service& io, boost::property_tree::ptree& config);
+	// Each printer runs on a thread of its own
+	PrinterManager(boost::property_tree::ptree& config);
 	~PrinterManager();
 
 	PrinterManager& operator=(const PrinterManager& that) = delete;
@@ -40,21 +44,46 @@ public:
 	void setDefaultPrinter(std::string_view name);
 	const char* defaultPrinter();
 
+	// Jobs that were running when dashprint last quit or crashed, found in the printers' journals
+	bool interruptedJob(std::string_view name, JobJournal::Contents& job) const;
+	void discardInterruptedJob(std::string_view name);
+
+	// A new file for capturing the traffic of the named printer
+	std::string capturePath(std::string_view name) const;
+
+	// Probes the ports on a thread of its own, returns false if a probe is already running.
+	// The results replace the previous ones once all ports are done, see probeDoneSignal().
+	bool startProbe(const std::vector<std::string>& devicePaths);
+	// Returns whether a probe is still running
+	bool probeResults(std::vector<PrinterProbe::Result>& results) const;
+
 	void saveSettings();
 	boost::signals2::signal<void()>& printerListChangeSignal() { return m_printerListChangeSignal; }
+	// Emitted on the probe thread
+	boost::signals2::signal<void()>& probeDoneSignal() { return m_probeDoneSignal; }
 	void regenerateApiKey();
 private:
 	void save();
 	void load();
+	std::string journalPath(std::string_view name) const;
 private:
-	boost::asio::io_service& m_io;
 	boost::property_tree::ptree& m_config;
 	std::map<std::string, std::shared_ptr<Printer>, std::less<>> m_printers;
 	mutable std::mutex m_printersMutex;
+	// Serializes save(), which runs without m_printersMutex
+	std::mutex m_saveMutex;
 	std::string m_defaultPrinter;
+	std::map<std::string, JobJournal::Contents, std::less<>> m_interruptedJobs;
 
 	boost::signals2::signal<void()> m_printerListChangeSignal;
 	std::string m_octoprintApiKey;
+
+	std::vector<PrinterProbe::Result> m_probeResults;
+	bool m_probing = false;
+	mutable std::mutex m_probeMutex;
+	boost::signals2::signal<void()> m_probeDoneSignal;
+	// Created on the first probe. Last, so that a probe still running is waited for before the above goes away.
+	std::unique_ptr<IoThread> m_probeThread;
 };
 
 #endif /* PRINTERMANAGER_H */
@@ -0,0 +1,240 @@
+#include "PrinterProbe.h"
+#include "Printer.h"
+#include "SerialTuning.h"
+#include <memory>
+#include <system_error>
+#include <boost/asio.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/log/trivial.hpp>
+#include <sys/ioctl.h>
+#include <termios.h>
+
+namespace
+{
+const std::string HANDSHAKE = "\nM110 N0\nM115\n";
+
+class PortProbe
+{
+public:
+	PortProbe(boost::asio::io_service& io, const PrinterProbe::Options& options, std::chrono::steady_clock::time_point deadline, PrinterProbe::Result& result)
+	: m_options(options), m_deadline(deadline), m_result(result), m_serial(io), m_timer(io)
+	{
+	}
+
+	void start();
+private:
+	void nextAttempt();
+	void sendHandshake();
+	// The attempt at m_baudRate is over after this, or at the deadline
+	void armTimer();
+	void doRead();
+	void readDone(const boost::system::error_code& ec, size_t bytesRead);
+	void handleLine(const std::string& line);
+	void finish();
+private:
+	const PrinterProbe::Options& m_options;
+	const std::chrono::steady_clock::time_point m_deadline;
+	PrinterProbe::Result& m_result;
+
+	boost::asio::serial_port m_serial;
+	boost::asio::steady_timer m_timer;
+	size_t m_attempts = 0;
+	int m_baudRate = 0;
+	bool m_writing = false, m_done = false;
+
+	char m_readBuffer[256];
+	std::string m_line;
+	// The M115 reply so far
+	std::vector<std::string> m_reply;
+};
+
+void PortProbe::start()
+{
+	try
+	{
+		m_serial.open(m_result.devicePath);
+		::ioctl(m_serial.native_handle(), TIOCEXCL);
+
+		// Like Printer does, so that it doesn't reset the board again when it opens the port
+		struct termios tos;
+		if (::tcgetattr(m_serial.native_handle(), &tos) == 0 && (tos.c_cflag & HUPCL))
+		{
+			tos.c_cflag &= ~HUPCL;
+			::tcsetattr(m_serial.native_handle(), TCSANOW, &tos);
+		}
+
+		m_serial.set_option(boost::asio::serial_port_base::character_size(8));
+		m_serial.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
+		m_serial.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none));
+		m_serial.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none));
+	}
+	catch (const std::exception& e)
+	{
+		m_result.error = e.what();
+		finish();
+		return;
+	}
+
+	doRead();
+	nextAttempt();
+}
+
+void PortProbe::nextAttempt()
+{
+	const auto now = std::chrono::steady_clock::now();
+
+	if (m_done)
+		return;
+	if (now >= m_deadline || m_options.baudRates.empty())
+	{
+		finish();
+		return;
+	}
+
+	m_baudRate = m_options.baudRates[m_attempts++ % m_options.baudRates.size()];
+
+	try
+	{
+		SerialTuning().apply(m_serial.native_handle(), m_baudRate);
+	}
+	catch (const std::system_error& e)
+	{
+		m_result.error = e.what();
+		finish();
+		return;
+	}
+
+	// Whatever came at the previous rate
+	::tcflush(m_serial.native_handle(), TCIOFLUSH);
+	m_line.clear();
+	m_reply.clear();
+
+	sendHandshake();
+	armTimer();
+}
+
+void PortProbe::armTimer()
+{
+	const auto left = m_deadline - std::chrono::steady_clock::now();
+
+	m_timer.expires_after(std::min<std::chrono::steady_clock::duration>(m_options.attemptTimeout, left));
+	m_timer.async_wait([=](const boost::system::error_code& ec) {
+		if (!ec)
+			nextAttempt();
+	});
+}
+
+void PortProbe::sendHandshake()
+{
+	// A write stuck on a port that doesn't take data is left alone, there's nothing to add to it
+	if (m_writing)
+		return;
+
+	m_writing = true;
+	boost::asio::async_write(m_serial, boost::asio::buffer(HANDSHAKE), [=](const boost::system::error_code& ec, size_t) {
+		m_writing = false;
+	});
+}
+
+void PortProbe::doRead()
+{
+	m_serial.async_read_some(boost::asio::buffer(m_readBuffer), std::bind(&PortProbe::readDone, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void PortProbe::readDone(const boost::system::error_code& ec, size_t bytesRead)
+{
+	if (ec || m_done)
+	{
+		if (ec && ec != boost::asio::error::operation_aborted)
+		{
+			m_result.error = ec.message();
+			finish();
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < bytesRead && !m_done; i++)
+	{
+		const char c = m_readBuffer[i];
+
+		if (c == '\n')
+		{
+			if (!m_line.empty() && m_line.back() == '\r')
+				m_line.pop_back();
+
+			handleLine(m_line);
+			m_line.clear();
+		}
+		else if (m_line.length() < 1024)
+			m_line.push_back(c);
+	}
+
+	if (!m_done)
+		doRead();
+}
+
+void PortProbe::handleLine(const std::string& line)
+{
+	if (line.find("FIRMWARE_NAME:") != std::string::npos || boost::starts_with(line, "Cap:"))
+		m_reply.push_back(line);
+	else if (line == "start")
+	{
+		// The board has just booted at this rate, most likely after being reset by opening the port.
+		// It ignored the handshake while doing so.
+		m_reply.clear();
+		sendHandshake();
+		armTimer();
+	}
+	else if (boost::starts_with(line, "ok") && !m_reply.empty())
+	{
+		m_result.baudRate = m_baudRate;
+		Printer::parseFirmwareInfo(m_reply, m_result.firmwareInfo);
+
+		auto it = m_result.firmwareInfo.find("FIRMWARE_NAME");
+		if (it != m_result.firmwareInfo.end())
+			m_result.firmwareName = it->second;
+
+		finish();
+	}
+}
+
+void PortProbe::finish()
+{
+	boost::system::error_code ec;
+
+	m_done = true;
+	m_timer.cancel(ec);
+	m_serial.cancel(ec);
+	m_serial.close(ec);
+
+	if (m_result.found())
+		BOOST_LOG_TRIVIAL(info) << "Found " << m_result.firmwareName << " on " << m_result.devicePath << " at " << m_result.baudRate << " baud";
+	else
+		BOOST_LOG_TRIVIAL(debug) << "No printer found on " << m_result.devicePath << (m_result.error.empty() ? "" : ": ") << m_result.error;
+}
+}
+
+std::vector<PrinterProbe::Result> PrinterProbe::probe(const std::vector<std::string>& devicePaths)
+{
+	return probe(devicePaths, Options());
+}
+
+std::vector<PrinterProbe::Result> PrinterProbe::probe(const std::vector<std::string>& devicePaths, const Options& options)
+{
+	boost::asio::io_service io;
+	std::vector<Result> results(devicePaths.size());
+	std::vector<std::unique_ptr<PortProbe>> ports;
+	const auto deadline = std::chrono::steady_clock::now() + options.deadline;
+
+	for (size_t i = 0; i < devicePaths.size(); i++)
+	{
+		results[i].devicePath = devicePaths[i];
+		ports.push_back(std::make_unique<PortProbe>(io, options, deadline, results[i]));
+		ports.back()->start();
+	}
+
+	// Until every port is done and nothing is pending on any of them
+	io.run();
+
+	return results;
+}
@@ -0,0 +1,44 @@
+#ifndef _PRINTERPROBE_H
+#define _PRINTERPROBE_H
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+// Finds the baud rate and firmware of printers on serial ports, probing all the ports at once.
+// Each port is sent "M110 N0" and "M115" at one candidate rate after another, until the M115 reply comes.
+// Boards that reset when the port is opened are given another round once they've booted.
+class PrinterProbe
+{
+public:
+	struct Options
+	{
+		// Most likely first
+		std::vector<int> baudRates = { 115200, 250000, 230400, 57600, 500000, 1000000, 38400, 19200 };
+		// How long each rate gets for a reply
+		std::chrono::milliseconds attemptTimeout{250};
+		// When all ports are given up on
+		std::chrono::milliseconds deadline{2500};
+	};
+
+	struct Result
+	{
+		std::string devicePath;
+		// 0 if nothing answered
+		int baudRate = 0;
+		std::string firmwareName;
+		// As parsed by Printer::parseFirmwareInfo(), capabilities under "Cap:" keys
+		std::map<std::string, std::string> firmwareInfo;
+		// Why the port couldn't be probed, e.g. if it can't be opened
+		std::string error;
+
+		bool found() const { return baudRate != 0; }
+	};
+
+	// Returns once all the ports have answered or the deadline is over, with results in the order of devicePaths.
+	// The I/O is asynchronous on an io_service of its own, run by the calling thread.
+	static std::vector<Result> probe(const std::vector<std::string>& devicePaths, const Options& options);
+	static std::vector<Result> probe(const std::vector<std::string>& devicePaths);
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "PrinterStats.h"
+#include <algorithm>
+#include <cctype>
+
+int LatencyHistogram::bucketIndex(uint64_t value)
+{
+	if (value < SUB_BUCKETS)
+		return int(value);
+
+	value = std::min<uint64_t>(value, (uint64_t(1) << MAX_BITS) - 1);
+
+	const int exponent = 63 - __builtin_clzll(value);
+	const int sub = int(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+
+	return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketEnd(int index)
+{
+	if (index < SUB_BUCKETS)
+		return index;
+
+	const int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+	const uint64_t start = uint64_t(SUB_BUCKETS + index % SUB_BUCKETS) << (exponent - SUB_BUCKET_BITS);
+
+	return start + (uint64_t(1) << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::microseconds latency)
+{
+	const uint64_t value = std::max<int64_t>(latency.count(), 0);
+
+	m_buckets[bucketIndex(value)]++;
+	m_count++;
+	m_sum += value;
+	m_min = std::min(m_min, value);
+	m_max = std::max(m_max, value);
+}
+
+std::chrono::microseconds LatencyHistogram::percentile(double percent) const
+{
+	if (m_count == 0)
+		return std::chrono::microseconds(0);
+
+	// Rank of the value looked for, 1-based
+	const uint64_t rank = std::max<uint64_t>(1, uint64_t(std::clamp(percent, 0.0, 100.0) / 100 * m_count + 0.5));
+	uint64_t seen = 0;
+
+	for (int i = 0; i < BUCKETS; i++)
+	{
+		seen += m_buckets[i];
+
+		if (seen >= rank)
+			return std::chrono::microseconds(std::min(bucketEnd(i), m_max));
+	}
+
+	return max();
+}
+
+void PrinterStats::recordLatency(std::string_view command, std::chrono::microseconds latency)
+{
+	const std::string_view key = commandKey(command);
+	auto it = latencies.find(key);
+
+	if (it == latencies.end())
+		it = latencies.emplace(std::string(key), LatencyHistogram()).first;
+
+	it->second.record(latency);
+}
+
+void PrinterStats::recordQueueDepth(size_t queued, size_t inFlight)
+{
+	queuedCommands = queued;
+	this->inFlight = inFlight;
+	maxQueuedCommands = std::max(maxQueuedCommands, queued);
+	maxInFlight = std::max(maxInFlight, inFlight);
+}
+
+std::chrono::microseconds PrinterStats::roundTrip() const
+{
+	std::chrono::microseconds best(0);
+
+	for (const auto& [code, histogram] : latencies)
+	{
+		if (histogram.count() > 0 && (best.count() == 0 || histogram.min() < best))
+			best = histogram.min();
+	}
+
+	return best;
+}
+
+std::string_view PrinterStats::commandKey(std::string_view command)
+{
+	size_t end = 0;
+
+	if (!command.empty() && std::isalpha((unsigned char) command[0]))
+	{
+		end = 1;
+		while (end < command.length() && std::isdigit((unsigned char) command[end]))
+			end++;
+	}
+
+	// Not a regular command, e.g. a host keyword like "@pause"
+	if (end <= 1)
+		return command.substr(0, command.find(' '));
+
+	return command.substr(0, end);
+}
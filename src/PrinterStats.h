@@ -0,0 +1,67 @@
+#ifndef _PRINTERSTATS_H
+#define _PRINTERSTATS_H
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstdint>
+
+// Latency distribution with HDR-style log-linear buckets: exact below 32 us, then 32 buckets per power of two,
+// so that every value is known within 1/32 (about 3 %). Covers up to 2^40 us, larger values are clamped.
+class LatencyHistogram
+{
+public:
+	void record(std::chrono::microseconds latency);
+
+	uint64_t count() const { return m_count; }
+	std::chrono::microseconds min() const { return std::chrono::microseconds(m_count ? m_min : 0); }
+	std::chrono::microseconds max() const { return std::chrono::microseconds(m_max); }
+	std::chrono::microseconds mean() const { return std::chrono::microseconds(m_count ? m_sum / m_count : 0); }
+	// Highest value in the bucket where the percentile (0-100) falls, at most max()
+	std::chrono::microseconds percentile(double percent) const;
+
+	static constexpr int SUB_BUCKET_BITS = 5;
+	static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static constexpr int MAX_BITS = 40;
+	static constexpr int BUCKETS = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+private:
+	static int bucketIndex(uint64_t value);
+	static uint64_t bucketEnd(int index);
+private:
+	std::array<uint64_t, BUCKETS> m_buckets{};
+	uint64_t m_count = 0, m_sum = 0;
+	uint64_t m_min = UINT64_MAX, m_max = 0;
+};
+
+// Where the time goes on a printer link, see Printer::stats()
+struct PrinterStats
+{
+	// From writing a command to receiving its "ok", by command code
+	std::map<std::string, LatencyHistogram, std::less<>> latencies;
+
+	uint64_t bytesSent = 0, bytesReceived = 0;
+	// Resend requests handled and the lines retransmitted because of them
+	uint64_t resendRequests = 0, linesResent = 0;
+	// Connections dropped for not getting replies
+	uint64_t timeouts = 0;
+	// Commands waiting to be written and lines awaiting their "ok", currently and at most
+	size_t queuedCommands = 0, inFlight = 0;
+	size_t maxQueuedCommands = 0, maxInFlight = 0;
+	// How late the printer's thread runs a timer that expired, sampled every 10 ms
+	LatencyHistogram wakeupLatency;
+	// From sendPriorityCommand() to the command being written out
+	LatencyHistogram priorityLatency;
+
+	std::chrono::system_clock::time_point since = std::chrono::system_clock::now();
+
+	void recordLatency(std::string_view command, std::chrono::microseconds latency);
+	void recordQueueDepth(size_t queued, size_t inFlight);
+	// Lowest latency of any command: the link's round trip plus the firmware's quickest reply, 0 if none yet
+	std::chrono::microseconds roundTrip() const;
+
+	// The letter and number starting a command, e.g. "G1" for "G1 X10" or the compacted "G1X10"
+	static std::string_view commandKey(std::string_view command);
+};
+
+#endif
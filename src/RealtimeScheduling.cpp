@@ -0,0 +1,149 @@
+#include "RealtimeScheduling.h"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <boost/algorithm/string.hpp>
+#include <boost/log/trivial.hpp>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+RealtimeScheduling::Options RealtimeScheduling::s_options;
+
+RealtimeScheduling::Options RealtimeScheduling::Options::parse(const boost::property_tree::ptree& tree)
+{
+	Options options;
+	const std::string policy = tree.get<std::string>("policy", "fifo");
+
+	options.priority = tree.get<int>("priority", 0);
+	if (options.priority < 0 || options.priority > 99)
+		throw std::invalid_argument("Realtime priority must be between 0 and 99");
+
+	if (policy == "rr")
+		options.roundRobin = true;
+	else if (policy != "fifo")
+		throw std::invalid_argument("Unknown realtime policy: " + policy);
+
+	options.cpus = parseCpuList(tree.get<std::string>("cpus", ""));
+	options.lockMemory = tree.get<bool>("lock_memory", false);
+
+	return options;
+}
+
+std::vector<int> RealtimeScheduling::Options::parseCpuList(const std::string& list)
+{
+	std::vector<int> cpus;
+	std::vector<std::string> items;
+
+	if (boost::algorithm::trim_copy(list).empty())
+		return cpus;
+
+	boost::algorithm::split(items, list, boost::is_any_of(","));
+
+	for (std::string item : items)
+	{
+		boost::algorithm::trim(item);
+
+		const size_t dash = item.find('-');
+		int first, last;
+
+		try
+		{
+			size_t end;
+
+			first = std::stoi(item, &end);
+			if (dash == std::string::npos)
+			{
+				last = first;
+				if (end != item.length())
+					throw std::invalid_argument(item);
+			}
+			else
+			{
+				const std::string rest = item.substr(dash + 1);
+
+				last = std::stoi(rest, &end);
+				if (end != rest.length() || dash != item.find_first_not_of("0123456789 "))
+					throw std::invalid_argument(item);
+			}
+		}
+		catch (const std::logic_error&)
+		{
+			throw std::invalid_argument("Invalid CPU list: " + list);
+		}
+
+		if (first < 0 || last < first || last >= CPU_SETSIZE)
+			throw std::invalid_argument("Invalid CPU list: " + list);
+
+		for (int cpu = first; cpu <= last; cpu++)
+			cpus.push_back(cpu);
+	}
+
+	return cpus;
+}
+
+void RealtimeScheduling::configure(const Options& options)
+{
+	s_options = options;
+
+	if (options.lockMemory)
+	{
+		// Not MCL_FUTURE, see the header. MCL_ONFAULT wouldn't help, mmap() still checks the limit.
+		if (::mlockall(MCL_CURRENT) != 0)
+			BOOST_LOG_TRIVIAL(warning) << "Cannot lock memory: " << std::strerror(errno);
+		else
+			BOOST_LOG_TRIVIAL(info) << "Process memory locked";
+	}
+
+	if (options.cpus.empty())
+		return;
+
+	// Everything but the printer threads goes to the remaining CPUs
+	cpu_set_t set;
+	const long online = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+	CPU_ZERO(&set);
+	for (int cpu = 0; cpu < online && cpu < CPU_SETSIZE; cpu++)
+		CPU_SET(cpu, &set);
+	for (int cpu : options.cpus)
+		CPU_CLR(cpu, &set);
+
+	if (CPU_COUNT(&set) == 0)
+		BOOST_LOG_TRIVIAL(warning) << "No CPUs left for the other threads, leaving them unpinned";
+	else if (::sched_setaffinity(0, sizeof(set), &set) != 0)
+		BOOST_LOG_TRIVIAL(warning) << "Cannot set CPU affinity: " << std::strerror(errno);
+}
+
+bool RealtimeScheduling::enter()
+{
+	if (!s_options.cpus.empty())
+	{
+		cpu_set_t set;
+
+		CPU_ZERO(&set);
+		for (int cpu : s_options.cpus)
+			CPU_SET(cpu, &set);
+
+		// 0 is the calling thread rather than the whole process
+		if (::sched_setaffinity(0, sizeof(set), &set) != 0)
+			BOOST_LOG_TRIVIAL(warning) << "Cannot pin printer thread to its CPUs: " << std::strerror(errno);
+	}
+
+	if (s_options.priority == 0)
+		return false;
+
+	struct sched_param param = {};
+	const int policy = s_options.roundRobin ? SCHED_RR : SCHED_FIFO;
+
+	param.sched_priority = s_options.priority;
+
+	// Journal, capture and estimator threads started from here mustn't compete with streaming
+	if (::sched_setscheduler(0, policy | SCHED_RESET_ON_FORK, &param) != 0)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Cannot set real-time priority " << s_options.priority << ": " << std::strerror(errno)
+			<< (errno == EPERM ? " (needs CAP_SYS_NICE or an rtprio limit)" : "");
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,45 @@
+#ifndef _REALTIMESCHEDULING_H
+#define _REALTIMESCHEDULING_H
+#include <string>
+#include <vector>
+#include <boost/property_tree/ptree.hpp>
+
+// Optional real-time scheduling for the printer threads, from the "Realtime" config section:
+//   priority     SCHED_FIFO/SCHED_RR priority 1-99, 0 (default) leaves the policy alone
+//   policy       "fifo" (default) or "rr"
+//   cpus         CPUs reserved for the printer threads, e.g. "2,3" or "2-3"
+//   lock_memory  mlockall() what the process has mapped at startup, so that page faults don't stall streaming.
+//                Later mappings aren't locked: with MCL_FUTURE, mapping a G-code file would count against
+//                RLIMIT_MEMLOCK and fail with EAGAIN once it's bigger than the limit.
+// Needs CAP_SYS_NICE (or an rtprio limit) and CAP_IPC_LOCK (or a memlock limit), failures are logged and ignored.
+class RealtimeScheduling
+{
+public:
+	struct Options
+	{
+		int priority = 0;
+		bool roundRobin = false;
+		std::vector<int> cpus;
+		bool lockMemory = false;
+
+		bool enabled() const { return priority > 0 || !cpus.empty(); }
+
+		// Throws std::invalid_argument on values out of range
+		static Options parse(const boost::property_tree::ptree& tree);
+		static std::vector<int> parseCpuList(const std::string& list);
+	};
+
+	// To be called on the main thread before any other thread is started. Locks memory if asked to
+	// and moves the calling thread off the reserved CPUs, threads started later inherit that.
+	static void configure(const Options& options);
+	static const Options& options() { return s_options; }
+
+	// Applies the policy and the reserved CPUs to the calling thread. Threads it starts later
+	// get normal scheduling back (SCHED_RESET_ON_FORK), but stay on its CPUs.
+	// Returns true if the thread now runs with a real-time policy.
+	static bool enter();
+private:
+	static Options s_options;
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "ReplyTokenizer.h"
+#include <cstring>
+
+static inline bool startsWith(std::string_view line, std::string_view prefix)
+{
+	return line.compare(0, prefix.length(), prefix) == 0;
+}
+
+static inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static int parseNumber(std::string_view str)
+{
+	size_t i = 0;
+	int value = 0;
+
+	while (i < str.length() && (str[i] == ' ' || str[i] == ':'))
+		i++;
+
+	if (i == str.length() || !isDigit(str[i]))
+		return -1;
+
+	for (; i < str.length() && isDigit(str[i]); i++)
+		value = value * 10 + (str[i] - '0');
+
+	return value;
+}
+
+// "T:", "T0:", "B:" at the beginning of the line (after optional spaces)
+static bool isTemperatureReport(std::string_view line)
+{
+	size_t i = line.find_first_not_of(' ');
+
+	if (i == std::string_view::npos || i + 1 >= line.length())
+		return false;
+
+	if (line[i] != 'T' && line[i] != 'B')
+		return false;
+
+	i++;
+	while (i < line.length() && isDigit(line[i]))
+		i++;
+
+	return i < line.length() && line[i] == ':';
+}
+
+size_t ReplyTokenizer::next(const char* data, size_t length, Reply& reply)
+{
+	const char* eol = static_cast<const char*>(std::memchr(data, '\n', length));
+
+	if (!eol)
+		return 0;
+
+	size_t lineLength = eol - data;
+	if (lineLength > 0 && data[lineLength - 1] == '\r')
+		lineLength--;
+
+	reply.line = std::string_view(data, lineLength);
+	reply.kind = classify(reply.line, reply.number);
+
+	return eol - data + 1;
+}
+
+ReplyTokenizer::Kind ReplyTokenizer::classify(std::string_view line, int& number)
+{
+	number = -1;
+
+	if (line.empty())
+		return Kind::Other;
+
+	// Dispatch on the first character, then confirm the prefix
+	switch (line[0])
+	{
+		case 'o':
+			if (startsWith(line, "ok") && (line.length() == 2 || line[2] == ' '))
+				return Kind::Ok;
+			break;
+		case 'R':
+			if (startsWith(line, "Resend"))
+			{
+				number = parseNumber(line.substr(6));
+				return Kind::Resend;
+			}
+			break;
+		case 'r':
+			if (startsWith(line, "rs "))
+			{
+				number = parseNumber(line.substr(3));
+				return Kind::Resend;
+			}
+			break;
+		case 'E':
+			if (startsWith(line, "Error:"))
+				return Kind::Error;
+			break;
+		case '!':
+			if (startsWith(line, "!!"))
+				return Kind::Error;
+			break;
+		case 'e':
+			if (startsWith(line, "echo:"))
+			{
+				if (startsWith(line.substr(5), "busy:"))
+					return Kind::Busy;
+				return Kind::Echo;
+			}
+			break;
+		case 'b':
+			if (startsWith(line, "busy:"))
+				return Kind::Busy;
+			break;
+		case '/':
+			if (startsWith(line, "//"))
+				return Kind::Echo;
+			break;
+		case 's':
+			if (line == "start")
+				return Kind::Start;
+			break;
+		case ' ':
+		case 'T':
+		case 'B':
+			if (isTemperatureReport(line))
+				return Kind::Temperature;
+			break;
+		case 'S':
+			if (startsWith(line, "SD printing byte"))
+				return Kind::SdStatus;
+			break;
+		case 'N':
+			if (startsWith(line, "Not SD printing"))
+				return Kind::SdStatus;
+			break;
+		case 'D':
+			if (startsWith(line, "Done printing file"))
+				return Kind::SdStatus;
+			break;
+	}
+
+	return Kind::Other;
+}
+
+const char* ReplyTokenizer::kindName(Kind kind)
+{
+	switch (kind)
+	{
+		case Kind::Ok:
+			return "Ok";
+		case Kind::Resend:
+			return "Resend";
+		case Kind::Error:
+			return "Error";
+		case Kind::Busy:
+			return "Busy";
+		case Kind::Echo:
+			return "Echo";
+		case Kind::Temperature:
+			return "Temperature";
+		case Kind::Start:
+			return "Start";
+		case Kind::SdStatus:
+			return "SdStatus";
+		default:
+			return "Other";
+	}
+}
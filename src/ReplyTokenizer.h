@@ -0,0 +1,39 @@
+#ifndef _REPLYTOKENIZER_H
+#define _REPLYTOKENIZER_H
+#include <string_view>
+#include <cstddef>
+
+// Splits data coming from the printer into lines and classifies them.
+// Works on the receive buffer in place, nothing is copied or allocated.
+class ReplyTokenizer
+{
+public:
+	enum class Kind
+	{
+		Ok,          // "ok", possibly followed by data (ADVANCED_OK, M105 temperatures)
+		Resend,      // "Resend: N", "rs N"
+		Error,       // "Error:...", Klipper's "!! ..."
+		Busy,        // "busy: processing", "echo:busy: processing"
+		Echo,        // "echo:...", Klipper's "// ..."
+		Temperature, // Unsolicited temperature reports (M109/M190 waits, M155 autoreport)
+		Start,       // "start", the firmware has (re)started
+		SdStatus,    // "SD printing byte 10/200", "Not SD printing" (M27), "Done printing file"
+		Other
+	};
+
+	struct Reply
+	{
+		Kind kind;
+		std::string_view line; // Without the line terminator
+		int number;            // Line to resend for Kind::Resend, -1 otherwise
+	};
+
+	// Extracts the next complete line from data.
+	// Returns the number of bytes consumed, 0 if there's no complete line yet.
+	static size_t next(const char* data, size_t length, Reply& reply);
+
+	static Kind classify(std::string_view line, int& number);
+	static const char* kindName(Kind kind);
+};
+
+#endif
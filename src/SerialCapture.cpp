@@ -0,0 +1,159 @@
+#include "SerialCapture.h"
+#include <stdexcept>
+#include <cstring>
+#include <boost/log/trivial.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+
+static constexpr char FILE_MAGIC[4] = { 'D', 'P', 'C', '1' };
+
+static void appendVarint(std::string& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out += char((value & 0x7f) | 0x80);
+		value >>= 7;
+	}
+	out += char(value);
+}
+
+static bool readVarint(const std::string& in, size_t& pos, uint64_t& value)
+{
+	value = 0;
+
+	for (int shift = 0; shift < 64 && pos < in.length(); shift += 7)
+	{
+		const uint8_t byte = in[pos++];
+
+		value |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+
+	return false;
+}
+
+SerialCapture::SerialCapture(const std::string& path)
+: m_path(path), m_lastRecord(std::chrono::steady_clock::now())
+{
+	m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (m_fd == -1)
+		throw std::runtime_error("Cannot create the capture file");
+
+	if (::write(m_fd, FILE_MAGIC, sizeof(FILE_MAGIC)) != sizeof(FILE_MAGIC))
+	{
+		::close(m_fd);
+		throw std::runtime_error("Cannot write the capture file");
+	}
+
+	m_thread = std::thread(&SerialCapture::writerThread, this);
+}
+
+SerialCapture::~SerialCapture()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+
+	m_cond.notify_one();
+	m_thread.join();
+
+	::close(m_fd);
+}
+
+void SerialCapture::record(Event event, const char* data, size_t length)
+{
+	const auto now = std::chrono::steady_clock::now();
+
+	if (event == Event::Sent)
+		m_bytesSent += length;
+	else if (event == Event::Received)
+		m_bytesReceived += length;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		appendVarint(m_buffer, (uint64_t(length) << 2) | uint64_t(event));
+		appendVarint(m_buffer, std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastRecord).count());
+		if (length > 0)
+			m_buffer.append(data, length);
+
+		m_lastRecord = now;
+	}
+
+	m_cond.notify_one();
+}
+
+void SerialCapture::writerThread()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	std::string writing;
+	bool failed = false;
+
+	while (true)
+	{
+		m_cond.wait(lock, [this]() { return !m_buffer.empty() || m_quit; });
+
+		if (!m_buffer.empty())
+		{
+			writing.swap(m_buffer);
+
+			// Don't hold up record() while writing
+			lock.unlock();
+
+			if (!failed && ::write(m_fd, writing.c_str(), writing.length()) != ssize_t(writing.length()))
+			{
+				BOOST_LOG_TRIVIAL(error) << "Failed to write the capture " << m_path << ": " << std::strerror(errno);
+				failed = true;
+			}
+
+			writing.clear();
+			lock.lock();
+		}
+		else if (m_quit)
+			break;
+	}
+}
+
+bool SerialCapture::read(const std::string& path, std::vector<Record>& records)
+{
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return false;
+
+	std::string contents;
+	char buf[65536];
+	ssize_t rd;
+
+	while ((rd = ::read(fd, buf, sizeof(buf))) > 0)
+		contents.append(buf, rd);
+
+	::close(fd);
+
+	if (rd < 0 || contents.compare(0, sizeof(FILE_MAGIC), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+		return false;
+
+	size_t pos = sizeof(FILE_MAGIC);
+	std::chrono::microseconds time(0);
+
+	records.clear();
+
+	while (pos < contents.length())
+	{
+		uint64_t tag, delta;
+
+		if (!readVarint(contents, pos, tag) || !readVarint(contents, pos, delta))
+			break;
+
+		const uint64_t length = tag >> 2;
+		if ((tag & 3) > uint64_t(Event::Connected) || length > contents.length() - pos)
+			break;
+
+		time += std::chrono::microseconds(delta);
+		records.push_back(Record{ Event(tag & 3), time, contents.substr(pos, length) });
+		pos += length;
+	}
+
+	return true;
+}
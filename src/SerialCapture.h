@@ -0,0 +1,65 @@
+#ifndef _SERIALCAPTURE_H
+#define _SERIALCAPTURE_H
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Records everything sent and received on a printer link with monotonic timestamps, for replaying with CaptureReplayer.
+// The file starts with "DPC1", followed by records made of two varints, (length << 2 | event) and
+// microseconds since the previous record, and the data. Records are written out by a background thread.
+class SerialCapture
+{
+public:
+	enum class Event : uint8_t
+	{
+		Sent = 0,
+		Received = 1,
+		// The link has been (re)established, no data
+		Connected = 2
+	};
+
+	struct Record
+	{
+		Event event;
+		// Since the start of the capture
+		std::chrono::microseconds time;
+		std::string data;
+	};
+
+	// Creates a new capture, replacing any previous one at path. Throws std::runtime_error.
+	SerialCapture(const std::string& path);
+	SerialCapture(const SerialCapture&) = delete;
+	~SerialCapture();
+
+	SerialCapture& operator=(const SerialCapture&) = delete;
+
+	void record(Event event, const char* data = nullptr, size_t length = 0);
+
+	const std::string& path() const { return m_path; }
+	uint64_t bytesSent() const { return m_bytesSent; }
+	uint64_t bytesReceived() const { return m_bytesReceived; }
+
+	// Returns false if path isn't a capture. A truncated last record (e.g. after a crash) is ignored.
+	static bool read(const std::string& path, std::vector<Record>& records);
+private:
+	void writerThread();
+private:
+	std::string m_path;
+	int m_fd;
+	std::chrono::steady_clock::time_point m_lastRecord;
+	std::atomic<uint64_t> m_bytesSent{0}, m_bytesReceived{0};
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::string m_buffer;
+	bool m_quit = false;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "SerialTuning.h"
+#include <system_error>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <cerrno>
+#include <boost/log/trivial.hpp>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+// termios2 and BOTHER, not to be mixed with <termios.h>
+#include <asm/termbits.h>
+
+namespace
+{
+struct StandardRate
+{
+	int rate;
+	speed_t code;
+};
+
+const StandardRate STANDARD_RATES[] = {
+	{ 1200, B1200 }, { 2400, B2400 }, { 4800, B4800 }, { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 },
+	{ 57600, B57600 }, { 115200, B115200 }, { 230400, B230400 }, { 460800, B460800 }, { 500000, B500000 },
+	{ 576000, B576000 }, { 921600, B921600 }, { 1000000, B1000000 }, { 1500000, B1500000 }, { 2000000, B2000000 },
+};
+
+const StandardRate* findStandardRate(int rate)
+{
+	auto it = std::find_if(std::begin(STANDARD_RATES), std::end(STANDARD_RATES), [=](const StandardRate& r) { return r.rate == rate; });
+	return it != std::end(STANDARD_RATES) ? it : nullptr;
+}
+
+void check(int rv, const char* what)
+{
+	if (rv != 0)
+		throw std::system_error(errno, std::generic_category(), what);
+}
+}
+
+bool SerialTuning::isStandardBaudRate(int rate)
+{
+	return findStandardRate(rate) != nullptr;
+}
+
+int SerialTuning::baudRate(int fd)
+{
+	struct termios2 tio;
+
+	if (::ioctl(fd, TCGETS2, &tio) != 0)
+		return 0;
+	return tio.c_ospeed;
+}
+
+SerialTuning::Result SerialTuning::apply(int fd, int baudRate) const
+{
+	Result result;
+	struct termios2 tio;
+
+	check(::ioctl(fd, TCGETS2, &tio), "TCGETS2");
+
+	// A changed rate makes cdc_acm send SET_LINE_CODING to the device, which some boards react to
+	if (!usbCdc)
+	{
+		const StandardRate* standard = findStandardRate(baudRate);
+
+		tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+		if (standard)
+			tio.c_cflag |= standard->code;
+		else
+		{
+			tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+			result.customBaudRate = true;
+		}
+		tio.c_ispeed = tio.c_ospeed = baudRate;
+	}
+
+	tio.c_cc[VMIN] = std::clamp(vmin, 0, 255);
+	tio.c_cc[VTIME] = std::clamp(vtime, 0, 255);
+
+	check(::ioctl(fd, TCSETS2, &tio), "TCSETS2");
+
+	if (!usbCdc && ::ioctl(fd, TCGETS2, &tio) == 0)
+	{
+		result.baudRate = tio.c_ospeed;
+
+		if (result.baudRate != baudRate)
+			BOOST_LOG_TRIVIAL(warning) << "Baud rate " << baudRate << " not supported by the driver, got " << result.baudRate;
+	}
+
+	if (lowLatency && !usbCdc)
+	{
+		struct serial_struct serial;
+
+		// ptys and CDC-ACM ports don't have it
+		if (::ioctl(fd, TIOCGSERIAL, &serial) == 0)
+		{
+			serial.flags |= ASYNC_LOW_LATENCY;
+
+			if (::ioctl(fd, TIOCSSERIAL, &serial) == 0)
+				result.lowLatency = true;
+		}
+
+		if (!result.lowLatency)
+			BOOST_LOG_TRIVIAL(debug) << "Serial port doesn't support low latency mode: " << std::strerror(errno);
+	}
+
+	return result;
+}
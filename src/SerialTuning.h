@@ -0,0 +1,42 @@
+#ifndef _SERIALTUNING_H
+#define _SERIALTUNING_H
+#include <string>
+
+// Linux serial port settings beyond what boost::asio::serial_port offers
+struct SerialTuning
+{
+	// ASYNC_LOW_LATENCY through TIOCSSERIAL, e.g. a 1 ms latency timer instead of 16 ms on FTDI adapters
+	bool lowLatency = true;
+	// Bytes (VMIN) or tenths of a second (VTIME) a blocking read waits for.
+	// asio doesn't block, it reads whatever has arrived as soon as there's something.
+	int vmin = 1, vtime = 0;
+	// For native USB (CDC-ACM) ports: there's no UART behind them, so the baud rate and
+	// ASYNC_LOW_LATENCY are left alone and the port only gets the raw mode asio sets up
+	bool usbCdc = false;
+
+	// What apply() managed to set
+	struct Result
+	{
+		bool lowLatency = false;
+		// Not one of the Bnnn rates, set through termios2 and BOTHER
+		bool customBaudRate = false;
+		// As read back from the driver, 0 if not set
+		int baudRate = 0;
+	};
+
+	// Any baud rate the driver supports, 250000 or 500000 included.
+	// Throws std::system_error if the port cannot be configured, failing to switch to low latency is only logged.
+	Result apply(int fd, int baudRate) const;
+
+	static bool isStandardBaudRate(int rate);
+	// The output rate fd is set to, 0 if it can't be read. On a pty's master side, the slave's.
+	static int baudRate(int fd);
+
+	bool operator==(const SerialTuning& that) const
+	{
+		return lowLatency == that.lowLatency && vmin == that.vmin && vtime == that.vtime && usbCdc == that.usbCdc;
+	}
+	bool operator!=(const SerialTuning& that) const { return !(*this == that); }
+};
+
+#endif
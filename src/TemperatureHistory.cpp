@@ -0,0 +1,248 @@
+#include "TemperatureHistory.h"
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+struct TierSpec
+{
+	std::chrono::milliseconds resolution;
+	size_t capacity;
+};
+
+// 30 minutes per second, 3 hours per 10 seconds, 24 hours per minute
+const TierSpec TIERS[] = {
+	{ std::chrono::seconds(1), 1800 },
+	{ std::chrono::seconds(10), 1080 },
+	{ std::chrono::minutes(1), 1440 },
+};
+
+const float NOT_PRESENT = std::numeric_limits<float>::quiet_NaN();
+
+int64_t toMillis(TemperatureHistory::clock::time_point when)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(when.time_since_epoch()).count();
+}
+}
+
+TemperatureHistory::TemperatureHistory()
+{
+	for (const TierSpec& spec : TIERS)
+		m_tiers.emplace_back(spec.resolution, spec.capacity);
+}
+
+void TemperatureHistory::record(clock::time_point when, const TemperatureReport& report)
+{
+	const int64_t millis = toMillis(when);
+
+	for (Tier& tier : m_tiers)
+		tier.add(millis, report);
+}
+
+void TemperatureHistory::clear()
+{
+	for (Tier& tier : m_tiers)
+		tier.clear();
+}
+
+std::chrono::seconds TemperatureHistory::retention()
+{
+	const TierSpec& last = TIERS[std::size(TIERS) - 1];
+	return std::chrono::duration_cast<std::chrono::seconds>(last.resolution * last.capacity);
+}
+
+TemperatureHistory::Series TemperatureHistory::query(clock::time_point from, clock::time_point to, size_t maxPoints) const
+{
+	const int64_t start = toMillis(from), end = toMillis(to);
+	const Tier* tier = &m_tiers.back();
+	Series series;
+
+	for (const Tier& candidate : m_tiers)
+	{
+		if (candidate.coverage() <= start)
+		{
+			tier = &candidate;
+			break;
+		}
+	}
+
+	tier->copy(start, end, series);
+
+	if (maxPoints == 0 || series.size() <= maxPoints)
+		return series;
+
+	// Average groups of consecutive samples
+	const size_t group = (series.size() + maxPoints - 1) / maxPoints;
+	Series reduced;
+
+	reduced.sensors = series.sensors;
+
+	for (size_t first = 0; first < series.size(); first += group)
+	{
+		const size_t last = std::min(first + group, series.size());
+		clock::duration timeSum(0);
+
+		for (size_t i = first; i < last; i++)
+			timeSum += series.when[i] - series.when[first];
+		reduced.when.push_back(series.when[first] + timeSum / (last - first));
+
+		for (int sensor = 0; sensor < TemperatureReport::SENSORS; sensor++)
+		{
+			if (!series.has(sensor))
+				continue;
+
+			float sum = 0, target = NOT_PRESENT;
+			int count = 0;
+
+			for (size_t i = first; i < last; i++)
+			{
+				if (std::isnan(series.current[sensor][i]))
+					continue;
+
+				sum += series.current[sensor][i];
+				target = series.target[sensor][i];
+				count++;
+			}
+
+			reduced.current[sensor].push_back(count ? sum / count : NOT_PRESENT);
+			reduced.target[sensor].push_back(target);
+		}
+	}
+
+	return reduced;
+}
+
+TemperatureHistory::Tier::Tier(std::chrono::milliseconds resolution, size_t capacity)
+: m_resolution(resolution.count()), m_capacity(capacity), m_times(capacity)
+{
+	clear();
+}
+
+void TemperatureHistory::Tier::clear()
+{
+	for (int i = 0; i < TemperatureReport::SENSORS; i++)
+	{
+		m_current[i].clear();
+		m_current[i].shrink_to_fit();
+		m_target[i].clear();
+		m_target[i].shrink_to_fit();
+	}
+
+	m_head = m_size = 0;
+	m_samples = 0;
+	m_timeSum = 0;
+	m_currentSum.fill(0);
+	m_lastTarget.fill(NOT_PRESENT);
+	m_readings.fill(0);
+}
+
+void TemperatureHistory::Tier::add(int64_t when, const TemperatureReport& report)
+{
+	const int64_t bucket = when - (when % m_resolution + m_resolution) % m_resolution;
+
+	if (m_samples > 0 && bucket != m_bucket)
+		flush();
+
+	m_bucket = bucket;
+	m_timeSum += when - bucket;
+	m_samples++;
+
+	for (int i = 0; i < TemperatureReport::SENSORS; i++)
+	{
+		if (!report.has(i))
+			continue;
+
+		if (m_current[i].empty())
+			addColumn(i);
+
+		m_currentSum[i] += report.readings[i].current;
+		if (report.hasTarget(i))
+			m_lastTarget[i] = report.readings[i].target;
+		m_readings[i]++;
+	}
+}
+
+void TemperatureHistory::Tier::flush()
+{
+	m_times[m_head] = m_bucket + m_timeSum / m_samples;
+
+	for (int i = 0; i < TemperatureReport::SENSORS; i++)
+	{
+		if (m_current[i].empty())
+			continue;
+
+		m_current[i][m_head] = m_readings[i] ? m_currentSum[i] / m_readings[i] : NOT_PRESENT;
+		m_target[i][m_head] = m_readings[i] ? m_lastTarget[i] : NOT_PRESENT;
+	}
+
+	m_head = (m_head + 1) % m_capacity;
+	m_size = std::min(m_size + 1, m_capacity);
+
+	// The target carries over, wait lines don't repeat it
+	m_samples = 0;
+	m_timeSum = 0;
+	m_currentSum.fill(0);
+	m_readings.fill(0);
+}
+
+void TemperatureHistory::Tier::addColumn(int sensor)
+{
+	m_current[sensor].assign(m_capacity, NOT_PRESENT);
+	m_target[sensor].assign(m_capacity, NOT_PRESENT);
+}
+
+int64_t TemperatureHistory::Tier::coverage() const
+{
+	if (m_size < m_capacity)
+		return std::numeric_limits<int64_t>::min();
+	return m_times[slot(0)];
+}
+
+void TemperatureHistory::Tier::copy(int64_t from, int64_t to, Series& series) const
+{
+	auto append = [&](int64_t when, auto current, auto target) {
+		series.when.push_back(clock::time_point(std::chrono::milliseconds(when)));
+
+		for (int i = 0; i < TemperatureReport::SENSORS; i++)
+		{
+			if (m_current[i].empty())
+				continue;
+
+			series.current[i].push_back(current(i));
+			series.target[i].push_back(target(i));
+		}
+	};
+
+	for (int i = 0; i < TemperatureReport::SENSORS; i++)
+	{
+		if (!m_current[i].empty())
+			series.sensors |= 1u << i;
+	}
+
+	for (size_t index = 0; index < m_size; index++)
+	{
+		const size_t s = slot(index);
+
+		if (m_times[s] < from)
+			continue;
+		if (m_times[s] > to)
+			return;
+
+		append(m_times[s], [&](int i) { return m_current[i][s]; }, [&](int i) { return m_target[i][s]; });
+	}
+
+	// The bucket still being filled, as it is so far
+	if (m_samples > 0)
+	{
+		const int64_t when = m_bucket + m_timeSum / m_samples;
+
+		if (when >= from && when <= to)
+		{
+			append(when,
+				[&](int i) { return m_readings[i] ? m_currentSum[i] / m_readings[i] : NOT_PRESENT; },
+				[&](int i) { return m_readings[i] ? m_lastTarget[i] : NOT_PRESENT; });
+		}
+	}
+}
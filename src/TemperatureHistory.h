@@ -0,0 +1,76 @@
+#ifndef _TEMPERATUREHISTORY_H
+#define _TEMPERATUREHISTORY_H
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "TemperatureReport.h"
+
+// Temperature history in fixed-capacity ring buffers, one column per sensor. Every report goes into
+// several tiers averaging it over longer periods, so that hours can be kept in a bounded amount of memory.
+// Not thread safe.
+class TemperatureHistory
+{
+public:
+	typedef std::chrono::system_clock clock;
+
+	TemperatureHistory();
+
+	void record(clock::time_point when, const TemperatureReport& report);
+	void clear();
+
+	// Samples in columns, NaN where a sensor had no reading
+	struct Series
+	{
+		std::vector<clock::time_point> when;
+		// Bit per sensor with a column
+		uint32_t sensors = 0;
+		std::array<std::vector<float>, TemperatureReport::SENSORS> current, target;
+
+		size_t size() const { return when.size(); }
+		bool has(int sensor) const { return sensors & (1u << sensor); }
+	};
+
+	// Samples between from and to, from the finest tier still reaching back to from.
+	// Consecutive samples are averaged together to return at most maxPoints, unless it is 0.
+	Series query(clock::time_point from, clock::time_point to, size_t maxPoints = 0) const;
+
+	// How far back the coarsest tier goes
+	static std::chrono::seconds retention();
+private:
+	class Tier
+	{
+	public:
+		Tier(std::chrono::milliseconds resolution, size_t capacity);
+
+		void add(int64_t when, const TemperatureReport& report);
+		void clear();
+
+		// Oldest sample kept, or INT64_MIN if nothing was dropped yet
+		int64_t coverage() const;
+		void copy(int64_t from, int64_t to, Series& series) const;
+	private:
+		// Moves the pending bucket into the ring
+		void flush();
+		void addColumn(int sensor);
+		size_t slot(size_t index) const { return (m_head + m_capacity - m_size + index) % m_capacity; }
+	private:
+		const int64_t m_resolution;
+		const size_t m_capacity;
+
+		// Milliseconds since the epoch, average time of the samples in a bucket
+		std::vector<int64_t> m_times;
+		std::array<std::vector<float>, TemperatureReport::SENSORS> m_current, m_target;
+		size_t m_head = 0, m_size = 0;
+
+		// Bucket being filled
+		int64_t m_bucket = 0, m_timeSum = 0;
+		int m_samples = 0;
+		std::array<float, TemperatureReport::SENSORS> m_currentSum, m_lastTarget;
+		std::array<int, TemperatureReport::SENSORS> m_readings;
+	};
+
+	std::vector<Tier> m_tiers;
+};
+
+#endif
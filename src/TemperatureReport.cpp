@@ -0,0 +1,165 @@
+#include "TemperatureReport.h"
+#include <charconv>
+
+// Sensor for a key like "T", "T1", "B" or "C@" (power), -1 if unknown
+static int sensorForKey(std::string_view key, bool& power)
+{
+	auto isTool = [](char c) { return c >= '0' && c < '0' + TemperatureReport::MAX_TOOLS; };
+
+	power = false;
+
+	switch (key.length())
+	{
+		case 1:
+			switch (key[0])
+			{
+				case 'T':
+					return TemperatureReport::Tool0;
+				case 'B':
+					return TemperatureReport::Bed;
+				case 'C':
+					return TemperatureReport::Chamber;
+				case 'P':
+					return TemperatureReport::Probe;
+				case '@':
+					// The active tool
+					power = true;
+					return TemperatureReport::Tool0;
+			}
+			break;
+		case 2:
+			if (key[0] == 'T' && isTool(key[1]))
+				return TemperatureReport::Tool0 + (key[1] - '0');
+
+			power = true;
+
+			if (key[0] == '@' && isTool(key[1]))
+				return TemperatureReport::Tool0 + (key[1] - '0');
+			if (key == "B@")
+				return TemperatureReport::Bed;
+			if (key == "C@")
+				return TemperatureReport::Chamber;
+			break;
+	}
+
+	return -1;
+}
+
+template<typename T>
+static bool parseNumber(std::string_view text, T& value)
+{
+	return std::from_chars(text.data(), text.data() + text.length(), value).ec == std::errc();
+}
+
+bool TemperatureReport::parse(std::string_view line)
+{
+	// Sensor whose target may follow as the next token ("T:210.00 /210.00")
+	int last = -1;
+	size_t pos = 0;
+
+	readings = {};
+	present = targets = 0;
+
+	while (pos < line.length())
+	{
+		while (pos < line.length() && line[pos] == ' ')
+			pos++;
+
+		const size_t end = std::min(line.find(' ', pos), line.length());
+		const std::string_view token = line.substr(pos, end - pos);
+
+		pos = end;
+
+		if (token.empty())
+			continue;
+
+		if (token[0] == '/')
+		{
+			if (last != -1 && parseNumber(token.substr(1), readings[last].target))
+				targets |= 1u << last;
+			last = -1;
+			continue;
+		}
+
+		last = -1;
+
+		const size_t colon = token.find(':');
+		if (colon == std::string_view::npos)
+			continue;
+
+		bool power;
+		const int sensor = sensorForKey(token.substr(0, colon), power);
+		std::string_view value = token.substr(colon + 1);
+
+		if (sensor == -1 || value.empty())
+			continue;
+
+		Reading& reading = readings[sensor];
+
+		if (power)
+		{
+			parseNumber(value, reading.power);
+			continue;
+		}
+
+		// "T:210.00/210.00" without the space
+		const size_t slash = value.find('/');
+
+		if (!parseNumber(value.substr(0, slash), reading.current))
+			continue;
+
+		present |= 1u << sensor;
+
+		if (slash == std::string_view::npos)
+			last = sensor;
+		else if (parseNumber(value.substr(slash + 1), reading.target))
+			targets |= 1u << sensor;
+	}
+
+	return present != 0;
+}
+
+void TemperatureReport::merge(const TemperatureReport& report)
+{
+	for (int i = 0; i < SENSORS; i++)
+	{
+		if (!report.has(i))
+			continue;
+
+		readings[i].current = report.readings[i].current;
+
+		if (report.hasTarget(i))
+			readings[i].target = report.readings[i].target;
+
+		if (report.readings[i].power != -1)
+			readings[i].power = report.readings[i].power;
+	}
+
+	present |= report.present;
+	targets |= report.targets;
+}
+
+uint32_t TemperatureReport::changes(const TemperatureReport& report) const
+{
+	uint32_t mask = 0;
+
+	for (int i = 0; i < SENSORS; i++)
+	{
+		if (!report.has(i))
+			continue;
+
+		if (!has(i) || readings[i].current != report.readings[i].current)
+			mask |= CURRENT_CHANGED << (2 * i);
+		if (report.hasTarget(i) && (!hasTarget(i) || readings[i].target != report.readings[i].target))
+			mask |= TARGET_CHANGED << (2 * i);
+	}
+
+	return mask;
+}
+
+const char* TemperatureReport::sensorName(int sensor)
+{
+	static const char* const names[SENSORS] = { "T", "T1", "T2", "T3", "T4", "T5", "T6", "T7", "B", "C", "P" };
+
+	return (sensor >= 0 && sensor < SENSORS) ? names[sensor] : "";
+}
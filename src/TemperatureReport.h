@@ -0,0 +1,52 @@
+#ifndef _TEMPERATUREREPORT_H
+#define _TEMPERATUREREPORT_H
+#include <array>
+#include <string_view>
+#include <cstdint>
+
+// Temperatures from an M105 reply, an M155 autoreport or an M109/M190 wait line, e.g.
+// "ok T:210.00 /210.00 B:60.00 /60.00 T0:210.00 /210.00 T1:25.00 /0.00 @:127 B@:0 @0:127 @1:0".
+// Parsed in a single pass without allocating, into a fixed layout.
+struct TemperatureReport
+{
+	static constexpr int MAX_TOOLS = 8;
+
+	// Indexes into readings
+	enum Sensor
+	{
+		Tool0 = 0, // "T:" is the active tool, stored here unless the tools are listed as "T0:", "T1:"...
+		Bed = MAX_TOOLS,
+		Chamber,
+		Probe,
+		SENSORS
+	};
+
+	struct Reading
+	{
+		float current = 0, target = 0;
+		// Heater PWM as reported ("@:", "B@:", "C@:"), -1 if not reported
+		int power = -1;
+	};
+
+	std::array<Reading, SENSORS> readings;
+	// Bit per sensor with a reading, and with a target in it (wait lines during M109/M190 have none)
+	uint32_t present = 0, targets = 0;
+
+	// Returns false if there are no temperatures in line. Values not understood are skipped.
+	bool parse(std::string_view line);
+
+	// Takes over the readings present in report, keeps the others
+	void merge(const TemperatureReport& report);
+
+	// Two bits per sensor, CURRENT_CHANGED and TARGET_CHANGED shifted by 2 * sensor,
+	// for readings present in report that differ from this one (or aren't present here)
+	uint32_t changes(const TemperatureReport& report) const;
+	static constexpr uint32_t CURRENT_CHANGED = 1, TARGET_CHANGED = 2;
+
+	bool has(int sensor) const { return present & (1u << sensor); }
+	bool hasTarget(int sensor) const { return targets & (1u << sensor); }
+	// "T", "T1".."T7", "B", "C", "P", as used in Printer's temperature maps
+	static const char* sensorName(int sensor);
+};
+
+#endif
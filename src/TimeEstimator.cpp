@@ -0,0 +1,458 @@
+#include "TimeEstimator.h"
+#include "GCodeReader.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <cmath>
+#include <cstdio>
+
+// Moves planned together, the firmware's planner buffer is usually 16 blocks long
+static constexpr size_t PLAN_WINDOW = 16;
+// A table entry is recorded for every SAMPLE_LINES command lines
+static constexpr size_t SAMPLE_LINES = 16;
+// mm/s, if the file doesn't set a feedrate before moving
+static constexpr double DEFAULT_FEEDRATE = 25;
+
+static constexpr uint32_t TABLE_MAGIC = 0x31545044; // "DPT1"
+
+struct TimeTableHeader
+{
+	uint32_t magic;
+	uint32_t samples;
+	uint64_t fileSize;
+	int64_t modifiedTime;
+	uint32_t flags;
+	uint32_t reserved;
+};
+
+static constexpr uint32_t FLAG_PROGRESS_COMMANDS = 1;
+
+void TimeTable::add(uint64_t offset, float time)
+{
+	if (!m_offsets.empty() && offset <= m_offsets.back())
+		return;
+
+	m_offsets.push_back(offset);
+	m_times.push_back(time);
+}
+
+double TimeTable::timeAt(uint64_t offset) const
+{
+	auto it = std::lower_bound(m_offsets.begin(), m_offsets.end(), offset);
+
+	if (it == m_offsets.end())
+		return totalTime();
+
+	const size_t i = it - m_offsets.begin();
+	const uint64_t prevOffset = (i > 0) ? m_offsets[i - 1] : 0;
+	const double prevTime = (i > 0) ? m_times[i - 1] : 0;
+
+	if (offset <= prevOffset)
+		return prevTime;
+
+	return prevTime + (m_times[i] - prevTime) * double(offset - prevOffset) / double(m_offsets[i] - prevOffset);
+}
+
+bool TimeTable::load(const std::string& path, uint64_t fileSize, int64_t modifiedTime)
+{
+	std::ifstream file(path, std::ios::binary);
+	TimeTableHeader header;
+
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+
+	if (header.magic != TABLE_MAGIC || header.fileSize != fileSize || header.modifiedTime != modifiedTime
+		|| header.samples > fileSize)
+		return false;
+
+	std::vector<uint64_t> offsets(header.samples);
+	std::vector<float> times(header.samples);
+
+	file.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+	file.read(reinterpret_cast<char*>(times.data()), times.size() * sizeof(float));
+
+	if (!file)
+		return false;
+
+	m_offsets = std::move(offsets);
+	m_times = std::move(times);
+	m_hasProgressCommands = (header.flags & FLAG_PROGRESS_COMMANDS) != 0;
+	return true;
+}
+
+void TimeTable::save(const std::string& path, uint64_t fileSize, int64_t modifiedTime) const
+{
+	// Written under a temporary name, so that a half-written table is never picked up
+	const std::string tempPath = path + ".tmp";
+	std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+	TimeTableHeader header = { TABLE_MAGIC, uint32_t(m_offsets.size()), fileSize, modifiedTime,
+		m_hasProgressCommands ? FLAG_PROGRESS_COMMANDS : 0, 0 };
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(m_offsets.data()), m_offsets.size() * sizeof(uint64_t));
+	file.write(reinterpret_cast<const char*>(m_times.data()), m_times.size() * sizeof(float));
+	file.close();
+
+	if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0)
+	{
+		std::remove(tempPath.c_str());
+		throw std::runtime_error("Cannot write the time table");
+	}
+}
+
+TimeEstimator::TimeEstimator(TimeTable& table)
+: m_table(table)
+{
+	m_blocks.reserve(2 * PLAN_WINDOW);
+}
+
+bool TimeEstimator::estimate(const GCodeReader& reader, TimeTable& table, const std::atomic<bool>* cancel)
+{
+	TimeEstimator estimator(table);
+	bool cancelled = false;
+
+	reader.forEachLine(0, reader.size(), [&](std::string_view line, size_t offset) {
+		if (cancel && cancel->load(std::memory_order_relaxed))
+		{
+			cancelled = true;
+			return false;
+		}
+
+		const uint64_t endOffset = std::min<uint64_t>(offset + line.length() + 1, reader.size());
+
+		line = GCodeReader::stripLine(line);
+		if (!line.empty())
+			estimator.line(line, endOffset);
+		return true;
+	});
+
+	if (cancelled)
+		return false;
+
+	estimator.finish(reader.size());
+	return true;
+}
+
+void TimeEstimator::line(std::string_view line, uint64_t endOffset)
+{
+	m_lines++;
+
+	if (line.length() < 2)
+		return;
+
+	const std::string_view code = GCodeState::commandCode(line);
+
+	if (code == "G0" || code == "G1" || code == "G2" || code == "G3")
+	{
+		const double x = m_state.x, y = m_state.y, z = m_state.z, e = m_state.e;
+
+		m_state.apply(line);
+
+		const double delta[4] = { m_state.x - x, m_state.y - y, m_state.z - z, m_state.e - e };
+		double arcLength = 0;
+
+		if (code[1] == '2' || code[1] == '3')
+		{
+			double i = 0, j = 0;
+
+			GCodeState::forEachParameter(line, [&](char letter, double v) {
+				if (letter == 'I')
+					i = v;
+				else if (letter == 'J')
+					j = v;
+				return true;
+			});
+
+			// Without I and J (the R form) the chord is used
+			if (i != 0 || j != 0)
+			{
+				const double radius = std::hypot(i, j);
+				const double startAngle = std::atan2(-j, -i);
+				const double endAngle = std::atan2(m_state.y - (y + j), m_state.x - (x + i));
+				double angle = endAngle - startAngle;
+
+				// Clockwise for G2, same start and end point is a full circle
+				if (code[1] == '2' && angle >= 0)
+					angle -= 2 * M_PI;
+				else if (code[1] == '3' && angle <= 0)
+					angle += 2 * M_PI;
+
+				arcLength = std::hypot(radius * angle, delta[2]);
+			}
+		}
+
+		addMove(delta, arcLength, endOffset);
+	}
+	else if (code == "G4")
+	{
+		double seconds = 0, value;
+
+		if (GCodeState::parameter(line, 'P', value))
+			seconds = value / 1000;
+		else if (GCodeState::parameter(line, 'S', value))
+			seconds = value;
+
+		if (seconds > 0)
+			addDwell(seconds, endOffset);
+	}
+	else if (code == "M201" || code == "M203" || code == "M204" || code == "M205")
+		setLimits(code, line);
+	else if (code == "M73")
+		m_table.setHasProgressCommands();
+	else
+		m_state.apply(line);
+}
+
+void TimeEstimator::setLimits(std::string_view code, std::string_view line)
+{
+	GCodeState::forEachParameter(line, [&](char letter, double v) {
+		int axis = -1;
+
+		switch (letter)
+		{
+			case 'X': axis = 0; break;
+			case 'Y': axis = 1; break;
+			case 'Z': axis = 2; break;
+			case 'E': axis = 3; break;
+		}
+
+		// Zero jerk is a valid setting
+		if (v < 0 || (v == 0 && code != "M205"))
+			return true;
+
+		if (code == "M201" && axis != -1)
+			m_limits.maxAcceleration[axis] = v;
+		else if (code == "M203" && axis != -1)
+			m_limits.maxFeedrate[axis] = v;
+		else if (code == "M204")
+		{
+			if (letter == 'S')
+				m_limits.acceleration = m_limits.travelAcceleration = v;
+			else if (letter == 'P')
+				m_limits.acceleration = v;
+			else if (letter == 'R')
+				m_limits.retractAcceleration = v;
+			else if (letter == 'T')
+				m_limits.travelAcceleration = v;
+		}
+		else if (code == "M205")
+		{
+			if (axis != -1)
+				m_limits.jerk[axis] = v;
+			else if (letter == 'J')
+				m_limits.junctionDeviation = v;
+		}
+		return true;
+	});
+}
+
+void TimeEstimator::addMove(const double delta[4], double arcLength, uint64_t endOffset)
+{
+	const double xyzLength = std::sqrt(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+	const double length = (arcLength > 0) ? arcLength : ((xyzLength > 0) ? xyzLength : std::fabs(delta[3]));
+
+	if (length < 1e-6)
+		return;
+
+	double unit[4], speed = (m_state.feedrate > 0) ? (m_state.feedrate / 60) : DEFAULT_FEEDRATE;
+	double acceleration;
+
+	if (xyzLength == 0)
+		acceleration = m_limits.retractAcceleration;
+	else if (delta[3] == 0)
+		acceleration = m_limits.travelAcceleration;
+	else
+		acceleration = m_limits.acceleration;
+
+	for (int i = 0; i < 4; i++)
+	{
+		unit[i] = delta[i] / length;
+
+		const double component = std::fabs(unit[i]);
+
+		if (component * speed > m_limits.maxFeedrate[i])
+			speed = m_limits.maxFeedrate[i] / component;
+		if (component * acceleration > m_limits.maxAcceleration[i])
+			acceleration = m_limits.maxAcceleration[i] / component;
+	}
+
+	Block block;
+	block.length = length;
+	block.nominalSpeed = speed;
+	block.acceleration = acceleration;
+	block.maxEntrySpeed = (m_previousSpeed > 0) ? junctionSpeed(unit, speed, acceleration) : startSpeed(unit, speed);
+	block.entrySpeed = block.maxEntrySpeed;
+	block.dwell = 0;
+	block.endOffset = endOffset;
+	block.line = m_lines;
+
+	std::copy(unit, unit + 4, m_previousUnit);
+	m_previousSpeed = speed;
+
+	m_blocks.push_back(block);
+
+	if (m_blocks.size() == 2 * PLAN_WINDOW)
+	{
+		plan();
+		emit(PLAN_WINDOW);
+	}
+}
+
+void TimeEstimator::addDwell(double seconds, uint64_t endOffset)
+{
+	Block block = {};
+
+	block.dwell = seconds;
+	block.endOffset = endOffset;
+	block.line = m_lines;
+
+	// The printer stops before dwelling
+	m_previousSpeed = 0;
+	m_blocks.push_back(block);
+
+	if (m_blocks.size() == 2 * PLAN_WINDOW)
+	{
+		plan();
+		emit(PLAN_WINDOW);
+	}
+}
+
+// Highest speed at which the printer may start moving along unit from standstill
+double TimeEstimator::startSpeed(const double unit[4], double nominalSpeed) const
+{
+	double speed = nominalSpeed;
+
+	for (int i = 0; i < 4; i++)
+	{
+		const double component = std::fabs(unit[i]);
+
+		if (component * speed > m_limits.jerk[i])
+			speed = m_limits.jerk[i] / component;
+	}
+
+	return speed;
+}
+
+// Highest speed for the junction between the previous move and the one along unit
+double TimeEstimator::junctionSpeed(const double unit[4], double nominalSpeed, double acceleration) const
+{
+	double speed = std::min(m_previousSpeed, nominalSpeed);
+
+	const double previousXYZ = std::sqrt(m_previousUnit[0] * m_previousUnit[0] + m_previousUnit[1] * m_previousUnit[1]
+		+ m_previousUnit[2] * m_previousUnit[2]);
+	const double currentXYZ = std::sqrt(unit[0] * unit[0] + unit[1] * unit[1] + unit[2] * unit[2]);
+
+	if (m_limits.junctionDeviation > 0 && previousXYZ > 0 && currentXYZ > 0)
+	{
+		// Speed at which the head would pass an arc deviating junctionDeviation from the corner,
+		// with centripetal acceleration equal to the acceleration limit
+		double cosTheta = -(m_previousUnit[0] * unit[0] + m_previousUnit[1] * unit[1] + m_previousUnit[2] * unit[2])
+			/ (previousXYZ * currentXYZ);
+
+		if (cosTheta > 0.999999)
+			return std::min(speed, startSpeed(unit, nominalSpeed)); // Full reversal
+
+		if (cosTheta < -0.999999)
+			return speed; // Straight line
+
+		const double sinHalfTheta = std::sqrt(0.5 * (1 - cosTheta));
+
+		return std::min(speed, std::sqrt(acceleration * m_limits.junctionDeviation * sinHalfTheta / (1 - sinHalfTheta)));
+	}
+
+	// Classic jerk: the instantaneous speed change of every axis is limited
+	double factor = 1;
+
+	for (int i = 0; i < 4; i++)
+	{
+		const double jerk = std::fabs(m_previousUnit[i] - unit[i]) * speed;
+
+		if (jerk > m_limits.jerk[i])
+			factor = std::min(factor, m_limits.jerk[i] / jerk);
+	}
+
+	return speed * factor;
+}
+
+// Entry speeds of the planned blocks, the printer stops after the last one.
+// The first block's entry speed is already settled by the previous plan and may only go down.
+void TimeEstimator::plan()
+{
+	double nextEntry = 0;
+
+	// Backward pass: each block must be able to decelerate to the next one's entry speed
+	for (size_t i = m_blocks.size(); i-- > 0; )
+	{
+		Block& block = m_blocks[i];
+
+		if (block.dwell > 0)
+			block.entrySpeed = 0;
+		else
+		{
+			const double limit = (i == 0) ? block.entrySpeed : block.maxEntrySpeed;
+			block.entrySpeed = std::min(limit, std::sqrt(nextEntry * nextEntry + 2 * block.acceleration * block.length));
+		}
+
+		nextEntry = block.entrySpeed;
+	}
+
+	// Forward pass: each block must be able to accelerate to the next one's entry speed.
+	// Moves after a dwell start from standstill.
+	for (size_t i = 0; i + 1 < m_blocks.size(); i++)
+	{
+		const Block& block = m_blocks[i];
+
+		if (block.dwell > 0)
+			continue;
+
+		Block& next = m_blocks[i + 1];
+		next.entrySpeed = std::min(next.entrySpeed, std::sqrt(block.entrySpeed * block.entrySpeed + 2 * block.acceleration * block.length));
+	}
+}
+
+void TimeEstimator::emit(size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const Block& block = m_blocks[i];
+		const double exitSpeed = (i + 1 < m_blocks.size()) ? m_blocks[i + 1].entrySpeed : 0;
+
+		m_time += blockTime(block, exitSpeed);
+
+		if (block.line >= m_nextSample)
+		{
+			m_table.add(block.endOffset, m_time);
+			m_nextSample = block.line + SAMPLE_LINES;
+		}
+	}
+
+	m_blocks.erase(m_blocks.begin(), m_blocks.begin() + count);
+}
+
+void TimeEstimator::finish(uint64_t fileSize)
+{
+	plan();
+	emit(m_blocks.size());
+
+	m_table.add(fileSize, m_time);
+	m_previousSpeed = 0;
+}
+
+// Duration of a trapezoidal (or triangular, if the block is too short to reach its nominal speed) speed profile
+double TimeEstimator::blockTime(const Block& block, double exitSpeed)
+{
+	if (block.dwell > 0)
+		return block.dwell;
+
+	const double a = block.acceleration;
+	const double v0 = block.entrySpeed, v1 = exitSpeed;
+	const double vn = std::max(block.nominalSpeed, std::max(v0, v1));
+	const double accelDistance = (vn * vn - v0 * v0) / (2 * a);
+	const double decelDistance = (vn * vn - v1 * v1) / (2 * a);
+
+	if (accelDistance + decelDistance <= block.length)
+		return (vn - v0) / a + (vn - v1) / a + (block.length - accelDistance - decelDistance) / vn;
+
+	const double peak = std::max(std::sqrt((2 * a * block.length + v0 * v0 + v1 * v1) / 2), std::max(v0, v1));
+	return (peak - v0) / a + (peak - v1) / a;
+}
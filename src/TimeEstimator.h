@@ -0,0 +1,104 @@
+#ifndef _TIMEESTIMATOR_H
+#define _TIMEESTIMATOR_H
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "GCodeState.h"
+
+class GCodeReader;
+
+// Estimated cumulative print time along a G-code file.
+// Sampled every few command lines, times in between are interpolated by file offset.
+class TimeTable
+{
+public:
+	void add(uint64_t offset, float time);
+	bool empty() const { return m_offsets.empty(); }
+	size_t samples() const { return m_offsets.size(); }
+
+	// Seconds needed to print everything before offset
+	double timeAt(uint64_t offset) const;
+	double totalTime() const { return m_times.empty() ? 0 : m_times.back(); }
+
+	// Whether the file reports its progress itself with M73
+	bool hasProgressCommands() const { return m_hasProgressCommands; }
+	void setHasProgressCommands() { m_hasProgressCommands = true; }
+
+	// Where the table for a G-code file is stored, next to the file
+	static std::string pathFor(const std::string& gcodePath) { return gcodePath + ".time"; }
+
+	// Size and modification time of the G-code file tell if a stored table is still valid.
+	// save() throws std::runtime_error.
+	bool load(const std::string& path, uint64_t fileSize, int64_t modifiedTime);
+	void save(const std::string& path, uint64_t fileSize, int64_t modifiedTime) const;
+private:
+	std::vector<uint64_t> m_offsets; // End of the sampled line
+	std::vector<float> m_times;
+	bool m_hasProgressCommands = false;
+};
+
+// Simulates the firmware's motion planner over a G-code file: trapezoidal speed profiles
+// with acceleration limits, junction speeds by classic jerk or junction deviation,
+// and a bounded look-ahead like the planner buffer of the firmware.
+class TimeEstimator
+{
+public:
+	// Axes are X, Y, Z, E. Changed by M201, M203, M204 and M205 in the file.
+	struct Limits
+	{
+		double maxFeedrate[4] = { 300, 300, 5, 25 }; // mm/s
+		double maxAcceleration[4] = { 3000, 3000, 100, 10000 }; // mm/s^2
+		double acceleration = 3000, retractAcceleration = 3000, travelAcceleration = 3000;
+		double jerk[4] = { 10, 10, 0.3, 5 }; // mm/s
+		double junctionDeviation = 0; // mm, the jerk limits are used if 0
+	};
+
+	TimeEstimator(TimeTable& table);
+
+	// Next stripped command line (see GCodeReader::stripLine()), ending at endOffset
+	void line(std::string_view line, uint64_t endOffset);
+	// Plans out the rest of the moves, the printer comes to a stop at the end
+	void finish(uint64_t fileSize);
+
+	double totalTime() const { return m_time; }
+
+	// Runs the whole file through an estimator, returns false if cancelled
+	static bool estimate(const GCodeReader& reader, TimeTable& table, const std::atomic<bool>* cancel = nullptr);
+private:
+	struct Block
+	{
+		double length; // mm
+		double nominalSpeed, maxEntrySpeed, entrySpeed; // mm/s
+		double acceleration; // mm/s^2
+		double dwell; // s, blocks for G4 don't move
+		uint64_t endOffset;
+		size_t line;
+	};
+
+	void addMove(const double delta[4], double arcLength, uint64_t endOffset);
+	void addDwell(double seconds, uint64_t endOffset);
+	void setLimits(std::string_view code, std::string_view line);
+	double junctionSpeed(const double unit[4], double nominalSpeed, double acceleration) const;
+	double startSpeed(const double unit[4], double nominalSpeed) const;
+	void plan();
+	void emit(size_t count);
+	static double blockTime(const Block& block, double exitSpeed);
+private:
+	TimeTable& m_table;
+	Limits m_limits;
+	GCodeState m_state;
+
+	// Planned together, only the first half gets executed before more moves are added
+	std::vector<Block> m_blocks;
+
+	// Previous move, zero speed after a stop
+	double m_previousUnit[4] = {};
+	double m_previousSpeed = 0;
+
+	double m_time = 0;
+	size_t m_lines = 0, m_nextSample = 0;
+};
+
+#endif
@@ -0,0 +1,766 @@
+#include "VirtualPrinter.h"
+#include "GCodeState.h"
+#include "SerialTuning.h"
+#include <boost/log/trivial.hpp>
+#include <stdexcept>
+#include <system_error>
+#include <charconv>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+static constexpr double AMBIENT_TEMPERATURE = 25;
+// M109/M190 are done once the temperature is this close to the target
+static constexpr double TEMPERATURE_WINDOW = 1;
+// While the printer isn't connected to the other side
+static constexpr std::chrono::milliseconds REOPEN_POLL_INTERVAL(100);
+// Lines printed from the SD card are executed in batches this long
+static constexpr std::chrono::milliseconds SD_TICK(10);
+// Longer lines can't be emergency commands
+static constexpr size_t MAX_EMERGENCY_LINE = 32;
+
+static bool isSdCommand(std::string_view code)
+{
+	return code == "M23" || code == "M24" || code == "M25" || code == "M26" || code == "M27" || code == "M28"
+		|| code == "M29" || code == "M524";
+}
+
+VirtualPrinter::Options VirtualPrinter::Options::parse(std::string_view spec)
+{
+	Options options;
+
+	while (!spec.empty())
+	{
+		const size_t comma = spec.find(',');
+		std::string_view item = spec.substr(0, comma);
+		spec = (comma == std::string_view::npos) ? std::string_view() : spec.substr(comma + 1);
+
+		if (item.empty())
+			continue;
+
+		const size_t eq = item.find('=');
+		if (eq == std::string_view::npos)
+			throw std::invalid_argument("Virtual printer option without a value: " + std::string(item));
+
+		const std::string_view key = item.substr(0, eq), text = item.substr(eq + 1);
+		double value;
+
+		auto result = std::from_chars(text.data(), text.data() + text.length(), value);
+		if (result.ec != std::errc() || result.ptr != text.data() + text.length() || value < 0)
+			throw std::invalid_argument("Invalid virtual printer option value: " + std::string(item));
+
+		if (key == "latency")
+			options.latency = std::chrono::microseconds(std::llround(value * 1000));
+		else if (key == "rx")
+			options.rxBufferSize = size_t(value);
+		else if (key == "checksum_errors")
+			options.checksumErrorRate = value;
+		else if (key == "errors")
+			options.errorRate = value;
+		else if (key == "tau")
+			options.thermalTimeConstant = value;
+		else if (key == "advanced_ok")
+			options.advancedOk = value != 0;
+		else if (key == "autoreport")
+			options.autoReport = value != 0;
+		else if (key == "sd")
+			options.sdCard = value != 0;
+		else if (key == "sd_line")
+			options.sdLineTime = std::chrono::microseconds(std::llround(value * 1000));
+		else if (key == "emergency_parser")
+			options.emergencyParser = value != 0;
+		else if (key == "meatpack")
+			options.meatPack = value != 0;
+		else if (key == "baud")
+			options.baudRate = int(value);
+		else if (key == "seed")
+			options.seed = (unsigned int) value;
+		else
+			throw std::invalid_argument("Unknown virtual printer option: " + std::string(key));
+	}
+
+	return options;
+}
+
+int VirtualPrinter::openPseudoTerminal(std::string& devicePath)
+{
+	int fd = ::posix_openpt(O_RDWR | O_NOCTTY);
+	char name[128];
+
+	if (fd < 0)
+		throw std::system_error(errno, std::generic_category(), "posix_openpt");
+
+	if (::grantpt(fd) != 0 || ::unlockpt(fd) != 0 || ::ptsname_r(fd, name, sizeof(name)) != 0)
+	{
+		int err = errno;
+		::close(fd);
+		throw std::system_error(err, std::generic_category(), "Cannot set up a pseudo terminal");
+	}
+
+	struct termios tos;
+	if (::tcgetattr(fd, &tos) == 0)
+	{
+		::cfmakeraw(&tos);
+		::tcsetattr(fd, TCSANOW, &tos);
+	}
+
+	devicePath = name;
+	return fd;
+}
+
+VirtualPrinter::VirtualPrinter(boost::asio::io_service& io, const Options& options)
+: m_options(options), m_master(io), m_timer(io), m_pollTimer(io), m_reportTimer(io), m_sdTimer(io), m_sdReportTimer(io), m_random(options.seed), m_lastThermalUpdate(std::chrono::steady_clock::now())
+{
+	m_master.assign(openPseudoTerminal(m_devicePath));
+
+	if (m_options.baudRate != 0)
+	{
+		const int fd = m_master.native_handle();
+		const int on = 1;
+		struct termios tos;
+
+		// With EXTPROC set on the slave side, every change to its settings is reported to a master
+		// in packet mode, not just flow control. The master's termios calls act on the slave side.
+		if (::tcgetattr(fd, &tos) == 0)
+		{
+			tos.c_lflag |= EXTPROC;
+			::tcsetattr(fd, TCSANOW, &tos);
+		}
+		if (::ioctl(fd, TIOCPKT, &on) != 0)
+			throw std::system_error(errno, std::generic_category(), "TIOCPKT");
+
+		m_packetMode = true;
+		m_peerBaudRate = SerialTuning::baudRate(fd);
+	}
+
+	BOOST_LOG_TRIVIAL(info) << "Virtual printer on " << m_devicePath;
+
+	doRead();
+}
+
+VirtualPrinter::~VirtualPrinter()
+{
+	boost::system::error_code ec;
+
+	m_timer.cancel(ec);
+	m_pollTimer.cancel(ec);
+	m_reportTimer.cancel(ec);
+	m_sdTimer.cancel(ec);
+	m_sdReportTimer.cancel(ec);
+	m_master.cancel(ec);
+	m_master.close(ec);
+}
+
+void VirtualPrinter::doRead()
+{
+	m_master.async_read_some(boost::asio::buffer(m_readBuffer), std::bind(&VirtualPrinter::readDone, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void VirtualPrinter::readDone(const boost::system::error_code& ec, size_t bytesRead)
+{
+	if (ec == boost::asio::error::operation_aborted)
+		return;
+
+	if (ec)
+	{
+		// EIO until the slave side is (re)opened. Whatever was on its way is gone, like when a USB cable is unplugged.
+		m_rxBuffer.clear();
+		m_writeBuffer.clear();
+
+		m_pollTimer.expires_after(REOPEN_POLL_INTERVAL);
+		m_pollTimer.async_wait([=](const boost::system::error_code& ec) {
+			if (!ec)
+				doRead();
+		});
+		return;
+	}
+
+	const char* data = m_readBuffer;
+
+	if (m_packetMode && bytesRead > 0)
+	{
+		// Each read starts with a status byte, TIOCPKT_DATA (0) if data follows
+		if (m_readBuffer[0] != TIOCPKT_DATA)
+		{
+			// The master side sees the rate set on the slave side
+			if (m_readBuffer[0] & TIOCPKT_IOCTL)
+				m_peerBaudRate = SerialTuning::baudRate(m_master.native_handle());
+
+			doRead();
+			return;
+		}
+
+		data++;
+		bytesRead--;
+	}
+
+	if (m_options.baudRate != 0 && m_peerBaudRate != m_options.baudRate)
+	{
+		m_stats.bytesLost += bytesRead;
+		doRead();
+		return;
+	}
+
+	if (m_options.emergencyParser)
+		parseEmergency(std::string_view(data, bytesRead));
+
+	const size_t room = (m_rxBuffer.size() < m_options.rxBufferSize) ? (m_options.rxBufferSize - m_rxBuffer.size()) : 0;
+	const size_t accepted = std::min(room, bytesRead);
+
+	m_rxBuffer.append(data, accepted);
+	m_stats.bytesLost += bytesRead - accepted;
+
+	processNext();
+	doRead();
+}
+
+void VirtualPrinter::processNext()
+{
+	while (!m_busy && nextLine())
+	{
+		while (!m_line.empty() && (m_line.back() == '\r' || m_line.back() == ' '))
+			m_line.pop_back();
+
+		if (m_line.empty() || m_halted)
+			continue;
+
+		std::string_view line = m_line;
+		if (!checkLine(line))
+			continue;
+
+		m_busy = true;
+
+		// Everything but M29 goes into the file, like Marlin does it
+		if (!m_sdWriteFile.empty() && GCodeState::commandCode(line) != "M29")
+		{
+			std::string& file = m_sdFiles[m_sdWriteFile];
+
+			file.append(line);
+			file.append("\r\n");
+			m_stats.sdBytesWritten += line.length() + 2;
+
+			m_okSuffix.clear();
+			finishCommand();
+			continue;
+		}
+
+		execute(line);
+	}
+}
+
+bool VirtualPrinter::nextLine()
+{
+	std::string& text = m_options.meatPack ? m_unpacked : m_rxBuffer;
+	size_t end = text.find('\n');
+
+	// Only unpacked as far as needed, as the unpacker may be switched off by what follows
+	if (m_options.meatPack && end == std::string::npos)
+	{
+		size_t used = 0;
+
+		while (end == std::string::npos && used < m_rxBuffer.size())
+		{
+			const size_t start = m_unpacked.size();
+			m_unpacker.feed(std::string_view(m_rxBuffer).substr(used++, 1), m_unpacked);
+			end = m_unpacked.find('\n', start);
+		}
+
+		m_rxBuffer.erase(0, used);
+	}
+
+	if (end == std::string::npos)
+		return false;
+
+	m_line.assign(text, 0, end);
+	text.erase(0, end + 1);
+	return true;
+}
+
+// Anything unexpected makes the rest of the line ignored, it starts over at the end of line
+void VirtualPrinter::parseEmergency(std::string_view data)
+{
+	for (char c : data)
+	{
+		if (c != '\n' && c != '\r')
+		{
+			if (m_emergencyLine.length() <= MAX_EMERGENCY_LINE)
+				m_emergencyLine += c;
+			continue;
+		}
+
+		std::string_view line = m_emergencyLine;
+
+		// "N12 M108 *34"
+		if (!line.empty() && line[0] == 'N')
+			line.remove_prefix(std::min(line.find(' ') + 1, line.length()));
+
+		const std::string_view code = GCodeState::commandCode(line);
+		boost::system::error_code ec;
+
+		if (code == "M108" || code == "M112" || code == "M410")
+			m_stats.emergencyCommands++;
+
+		if (code == "M108" && m_heating)
+		{
+			// Stops waiting for the heaters, the command being executed gets its "ok"
+			m_heating = false;
+			m_timer.cancel(ec);
+			finishCommand();
+		}
+		else if (code == "M112" && !m_halted)
+		{
+			m_timer.cancel(ec);
+			m_heating = false;
+			reply("Error:Printer halted. kill() called!");
+			m_halted = true;
+			m_busy = false;
+		}
+
+		m_emergencyLine.clear();
+	}
+}
+
+bool VirtualPrinter::checkLine(std::string_view& line)
+{
+	if (line[0] != 'N')
+		return true;
+
+	int lineNo = 0;
+	auto result = std::from_chars(line.data() + 1, line.data() + line.length(), lineNo);
+	const size_t star = line.rfind('*');
+	std::string_view command = line.substr(result.ptr - line.data(), (star == std::string_view::npos) ? std::string_view::npos : (star - (result.ptr - line.data())));
+
+	while (!command.empty() && command.front() == ' ')
+		command.remove_prefix(1);
+	while (!command.empty() && command.back() == ' ')
+		command.remove_suffix(1);
+
+	const char* error = nullptr;
+
+	if (lineNo != m_lastLineNo + 1 && command.substr(0, 4) != "M110")
+		error = "Line Number is not Last Line Number+1";
+	else if (star == std::string_view::npos)
+		error = "No Checksum with line number";
+	else
+	{
+		unsigned int cs = 0, expected = 0;
+
+		for (size_t i = 0; i < star; i++)
+			cs ^= (unsigned char) line[i];
+
+		auto csResult = std::from_chars(line.data() + star + 1, line.data() + line.length(), expected);
+
+		if (csResult.ec != std::errc() || (cs & 0xff) != expected || chance(m_options.checksumErrorRate))
+			error = "checksum mismatch";
+	}
+
+	if (error)
+	{
+		char buf[100];
+
+		std::snprintf(buf, sizeof(buf), "Error:%s, Last Line: %d", error, m_lastLineNo);
+		reply(buf);
+		std::snprintf(buf, sizeof(buf), "Resend: %d", m_lastLineNo + 1);
+		reply(buf);
+		reply("ok");
+
+		m_stats.rejectedLines++;
+		return false;
+	}
+
+	m_lastLineNo = lineNo;
+	line = command;
+	return true;
+}
+
+void VirtualPrinter::execute(std::string_view line)
+{
+	const std::string_view code = GCodeState::commandCode(line);
+	std::chrono::microseconds delay = m_options.latency;
+	double value;
+
+	m_stats.commands++;
+	m_okSuffix.clear();
+
+	if (code == "M110")
+	{
+		if (GCodeState::parameter(line, 'N', value))
+			m_lastLineNo = int(value);
+	}
+	else if (code == "M115")
+	{
+		reply("FIRMWARE_NAME:Marlin dashprint virtual printer SOURCE_CODE_URL:github.com/dashprint/dashprint PROTOCOL_VERSION:1.0 MACHINE_TYPE:Virtual EXTRUDER_COUNT:1");
+		reply("Cap:EEPROM:0");
+		reply(m_options.advancedOk ? "Cap:ADVANCED_OK:1" : "Cap:ADVANCED_OK:0");
+		reply(m_options.autoReport ? "Cap:AUTOREPORT_TEMP:1" : "Cap:AUTOREPORT_TEMP:0");
+		reply("Cap:ARCS:1");
+		reply(m_options.emergencyParser ? "Cap:EMERGENCY_PARSER:1" : "Cap:EMERGENCY_PARSER:0");
+		reply(m_options.meatPack ? "Cap:MEATPACK:1" : "Cap:MEATPACK:0");
+		reply(m_options.sdCard ? "Cap:SDCARD:1" : "Cap:SDCARD:0");
+		reply(m_options.sdCard ? "Cap:AUTOREPORT_SD_STATUS:1" : "Cap:AUTOREPORT_SD_STATUS:0");
+	}
+	else if (code == "M105")
+	{
+		updateTemperatures();
+		m_okSuffix = ' ' + temperatureReport();
+	}
+	else if (code == "M104" || code == "M109")
+	{
+		if (GCodeState::parameter(line, 'S', value) || GCodeState::parameter(line, 'R', value))
+			m_hotend.target = value;
+
+		if (code == "M109")
+		{
+			waitForTemperature(false);
+			return;
+		}
+	}
+	else if (code == "M140" || code == "M190")
+	{
+		if (GCodeState::parameter(line, 'S', value) || GCodeState::parameter(line, 'R', value))
+			m_bed.target = value;
+
+		if (code == "M190")
+		{
+			waitForTemperature(true);
+			return;
+		}
+	}
+	else if (code == "M155" && m_options.autoReport)
+	{
+		if (GCodeState::parameter(line, 'S', value))
+		{
+			m_reportInterval = value;
+			scheduleTemperatureReport();
+		}
+	}
+	else if (m_options.sdCard && isSdCommand(code))
+		executeSdCommand(code, line);
+	else if (code == "G4")
+	{
+		if (GCodeState::parameter(line, 'P', value))
+			delay += std::chrono::microseconds(std::llround(value * 1000));
+		else if (GCodeState::parameter(line, 'S', value))
+			delay += std::chrono::microseconds(std::llround(value * 1000000));
+	}
+	else if (code == "M112")
+	{
+		// Nothing but a reset would help
+		reply("Error:Printer halted. kill() called!");
+		m_halted = true;
+		m_busy = false;
+		return;
+	}
+
+	if (delay.count() == 0)
+	{
+		finishCommand();
+		return;
+	}
+
+	m_timer.expires_after(delay);
+	m_timer.async_wait([=](const boost::system::error_code& ec) {
+		if (ec)
+			return;
+
+		finishCommand();
+		processNext();
+	});
+}
+
+void VirtualPrinter::waitForTemperature(bool bed)
+{
+	updateTemperatures();
+
+	const Heater& heater = bed ? m_bed : m_hotend;
+
+	if (heater.target <= 0 || std::abs(heater.current - heater.target) < TEMPERATURE_WINDOW)
+	{
+		m_heating = false;
+		finishCommand();
+		return;
+	}
+
+	m_heating = true;
+
+	// Reported every second like Marlin does, or more often with a fast thermal model
+	const double interval = std::clamp(m_options.thermalTimeConstant / 4, 0.01, 1.0);
+
+	reply(temperatureReport() + " W:?");
+
+	m_timer.expires_after(std::chrono::microseconds(std::llround(interval * 1000000)));
+	m_timer.async_wait([=](const boost::system::error_code& ec) {
+		// M108 may have come after the timer expired
+		if (ec || !m_heating)
+			return;
+
+		waitForTemperature(bed);
+		processNext();
+	});
+}
+
+void VirtualPrinter::scheduleTemperatureReport()
+{
+	boost::system::error_code ec;
+
+	if (m_reportInterval <= 0)
+	{
+		m_reportTimer.cancel(ec);
+		return;
+	}
+
+	m_reportTimer.expires_after(std::chrono::microseconds(std::llround(m_reportInterval * 1000000)));
+	m_reportTimer.async_wait([=](const boost::system::error_code& ec) {
+		if (ec)
+			return;
+
+		if (!m_halted)
+		{
+			updateTemperatures();
+			reply(' ' + temperatureReport());
+		}
+
+		scheduleTemperatureReport();
+	});
+}
+
+void VirtualPrinter::executeSdCommand(std::string_view code, std::string_view line)
+{
+	boost::system::error_code ec;
+	double value;
+
+	// "M23 FILE.GCO"
+	std::string_view name = line.substr(std::min(code.length(), line.length()));
+	while (!name.empty() && name.front() == ' ')
+		name.remove_prefix(1);
+
+	if (code == "M28")
+	{
+		m_sdWriteFile = name;
+		m_sdFiles[m_sdWriteFile].clear();
+		reply("Writing to file: " + m_sdWriteFile);
+	}
+	else if (code == "M29")
+	{
+		if (!m_sdWriteFile.empty())
+		{
+			m_sdWriteFile.clear();
+			reply("Done saving file.");
+		}
+	}
+	else if (code == "M23")
+	{
+		auto it = m_sdFiles.find(name);
+
+		m_sdTimer.cancel(ec);
+		m_sdPrinting = false;
+		m_sdPosition = 0;
+
+		if (it == m_sdFiles.end())
+		{
+			m_sdOpenFile.clear();
+			reply("open failed, File: " + std::string(name) + ".");
+		}
+		else
+		{
+			m_sdOpenFile = it->first;
+			reply("File opened: " + m_sdOpenFile + " Size: " + std::to_string(it->second.size()));
+			reply("File selected");
+		}
+	}
+	else if (code == "M24")
+	{
+		if (!m_sdOpenFile.empty() && !m_sdPrinting)
+		{
+			m_sdPrinting = true;
+			printFromSd();
+		}
+	}
+	else if (code == "M25")
+	{
+		m_sdPrinting = false;
+		m_sdTimer.cancel(ec);
+	}
+	else if (code == "M26")
+	{
+		if (!m_sdOpenFile.empty() && GCodeState::parameter(line, 'S', value))
+			m_sdPosition = std::min(size_t(value), m_sdFiles[m_sdOpenFile].size());
+	}
+	else if (code == "M27")
+	{
+		if (GCodeState::parameter(line, 'S', value))
+		{
+			m_sdReportInterval = value;
+			scheduleSdStatusReport();
+		}
+		else
+			reply(sdStatus());
+	}
+	else if (code == "M524")
+	{
+		if (!m_sdOpenFile.empty())
+		{
+			m_sdPrinting = false;
+			m_sdTimer.cancel(ec);
+			m_sdOpenFile.clear();
+			reply("echo:Print aborted");
+		}
+	}
+}
+
+void VirtualPrinter::printFromSd()
+{
+	const std::string& file = m_sdFiles[m_sdOpenFile];
+	const size_t lines = (m_options.sdLineTime.count() > 0)
+		? std::max<size_t>(1, std::chrono::microseconds(SD_TICK) / m_options.sdLineTime) : SIZE_MAX;
+	double value;
+
+	for (size_t i = 0; i < lines && m_sdPosition < file.length(); i++)
+	{
+		const size_t eol = std::min(file.find('\n', m_sdPosition), file.length());
+		std::string_view line(file.data() + m_sdPosition, eol - m_sdPosition);
+
+		m_sdPosition = std::min(eol + 1, file.length());
+
+		// Only the heater targets, nothing else is simulated
+		const std::string_view code = GCodeState::commandCode(line);
+		if ((code == "M104" || code == "M109") && GCodeState::parameter(line, 'S', value))
+			m_hotend.target = value;
+		else if ((code == "M140" || code == "M190") && GCodeState::parameter(line, 'S', value))
+			m_bed.target = value;
+	}
+
+	if (m_sdPosition >= file.length())
+	{
+		m_sdPrinting = false;
+		m_sdOpenFile.clear();
+		reply("Done printing file");
+		return;
+	}
+
+	m_sdTimer.expires_after(std::chrono::duration_cast<std::chrono::microseconds>(m_options.sdLineTime * lines));
+	m_sdTimer.async_wait([=](const boost::system::error_code& ec) {
+		if (!ec && m_sdPrinting && !m_halted)
+			printFromSd();
+	});
+}
+
+void VirtualPrinter::scheduleSdStatusReport()
+{
+	boost::system::error_code ec;
+
+	if (m_sdReportInterval <= 0)
+	{
+		m_sdReportTimer.cancel(ec);
+		return;
+	}
+
+	m_sdReportTimer.expires_after(std::chrono::microseconds(std::llround(m_sdReportInterval * 1000000)));
+	m_sdReportTimer.async_wait([=](const boost::system::error_code& ec) {
+		if (ec)
+			return;
+
+		if (!m_halted)
+			reply(sdStatus());
+
+		scheduleSdStatusReport();
+	});
+}
+
+std::string VirtualPrinter::sdStatus() const
+{
+	if (m_sdOpenFile.empty())
+		return "Not SD printing";
+
+	return "SD printing byte " + std::to_string(m_sdPosition) + "/" + std::to_string(m_sdFiles.find(m_sdOpenFile)->second.size());
+}
+
+void VirtualPrinter::finishCommand()
+{
+	if (chance(m_options.errorRate))
+		reply("Error:Simulated failure");
+
+	if (m_options.advancedOk && m_okSuffix.empty())
+	{
+		// Lines waiting in the RX buffer take up command slots
+		int waiting = 0;
+		for (char c : m_rxBuffer)
+		{
+			if (c == '\n')
+				waiting++;
+		}
+
+		char buf[64];
+		std::snprintf(buf, sizeof(buf), "ok N%d P%d B%d", m_lastLineNo, PLANNER_SLOTS - 1, std::max(COMMAND_SLOTS - 1 - waiting, 0));
+		reply(buf);
+	}
+	else
+		reply("ok" + m_okSuffix);
+
+	m_busy = false;
+}
+
+void VirtualPrinter::reply(std::string_view line)
+{
+	m_writeBuffer += line;
+	m_writeBuffer += '\n';
+	flushWrites();
+}
+
+void VirtualPrinter::flushWrites()
+{
+	if (!m_writing.empty() || m_writeBuffer.empty())
+		return;
+
+	m_writing.swap(m_writeBuffer);
+
+	boost::asio::async_write(m_master, boost::asio::buffer(m_writing), [=](const boost::system::error_code& ec, size_t) {
+		if (ec == boost::asio::error::operation_aborted)
+			return;
+
+		// Nobody listening, the output is lost
+		m_writing.clear();
+		flushWrites();
+	});
+}
+
+void VirtualPrinter::updateTemperatures()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const double dt = std::chrono::duration<double>(now - m_lastThermalUpdate).count();
+
+	m_lastThermalUpdate = now;
+
+	auto update = [&](Heater& heater, double tau) {
+		const double goal = (heater.target > 0) ? heater.target : AMBIENT_TEMPERATURE;
+
+		if (tau <= 0)
+			heater.current = goal;
+		else
+			heater.current += (goal - heater.current) * (1 - std::exp(-dt / tau));
+	};
+
+	update(m_hotend, m_options.thermalTimeConstant);
+	update(m_bed, m_options.thermalTimeConstant * 3);
+}
+
+std::string VirtualPrinter::temperatureReport() const
+{
+	char buf[100];
+
+	std::snprintf(buf, sizeof(buf), "T:%.2f /%.2f B:%.2f /%.2f @:0 B@:0", m_hotend.current, m_hotend.target, m_bed.current, m_bed.target);
+	return buf;
+}
+
+bool VirtualPrinter::chance(double probability)
+{
+	if (probability <= 0)
+		return false;
+
+	return std::uniform_real_distribution<double>(0, 1)(m_random) < probability;
+}
@@ -0,0 +1,153 @@
+#ifndef _VIRTUALPRINTER_H
+#define _VIRTUALPRINTER_H
+#include <boost/asio.hpp>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <random>
+#include <deque>
+#include <map>
+#include "MeatPack.h"
+
+// Emulates Marlin on the other side of a pseudo terminal, for testing and benchmarking without hardware.
+// Printer opens devicePath() like any serial port, device paths starting with "sim:" get one of these.
+// Runs on the given io_service. Line numbers and checksums are verified like Marlin does,
+// hotend and bed temperatures follow a first order thermal model.
+class VirtualPrinter
+{
+public:
+	struct Options
+	{
+		// Time each command takes before its "ok"
+		std::chrono::microseconds latency{0};
+		// Bytes received beyond this while commands are waiting are lost, like with a UART overflow
+		size_t rxBufferSize = 128;
+		// Probability of a line being rejected with "Error:checksum mismatch" and "Resend:"
+		double checksumErrorRate = 0;
+		// Probability of an "Error:" line before the "ok" of a command
+		double errorRate = 0;
+		// Time constant of the heaters in seconds, the bed takes three times as long
+		double thermalTimeConstant = 10;
+		// "ok N.. P.. B.." replies, advertised as Cap:ADVANCED_OK
+		bool advancedOk = true;
+		// M155 temperature reports, advertised as Cap:AUTOREPORT_TEMP
+		bool autoReport = true;
+		// An SD card (M20-M29, M524) with M27 reports, advertised as Cap:SDCARD and Cap:AUTOREPORT_SD_STATUS
+		bool sdCard = true;
+		// Time each line printed from the SD card takes
+		std::chrono::microseconds sdLineTime{100};
+		// M108, M112 and M410 take effect as soon as they arrive, even while busy, advertised as Cap:EMERGENCY_PARSER
+		bool emergencyParser = false;
+		// Unpacks MeatPack once switched on by the other side, advertised as Cap:MEATPACK
+		bool meatPack = false;
+		// Only understands the other side at this baud rate, 0 for any. Data sent at other rates is lost,
+		// like the garbage a UART would make of it.
+		int baudRate = 0;
+		unsigned int seed = 1;
+
+		// Parses the part after "sim:", e.g.
+		// "latency=2,rx=64,checksum_errors=0.01,errors=0,tau=10,advanced_ok=1,autoreport=1,sd=1,sd_line=0.1,emergency_parser=1,
+		// meatpack=1,baud=250000,seed=1".
+		// latency and sd_line are in milliseconds. Throws std::invalid_argument.
+		static Options parse(std::string_view spec);
+	};
+
+	VirtualPrinter(boost::asio::io_service& io, const Options& options);
+	VirtualPrinter(const VirtualPrinter&) = delete;
+	~VirtualPrinter();
+
+	// Slave side of the pseudo terminal
+	const std::string& devicePath() const { return m_devicePath; }
+
+	struct Stats
+	{
+		size_t commands = 0; // executed
+		size_t rejectedLines = 0; // with a Resend
+		size_t bytesLost = 0; // RX buffer overflows
+		size_t sdBytesWritten = 0; // between M28 and M29
+		size_t emergencyCommands = 0; // taken by the emergency parser
+	};
+	const Stats& stats() const { return m_stats; }
+
+	// Master side of a new raw pseudo terminal, the slave's path is stored in devicePath. Throws std::system_error.
+	static int openPseudoTerminal(std::string& devicePath);
+
+	static constexpr int COMMAND_SLOTS = 4; // Marlin's BUFSIZE
+	static constexpr int PLANNER_SLOTS = 16;
+private:
+	void doRead();
+	void readDone(const boost::system::error_code& ec, size_t bytesRead);
+	void processNext();
+	// Takes the next complete line out of the RX buffer, unpacking it if needed
+	bool nextLine();
+	// Like Marlin's, runs on the data as received, ahead of the RX buffer and MeatPack
+	void parseEmergency(std::string_view data);
+	// Returns false if the line was rejected
+	bool checkLine(std::string_view& line);
+	void execute(std::string_view line);
+	void finishCommand();
+	void waitForTemperature(bool bed);
+	void scheduleTemperatureReport();
+	void reply(std::string_view line);
+	void flushWrites();
+	void updateTemperatures();
+	std::string temperatureReport() const;
+	// M23-M29, M524
+	void executeSdCommand(std::string_view code, std::string_view line);
+	void printFromSd();
+	void scheduleSdStatusReport();
+	std::string sdStatus() const;
+	bool chance(double probability);
+private:
+	const Options m_options;
+	boost::asio::posix::stream_descriptor m_master;
+	std::string m_devicePath;
+	// Command execution, and polling for the other side while nobody has it open
+	boost::asio::steady_timer m_timer, m_pollTimer, m_reportTimer, m_sdTimer, m_sdReportTimer;
+
+	char m_readBuffer[512];
+	std::string m_rxBuffer;
+	// Unpacked from the RX buffer, up to the end of the line being taken out
+	std::string m_unpacked;
+	MeatPack::Unpacker m_unpacker;
+	// Line seen by the emergency parser so far
+	std::string m_emergencyLine;
+	std::string m_writeBuffer, m_writing;
+	// Command being executed and what follows "ok" in its reply
+	std::string m_line, m_okSuffix;
+
+	// The slave side's rate, see Options::baudRate. Only read when the slave side's settings change:
+	// the master is in packet mode, which reports those changes as TIOCPKT_IOCTL.
+	int m_peerBaudRate = 0;
+	bool m_packetMode = false;
+
+	bool m_busy = false;
+	// In M109/M190, until M108
+	bool m_heating = false;
+	// After M112
+	bool m_halted = false;
+	int m_lastLineNo = 0;
+	// Seconds between temperature reports set by M155, 0 if off
+	double m_reportInterval = 0;
+	std::mt19937 m_random;
+
+	struct Heater
+	{
+		double current = 25, target = 0;
+	};
+	Heater m_hotend, m_bed;
+	std::chrono::steady_clock::time_point m_lastThermalUpdate;
+
+	// Files on the SD card by name
+	std::map<std::string, std::string, std::less<>> m_sdFiles;
+	// Being written (M28) and opened for printing (M23), empty if none
+	std::string m_sdWriteFile, m_sdOpenFile;
+	size_t m_sdPosition = 0;
+	bool m_sdPrinting = false;
+	// Seconds between M27 reports, 0 if off
+	double m_sdReportInterval = 0;
+
+	Stats m_stats;
+};
+
+#endif
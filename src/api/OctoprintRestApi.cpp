@@ -60,11 +60,18 @@ namespace
 			std::string defaultPrinter = printerManager->defaultPrinter();
 			std::shared_ptr<Printer> printer = printerManager->printer(defaultPrinter);
 
-			if (printer && (!printer->hasPrintJob() || !printer->printJob()->inProgress()))
+			if (printer)
 			{
+				// Mapping the file isn't for the printer's thread
 				auto printJob = std::make_shared<PrintJob>(printer, finalFileName, filePath.c_str());
-				printer->setPrintJob(printJob);
-				printJob->start();
+
+				printer->call([&]() {
+					if (!printer->hasPrintJob() || !printer->printJob()->inProgress())
+					{
+						printer->setPrintJob(printJob);
+						printJob->start();
+					}
+				});
 			}
 		}
 
@@ -13,52 +13,167 @@
 
 #include "PrintApi.h"
 #include <sstream>
+#include <cmath>
+#include <stdexcept>
 #include "web/web.h"
 #include "nlohmann/json.hpp"
 #include "PrinterDiscovery.h"
+#include "PrinterProbe.h"
 #include "PrinterManager.h"
 #include "util.h"
 #include "PrintJob.h"
 #include "AuthManager.h"
+#include "SerialCapture.h"
+#include <set>
+#include <cstring>
+#include <boost/filesystem.hpp>
 
 namespace
 {
-	void restPrintersDiscover(WebRequest& req, WebResponse& resp)
+	// Configured device paths may be /dev/serial/by-id links to the discovered ones
+	std::string canonicalDevicePath(const std::string& path)
+	{
+		boost::system::error_code ec;
+		boost::filesystem::path canonical = boost::filesystem::canonical(path, ec);
+
+		return ec ? path : canonical.string();
+	}
+
+	nlohmann::json jsonFillProbeResult(const PrinterProbe::Result& probe)
+	{
+		nlohmann::json capabilities = nlohmann::json::object(), firmware = nlohmann::json::object();
+
+		for (const auto& [key, value] : probe.firmwareInfo)
+		{
+			if (key.compare(0, 4, "Cap:") == 0)
+				capabilities[key.substr(4)] = (value == "1");
+			else
+				firmware[key] = value;
+		}
+
+		nlohmann::json result = {
+			{ "baud_rate", probe.found() ? nlohmann::json(probe.baudRate) : nlohmann::json() },
+			{ "firmware_name", probe.firmwareName },
+			{ "firmware", firmware },
+			{ "capabilities", capabilities }
+		};
+
+		if (!probe.error.empty())
+			result["error"] = probe.error;
+
+		return result;
+	}
+
+	// Lists the serial ports. With ?probe=1, also starts probing those not used by configured printers
+	// for their baud rate and firmware. That takes a few seconds, it runs on a thread of its own and
+	// the "PrinterManager.discovery" event tells when the results are in, see restPrintersProbeResults().
+	void restPrintersDiscover(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
 	{
 		std::vector<DiscoveredPrinter> printers;
+		std::set<std::string> inUse;
+		std::vector<std::string> toProbe;
 		nlohmann::json result = nlohmann::json::array();
+		const char* probe = req.queryParam("probe");
 		
 		PrinterDiscovery::enumerateAll(printers);
-		
+
+		for (const std::string& name : printerManager->printerNames())
+		{
+			std::shared_ptr<Printer> printer = printerManager->printer(name);
+
+			if (printer)
+				inUse.insert(canonicalDevicePath(printer->call([&]() { return std::string(printer->devicePath()); })));
+		}
+
 		for (const DiscoveredPrinter& p : printers)
 		{
+			const bool used = inUse.count(canonicalDevicePath(p.devicePath)) > 0;
+
+			if (!used)
+				toProbe.push_back(p.devicePath);
+
 			result.push_back({
 				{ "path", p.devicePath },
 				{ "name", p.deviceName },
 				{ "vendor", p.deviceVendor },
-				{ "serial", p.deviceSerial }
+				{ "serial", p.deviceSerial },
+				{ "in_use", used }
 			});
 		}
+
+		if (probe && std::strcmp(probe, "1") == 0 && !toProbe.empty() && !printerManager->startProbe(toProbe))
+		{
+			resp.send(boost::beast::http::status::conflict);
+			return;
+		}
 		
 		resp.send(result);
 	}
 
+	// The results of the last probe started by restPrintersDiscover()
+	void restPrintersProbeResults(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		std::vector<PrinterProbe::Result> probes;
+		const bool running = printerManager->probeResults(probes);
+		nlohmann::json results = nlohmann::json::array();
+
+		for (const PrinterProbe::Result& probe : probes)
+		{
+			nlohmann::json entry = jsonFillProbeResult(probe);
+
+			entry["path"] = probe.devicePath;
+			results.push_back(entry);
+		}
+
+		resp.send(nlohmann::json {
+			{ "running", running },
+			{ "results", results }
+		});
+	}
+
+	// The settings are read on the printer's thread
 	nlohmann::json jsonFillPrinter(std::shared_ptr<Printer> printer, bool isDefault)
 	{
-		return nlohmann::json {
-				{"device_path", printer->devicePath()},
-				{"baud_rate",   printer->baudRate()},
-				{"stopped",     printer->state() == Printer::State::Stopped},
-				//{"api_key",     printer->apiKey()},
-				{"name",        printer->name()},
-				{"default",     isDefault},
-				{"connected",   printer->state() == Printer::State::Connected},
-				{"width", printer->printArea().width},
-				{"height", printer->printArea().height},
-				{"depth", printer->printArea().depth},
-				{"state", Printer::stateName(printer->state())},
-				{"errorMessage", printer->errorMessage()}
-		};
+		return printer->call([&]() {
+			return nlohmann::json {
+					{"device_path", printer->devicePath()},
+					{"baud_rate",   printer->baudRate()},
+					{"stopped",     printer->state() == Printer::State::Stopped},
+					//{"api_key",     printer->apiKey()},
+					{"name",        printer->name()},
+					{"default",     isDefault},
+					{"connected",   printer->state() == Printer::State::Connected},
+					{"width", printer->printArea().width},
+					{"height", printer->printArea().height},
+					{"depth", printer->printArea().depth},
+					{"state", Printer::stateName(printer->state())},
+					{"errorMessage", printer->errorMessage()},
+					{"streaming", printer->streaming()},
+					{"meatpack", printer->meatPack()},
+					{"compaction", printer->compaction()},
+					{"compaction_decimals", printer->compactionDecimals()},
+					{"arc_fitting", printer->arcFitting()},
+					{"arc_tolerance", printer->arcTolerance()},
+					{"decimation", printer->decimation()},
+					{"decimation_tolerance", printer->decimationTolerance()},
+					{"rx_buffer_size", printer->rxBufferSize()},
+					{"progress_rate", printer->progressRate()},
+					{"progress_min_delta", printer->progressMinDelta()},
+					{"temperature_report_interval", printer->temperatureReportInterval()},
+					{"sd_offload", printer->sdOffload()},
+					{"realtime", printer->realtime()},
+					{"low_latency", printer->serialTuning().lowLatency},
+					{"vmin", printer->serialTuning().vmin},
+					{"vtime", printer->serialTuning().vtime},
+					{"usb_cdc", printer->serialTuning().usbCdc},
+					{"serial", {
+						{"low_latency", printer->serialTuningResult().lowLatency},
+						{"custom_baud_rate", printer->serialTuningResult().customBaudRate},
+						{"baud_rate", printer->serialTuningResult().baudRate},
+						{"rtt_us", printer->stats().roundTrip().count()}
+					}}
+			};
+		});
 	}
 
 	void restPrinter(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
@@ -84,7 +199,7 @@ namespace
 
 		if (printer->state() != Printer::State::Error)
 			throw WebErrors::bad_request("The printer is not in error state");
-		printer->resetPrinter();
+		printer->post([printer]() { printer->resetPrinter(); });
 		
 		resp.send(WebResponse::http_status::no_content);
 	}
@@ -132,6 +247,56 @@ namespace
 		if (data["default"].is_boolean() && data["default"].get<bool>())
 			makeDefault = true;
 
+		if (data["streaming"].is_boolean())
+			printer->setStreaming(data["streaming"].get<bool>());
+
+		if (data["meatpack"].is_boolean())
+			printer->setMeatPack(data["meatpack"].get<bool>());
+
+		if (data["compaction"].is_boolean())
+			printer->setCompaction(data["compaction"].get<bool>());
+
+		if (data["compaction_decimals"].is_number())
+			printer->setCompactionDecimals(data["compaction_decimals"].get<int>());
+
+		if (data["arc_fitting"].is_boolean())
+			printer->setArcFitting(data["arc_fitting"].get<bool>());
+
+		if (data["arc_tolerance"].is_number())
+			printer->setArcTolerance(data["arc_tolerance"].get<double>());
+
+		if (data["decimation"].is_boolean())
+			printer->setDecimation(data["decimation"].get<bool>());
+
+		if (data["decimation_tolerance"].is_number())
+			printer->setDecimationTolerance(data["decimation_tolerance"].get<double>());
+
+		if (data["rx_buffer_size"].is_number())
+			printer->setRxBufferSize(data["rx_buffer_size"].get<int>());
+
+		if (data["progress_rate"].is_number())
+			printer->setProgressRate(data["progress_rate"].get<double>());
+
+		if (data["progress_min_delta"].is_number())
+			printer->setProgressMinDelta(data["progress_min_delta"].get<double>());
+
+		if (data["temperature_report_interval"].is_number())
+			printer->setTemperatureReportInterval(data["temperature_report_interval"].get<int>());
+
+		if (data["sd_offload"].is_boolean())
+			printer->setSdOffload(data["sd_offload"].get<bool>());
+
+		SerialTuning tuning = printer->serialTuning();
+		if (data["low_latency"].is_boolean())
+			tuning.lowLatency = data["low_latency"].get<bool>();
+		if (data["vmin"].is_number())
+			tuning.vmin = data["vmin"].get<int>();
+		if (data["vtime"].is_number())
+			tuning.vtime = data["vtime"].get<int>();
+		if (data["usb_cdc"].is_boolean())
+			tuning.usbCdc = data["usb_cdc"].get<bool>();
+		printer->setSerialTuning(tuning);
+
 		Printer::PrintArea area = printer->printArea();
 		if (data["width"].is_number())
 			area.width = data["width"].get<int>();
@@ -166,8 +331,10 @@ namespace
 		if (data["name"].get<std::string>().empty() || data["device_path"].get<std::string>().empty() || data["baud_rate"].get<int>() < 1200)
 			throw WebErrors::bad_request("Missing parameters");
 
-		configurePrinterFromJson(data, printer.get(), makeDefault, true);
-		printer->setUniqueName(urlSafeString(printer->name(), "printer").c_str());
+		printer->call([&]() {
+			configurePrinterFromJson(data, printer.get(), makeDefault, true);
+			printer->setUniqueName(urlSafeString(printer->name(), "printer").c_str());
+		});
 
 		printerManager->addPrinter(printer);
 
@@ -195,10 +362,13 @@ namespace
 		{
 			newPrinter = true;
 			printer = printerManager->newPrinter();
-			printer->setUniqueName(name.c_str());
 		}
 
-		configurePrinterFromJson(data, printer.get(), makeDefault, false);
+		printer->call([&]() {
+			if (newPrinter)
+				printer->setUniqueName(name.c_str());
+			configurePrinterFromJson(data, printer.get(), makeDefault, false);
+		});
 
 		if (newPrinter)
 			printerManager->addPrinter(printer);
@@ -211,6 +381,34 @@ namespace
 		resp.send(WebResponse::http_status::no_content);
 	}
 
+	// Optional "line", "layer" (both 0-based) or byte "offset" to start the job from.
+	// Only reads the job's file, it's called off the printer's thread.
+	bool jobStartOffset(nlohmann::json& jreq, std::shared_ptr<PrintJob> printJob, size_t& offset)
+	{
+		try
+		{
+			if (jreq["line"].is_number_unsigned())
+				offset = printJob->lineOffset(jreq["line"].get<size_t>());
+			else if (jreq["layer"].is_number_unsigned())
+				offset = printJob->layerOffset(jreq["layer"].get<size_t>());
+			else if (jreq["offset"].is_number_unsigned())
+			{
+				offset = jreq["offset"].get<size_t>();
+
+				if (offset >= printJob->fileSize())
+					throw std::out_of_range("Offset beyond the end of file");
+			}
+			else
+				return false;
+		}
+		catch (const std::out_of_range& e)
+		{
+			throw WebErrors::bad_request(e.what());
+		}
+
+		return true;
+	}
+
 	void restSubmitJob(WebRequest& req, WebResponse& resp, PrinterManager* printerManager, FileManager* fileManager)
 	{
 		// If there's a paused/running print job, report a conflict
@@ -226,26 +424,48 @@ namespace
 		if (!printer)
 			throw WebErrors::not_found("Printer not found");
 
-		std::shared_ptr<PrintJob> printJob = printer->printJob();
-		if (printJob && (printJob->state() == PrintJob::State::Paused || printJob->state() == PrintJob::State::Running))
-		{
-			resp.send(WebResponse::http_status::conflict);
-			return;
-		}
-
 		std::string fileName = jreq["file"].get<std::string>();
 		std::string filePath = fileManager->getFilePath(fileName);
 
 		if (!boost::filesystem::is_regular_file(filePath))
 			throw WebErrors::not_found(".gcode file not found");
-		
-		printJob = std::make_shared<PrintJob>(printer, fileName, filePath.c_str());
-		printer->setPrintJob(printJob);
 
-		// Unless state is Stopped, start the job
-		if (!jreq["state"].is_string() || jreq["state"].get<std::string>() != "Stopped")
-			printJob->start();
+		// Mapping the file and replaying the part before the start offset take a while on big files,
+		// the printer's thread only gets the finished job
+		auto printJob = std::make_shared<PrintJob>(printer, fileName, filePath.c_str());
+		const bool start = !jreq["state"].is_string() || jreq["state"].get<std::string>() != "Stopped";
+
+		size_t offset;
+		PrintJob::StartPoint startPoint;
+		const bool startAtOffset = jobStartOffset(jreq, printJob, offset);
+
+		if (start && startAtOffset)
+			startPoint = printJob->startPoint(offset);
+
+		const bool created = printer->call([&]() {
+			std::shared_ptr<PrintJob> current = printer->printJob();
+			if (current && current->inProgress())
+				return false;
+
+			printer->setPrintJob(printJob);
+
+			if (start)
+			{
+				if (startAtOffset)
+					printJob->startAt(startPoint);
+				else
+					printJob->start();
+			}
+			return true;
+		});
+
+		if (!created)
+		{
+			resp.send(WebResponse::http_status::conflict);
+			return;
+		}
 
+		printerManager->discardInterruptedJob(printerName);
 		resp.send(WebResponse::http_status::no_content);
 	}
 
@@ -261,52 +481,84 @@ namespace
 		std::shared_ptr<PrintJob> printJob = printer->printJob();
 		if (!printJob)
 			throw WebErrors::not_found("Print job not found");
-		
-		if (jreq["state"].is_string())
-		{
-			std::string stateValue = jreq["state"].get<std::string>();
-			if (stateValue == "Stopped")
+
+		// Only reads the job's file, so it's done here rather than holding up the printer's thread
+		size_t offset;
+		PrintJob::StartPoint startPoint;
+		const bool startAtOffset = jreq["state"].is_string() && jreq["state"].get<std::string>() == "Running"
+			&& jobStartOffset(jreq, printJob, offset);
+
+		if (startAtOffset)
+			startPoint = printJob->startPoint(offset);
+
+		printer->call([&]() {
+			if (jreq["state"].is_string())
 			{
-				switch (printJob->state())
+				std::string stateValue = jreq["state"].get<std::string>();
+				if (stateValue == "Stopped")
 				{
-					case PrintJob::State::Running:
-					case PrintJob::State::Paused:
-						printJob->stop();
-						break;
-					default:
-						;
+					switch (printJob->state())
+					{
+						case PrintJob::State::Running:
+						case PrintJob::State::Paused:
+							printJob->stop();
+							break;
+						default:
+							;
+					}
 				}
+				else if (stateValue == "Paused")
+				{
+					if (printJob->state() == PrintJob::State::Running)
+						printJob->pause();
+				}
+				else if (stateValue == "Running")
+				{
+					if (printJob->state() != PrintJob::State::Running)
+					{
+						if (startAtOffset)
+							printJob->startAt(startPoint);
+						else
+							printJob->start();
+					}
+				}
+				else
+					throw WebErrors::bad_request("Unrecognized 'state' value");
 			}
-			else if (stateValue == "Paused")
-			{
-				if (printJob->state() == PrintJob::State::Running)
-					printJob->pause();
-			}
-			else if (stateValue == "Running")
-			{
-				if (printJob->state() != PrintJob::State::Running)
-					printJob->start();
-			}
-			else
-				throw WebErrors::bad_request("Unrecognized 'state' value");
-		}
+		});
 
 		resp.send(WebResponse::http_status::no_content);
 	}
 
-	void restGetJob(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	// A job interrupted by a crash or power loss, resume it by submitting a job with the "offset"
+	void restGetInterruptedJob(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
 	{
 		std::string printerName = req.pathParam(1);
-		std::shared_ptr<Printer> printer = printerManager->printer(printerName.c_str());
+		JobJournal::Contents job;
 
-		// TODO
-		if (!printer)
-			throw WebErrors::not_found("Printer not found");
+		if (!printerManager->interruptedJob(printerName, job))
+			throw WebErrors::not_found("No interrupted job");
 
-		std::shared_ptr<PrintJob> printJob = printer->printJob();
-		if (!printJob)
-			throw WebErrors::not_found("Print job not found");
+		nlohmann::json result = nlohmann::json::object();
+		result["file"] = job.jobName;
+		result["total"] = job.fileSize;
+		result["offset"] = job.entry.offset;
+		result["relative_positioning"] = job.entry.relativePositioning;
+		result["extruder_relative_positioning"] = job.entry.extruderRelativePositioning;
+		result["hotend_target"] = job.entry.hotendTarget;
+		result["bed_target"] = job.entry.bedTarget;
+
+		resp.send(result);
+	}
+
+	void restDiscardInterruptedJob(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		printerManager->discardInterruptedJob(req.pathParam(1));
+		resp.send(WebResponse::http_status::no_content);
+	}
 
+	nlohmann::json jsonFillJob(std::shared_ptr<PrintJob> printJob)
+	{
 		nlohmann::json result = nlohmann::json::object();
 		result["state"] = printJob->stateString();
 		result["error"] = printJob->errorString();
@@ -317,9 +569,72 @@ namespace
 
 		result["done"] = pos;
 		result["total"] = total;
+
+		printJob->lineProgress(pos, total);
+		result["line"] = pos;
+		result["lines"] = total;
 		result["elapsed"] = printJob->timeElapsed().count();
 
-		resp.send(result);
+		double timeDone, timeTotal;
+		if (printJob->timeProgress(timeDone, timeTotal))
+		{
+			result["time_done"] = int(timeDone);
+			result["time_total"] = int(timeTotal);
+		}
+
+		// M73 from the file takes precedence over the estimate
+		int remaining;
+		if (printJob->remainingTime(remaining))
+			result["eta"] = remaining;
+		if (printJob->reportedProgress() >= 0)
+			result["percent"] = printJob->reportedProgress();
+
+		// Printed by the printer from its SD card, after uploading it there
+		result["sd"] = printJob->printingFromSd();
+		if (printJob->uploadProgress(pos, total))
+		{
+			result["upload_done"] = pos;
+			result["upload_total"] = total;
+		}
+
+		GCodePipeline::Stats stats;
+		if (printJob->pipelineStats(stats))
+		{
+			result["pipeline"] = {
+				{"lines_in", stats.linesIn},
+				{"lines_out", stats.linesOut},
+				{"bytes_in", stats.bytesIn},
+				{"bytes_out", stats.bytesOut}
+			};
+
+			for (const GCodePipeline::StageStats& stage : stats.stages)
+			{
+				result["pipeline"]["stages"].push_back({
+					{"name", stage.name},
+					{"lines_in", stage.linesIn},
+					{"lines_out", stage.linesOut}
+				});
+			}
+		}
+
+		return result;
+	}
+
+	void restGetJob(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		std::string printerName = req.pathParam(1);
+		std::shared_ptr<Printer> printer = printerManager->printer(printerName.c_str());
+
+		// TODO
+		if (!printer)
+			throw WebErrors::not_found("Printer not found");
+
+		std::shared_ptr<PrintJob> printJob = printer->printJob();
+		if (!printJob)
+			throw WebErrors::not_found("Print job not found");
+
+		// The job's progress is updated on the printer's thread
+		resp.send(printer->call([&]() { return jsonFillJob(printJob); }));
 	}
 
 	void restGetPrinterTemperatures(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
@@ -330,24 +645,71 @@ namespace
 		if (!printer)
 			throw WebErrors::not_found("Printer not found");
 
+		// Unix times in seconds, the last 30 minutes by default
+		auto timeParam = [&](const char* param, std::chrono::system_clock::time_point def) {
+			const char* value = req.queryParam(param);
+
+			if (!value)
+				return def;
+
+			try
+			{
+				const auto seconds = std::chrono::duration<double>(std::stod(value));
+				// Half the range, so that the default "from" 30 minutes earlier stays in it too.
+				// NaN fails the comparison as well.
+				const auto limit = std::chrono::duration<double>(std::chrono::system_clock::duration::max() / 2);
+
+				if (!(std::abs(seconds.count()) < limit.count()))
+					throw std::out_of_range(param);
+
+				return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(seconds));
+			}
+			catch (const std::exception& e)
+			{
+				throw WebErrors::bad_request(std::string("Invalid ") + param);
+			}
+		};
+
+		const auto to = timeParam("to", std::chrono::system_clock::now());
+		const auto from = timeParam("from", to - std::chrono::minutes(30));
+		size_t maxPoints = 0;
+
+		if (const char* points = req.queryParam("points"))
+		{
+			try
+			{
+				maxPoints = std::stoul(points);
+			}
+			catch (const std::exception& e)
+			{
+				throw WebErrors::bad_request("Invalid points");
+			}
+		}
+
 		nlohmann::json result = nlohmann::json::array();
-		std::list<Printer::TemperaturePoint> temps = printer->getTemperatureHistory();
+		const TemperatureHistory::Series temps = printer->getTemperatureHistory(from, to, maxPoints);
 
-		for (auto it = temps.begin(); it != temps.end(); it++)
+		for (size_t i = 0; i < temps.size(); i++)
 		{
 			nlohmann::json values = nlohmann::json::object();
 
-			for (auto it2 = it->values.begin(); it2 != it->values.end(); it2++)
+			for (int sensor = 0; sensor < TemperatureReport::SENSORS; sensor++)
 			{
-				values[it2->first] = {
-						{"current", it2->second.current},
-						{"target",  it2->second.target}
-				};
+				if (!temps.has(sensor) || std::isnan(temps.current[sensor][i]))
+					continue;
+
+				nlohmann::json& value = values[TemperatureReport::sensorName(sensor)];
+
+				value["current"] = temps.current[sensor][i];
+				if (!std::isnan(temps.target[sensor][i]))
+					value["target"] = temps.target[sensor][i];
 			}
 
-			std::time_t tt = std::chrono::system_clock::to_time_t(it->when);
+			const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(temps.when[i].time_since_epoch()).count();
+			std::time_t tt = millis / 1000;
 			char when[sizeof "2011-10-08T07:07:09.000Z"];
-			strftime(when, sizeof when, "%FT%T.000Z", gmtime(&tt));
+			char* end = when + strftime(when, sizeof when, "%FT%T", gmtime(&tt));
+			snprintf(end, when + sizeof when - end, ".%03dZ", int(millis % 1000));
 
 			nlohmann::json pt = nlohmann::json::object();
 			pt["when"] = when;
@@ -373,7 +735,7 @@ namespace
 		if (!changes.is_object())
 			throw WebErrors::bad_request("JSON object expected");
 
-		int commandsToGo = 0;
+		std::vector<std::string> commands;
 		for (nlohmann::json::iterator it = changes.begin(); it != changes.end(); it++)
 		{
 			std::string key = it.key();
@@ -389,18 +751,14 @@ namespace
 
 			gcode += std::to_string(temp);
 
-			commandsToGo++;
-			printer->sendCommand(gcode.c_str(), [&](const std::vector<std::string>& reply) {
-				// TODO: Are there ever any errors reported back by the printers here?
-
-				commandsToGo--;
-				if (commandsToGo == 0)
-					resp.send(WebResponse::http_status::no_content);
-			});
+			commands.push_back(gcode);
 		}
 
-		if (commandsToGo == 0)
-			resp.send(WebResponse::http_status::no_content);
+		// Queued without waiting for the replies, which come on the printer's thread
+		for (const std::string& gcode : commands)
+			printer->sendCommand(gcode.c_str(), nullptr);
+
+		resp.send(WebResponse::http_status::no_content);
 	}
 
 	void restGetGcodeHistory(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
@@ -412,7 +770,7 @@ namespace
 			throw WebErrors::not_found("Printer not found");
 
 		nlohmann::json result = nlohmann::json::array();
-		std::list<Printer::GCodeEvent> gcodeHistory = printer->gcodeHistory();
+		std::vector<Printer::GCodeEvent> gcodeHistory = printer->gcodeHistory();
 
 		for (const auto& e : gcodeHistory)
 		{
@@ -431,6 +789,108 @@ namespace
 		resp.send(result);
 	}
 
+	nlohmann::json jsonFillCapture(std::shared_ptr<SerialCapture> capture)
+	{
+		if (!capture)
+			return nlohmann::json { {"active", false} };
+
+		return nlohmann::json {
+			{"active", true},
+			{"file", capture->path()},
+			{"bytes_sent", capture->bytesSent()},
+			{"bytes_received", capture->bytesReceived()}
+		};
+	}
+
+	void restGetCapture(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		std::shared_ptr<Printer> printer = printerManager->printer(req.pathParam(1));
+
+		if (!printer)
+			throw WebErrors::not_found("Printer not found");
+
+		resp.send(jsonFillCapture(printer->capture()));
+	}
+
+	// Starts or stops capturing the printer's serial traffic, for replaying with a "replay:file=..." device path
+	void restSetCapture(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		std::shared_ptr<Printer> printer = printerManager->printer(req.pathParam(1));
+
+		if (!printer)
+			throw WebErrors::not_found("Printer not found");
+
+		nlohmann::json data = req.jsonRequest();
+		if (!data["active"].is_boolean())
+			throw WebErrors::bad_request("Missing 'active' value");
+
+		if (data["active"].get<bool>())
+			printer->startCapture(printerManager->capturePath(printer->uniqueName()));
+		else
+			printer->stopCapture();
+
+		resp.send(jsonFillCapture(printer->capture()));
+	}
+
+	nlohmann::json jsonFillHistogram(const LatencyHistogram& histogram)
+	{
+		return nlohmann::json {
+			{"count", histogram.count()},
+			{"min_us", histogram.min().count()},
+			{"mean_us", histogram.mean().count()},
+			{"p50_us", histogram.percentile(50).count()},
+			{"p90_us", histogram.percentile(90).count()},
+			{"p99_us", histogram.percentile(99).count()},
+			{"p999_us", histogram.percentile(99.9).count()},
+			{"max_us", histogram.max().count()}
+		};
+	}
+
+	void restGetStats(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		std::shared_ptr<Printer> printer = printerManager->printer(req.pathParam(1));
+
+		if (!printer)
+			throw WebErrors::not_found("Printer not found");
+
+		PrinterStats stats = printer->stats();
+		nlohmann::json latencies = nlohmann::json::object();
+
+		for (const auto& [code, histogram] : stats.latencies)
+			latencies[code] = jsonFillHistogram(histogram);
+
+		std::time_t tt = std::chrono::system_clock::to_time_t(stats.since);
+		char since[sizeof "2011-10-08T07:07:09.000Z"];
+		strftime(since, sizeof since, "%FT%T.000Z", gmtime(&tt));
+
+		resp.send(nlohmann::json {
+			{"since", since},
+			{"latencies", latencies},
+			{"bytes_sent", stats.bytesSent},
+			{"bytes_received", stats.bytesReceived},
+			{"resend_requests", stats.resendRequests},
+			{"lines_resent", stats.linesResent},
+			{"timeouts", stats.timeouts},
+			{"queued_commands", stats.queuedCommands},
+			{"in_flight", stats.inFlight},
+			{"max_queued_commands", stats.maxQueuedCommands},
+			{"max_in_flight", stats.maxInFlight},
+			{"wakeup_latency", jsonFillHistogram(stats.wakeupLatency)},
+			{"priority_latency", jsonFillHistogram(stats.priorityLatency)}
+		});
+	}
+
+	void restResetStats(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
+	{
+		std::shared_ptr<Printer> printer = printerManager->printer(req.pathParam(1));
+
+		if (!printer)
+			throw WebErrors::not_found("Printer not found");
+
+		printer->resetStats();
+		resp.send(WebResponse::http_status::no_content);
+	}
+
 	void restSubmitGcode(WebRequest& req, WebResponse& resp, PrinterManager* printerManager)
 	{
 		std::string name = req.pathParam(1);
@@ -473,7 +933,8 @@ namespace
 
 void routePrinter(WebRouter* router, FileManager& fileManager, PrinterManager& printerManager)
 {
-	router->post("printers/discover", restPrintersDiscover);
+	router->post("printers/discover", restPrintersDiscover, &printerManager);
+	router->get("printers/discover/probe", restPrintersProbeResults, &printerManager);
 	router->get("printers", restPrinters, &printerManager);
 	router->post("printers", restSetupNewPrinter, &printerManager);
 	
@@ -485,10 +946,18 @@ void routePrinter(WebRouter* router, FileManager& fileManager, PrinterManager& p
 	router->post("printers/([^/]+)/job", restSubmitJob, &printerManager, &fileManager);
 	router->put("printers/([^/]+)/job", restModifyJob, &printerManager);
 	router->get("printers/([^/]+)/job", restGetJob, &printerManager);
+	router->get("printers/([^/]+)/job/interrupted", restGetInterruptedJob, &printerManager);
+	router->delete_("printers/([^/]+)/job/interrupted", restDiscardInterruptedJob, &printerManager);
 
 	router->get("printers/([^/]+)/gcode", restGetGcodeHistory, &printerManager);
 	router->post("printers/([^/]+)/gcode", restSubmitGcode, &printerManager);
 
+	router->get("printers/([^/]+)/capture", restGetCapture, &printerManager);
+	router->put("printers/([^/]+)/capture", restSetCapture, &printerManager);
+
+	router->get("printers/([^/]+)/stats", restGetStats, &printerManager);
+	router->delete_("printers/([^/]+)/stats", restResetStats, &printerManager);
+
 	router->put("printers/([^/]+)/temperatures", restSetPrinterTemperatures, &printerManager);
 	router->get("printers/([^/]+)/temperatures", restGetPrinterTemperatures, &printerManager);
 }
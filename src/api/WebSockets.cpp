@@ -1,6 +1,7 @@
 #include "WebSockets.h"
 #include <memory>
 #include <map>
+#include <mutex>
 #include <string>
 #include <boost/log/trivial.hpp>
 #include <boost/algorithm/string.hpp>
@@ -40,7 +41,8 @@ public:
 		}
 	}
 private:
-	// Set up a connection that automatically dies with this instance of WSSubscriptionServer
+	// Set up a connection that automatically dies with this instance of WSSubscriptionServer.
+	// The handler runs on the thread raising the signal, which is the printer's own thread for printer and job events.
 	template<typename SignalType, typename CallableType>
 	boost::signals2::connection selfTrackingConnect(boost::signals2::signal<SignalType>& signal, CallableType handler)
 	{
@@ -60,9 +62,15 @@ private:
 
 			BOOST_LOG_TRIVIAL(debug) << "WS - Subscribing to " << v;
 
-			if (route[0] == "PrinterManager")
+			if (route[0] == "PrinterManager" && route.size() >= 2 && route[1] == "discovery")
 			{
-				m_subscriptions.emplace(v, selfTrackingConnect(m_printerManager.printerListChangeSignal(),
+				addSubscription(v, selfTrackingConnect(m_printerManager.probeDoneSignal(),
+															std::bind(&WSSubscriptionServer::printerDiscoveryEvent, this)));
+				return;
+			}
+			else if (route[0] == "PrinterManager")
+			{
+				addSubscription(v, selfTrackingConnect(m_printerManager.printerListChangeSignal(),
 															std::bind(&WSSubscriptionServer::printerManagerEvent, this)));
 				return;
 			}
@@ -74,20 +82,20 @@ private:
 				{
 					if (route[2] == "state")
 					{
-						m_subscriptions.emplace(v, selfTrackingConnect(printer->stateChangeSignal(),
+						addSubscription(v, selfTrackingConnect(printer->stateChangeSignal(),
 							std::bind(&WSSubscriptionServer::printerStateEvent, this, route[1], std::placeholders::_1)));
 						return;
 					}
 					else if (route[2] == "temperature")
 					{
-						m_subscriptions.emplace(v, selfTrackingConnect(printer->temperatureChangeSignal(),
+						addSubscription(v, selfTrackingConnect(printer->temperatureChangeSignal(),
 							std::bind(&WSSubscriptionServer::printerTemperatureEvent, this, route[1], std::placeholders::_1)));
 						return;
 					}
 					else if (route[2] == "job")
 					{
 						// Subscribe to hasJob signal
-						m_subscriptions.emplace(v, selfTrackingConnect(printer->hasPrintJobChangeSignal(),
+						addSubscription(v, selfTrackingConnect(printer->hasPrintJobChangeSignal(),
 							std::bind(&WSSubscriptionServer::printerHasJobEvent, this, route[1], std::placeholders::_1)));
 						
 						// If it currently has a job, also subscribe to that PrintJob
@@ -96,7 +104,7 @@ private:
 					}
 					else if (route[2] == "gcode")
 					{
-						m_subscriptions.emplace(v, selfTrackingConnect(printer->gcodeSignal(),
+						addSubscription(v, selfTrackingConnect(printer->gcodeSignal(),
 							std::bind(&WSSubscriptionServer::printerGcodeEvent, this, route[1], std::placeholders::_1)));
 						return;
 					}
@@ -106,7 +114,7 @@ private:
 			{
 				if (route[1] == "change")
 				{
-					m_subscriptions.emplace(v, selfTrackingConnect(m_fileManager.fileListChangedSignal(),
+					addSubscription(v, selfTrackingConnect(m_fileManager.fileListChangedSignal(),
 						std::bind(&WSSubscriptionServer::fileManagerEvent, this)));
 					return;
 				}
@@ -116,10 +124,18 @@ private:
 		}
 	}
 
+	// Job subscriptions are also added from printer threads, see printerHasJobEvent()
+	void addSubscription(const std::string& name, boost::signals2::connection connection)
+	{
+		std::lock_guard<std::mutex> lock(m_subscriptionsMutex);
+		m_subscriptions.emplace(name, connection);
+	}
+
 	void handleUnsubscribeRequest(const nlohmann::json& request)
 	{
 		if (request.is_string())
 		{
+			std::lock_guard<std::mutex> lock(m_subscriptionsMutex);
 			std::multimap<std::string, boost::signals2::connection>::iterator it;
 			while ((it = m_subscriptions.find(request.get<std::string>())) != m_subscriptions.end())
 			{
@@ -142,6 +158,15 @@ private:
 		raiseEvent(event);
 	}
 
+	// The results are fetched from printers/discover/probe
+	void printerDiscoveryEvent()
+	{
+		nlohmann::json event;
+		event["event"]["PrinterManager.discovery"] = nlohmann::json::object();
+
+		raiseEvent(event);
+	}
+
 	void printerStateEvent(std::string printerId, Printer::State state)
 	{
 		nlohmann::json event, eventData;
@@ -172,7 +197,7 @@ private:
 		raiseEvent(event);
 	}
 
-	void printerGcodeEvent(std::string printer, Printer::GCodeEvent gcode)
+	void printerGcodeEvent(std::string printer, const Printer::GCodeEvent& gcode)
 	{
 		nlohmann::json event;
 
@@ -192,10 +217,10 @@ private:
 		{
 			std::string v = std::string("Printer.") + printer->uniqueName() + ".job";
 
-			m_subscriptions.emplace(v, selfTrackingConnect(printJob->stateChangeSignal(),
+			addSubscription(v, selfTrackingConnect(printJob->stateChangeSignal(),
 				std::bind(&WSSubscriptionServer::jobStateChangeEvent, this, printer->uniqueName(), printJob.get(), std::placeholders::_1, std::placeholders::_2)));
 
-			m_subscriptions.emplace(v, selfTrackingConnect(printJob->progressChangeSignal(),
+			addSubscription(v, selfTrackingConnect(printJob->progressChangeSignal(),
 				std::bind(&WSSubscriptionServer::jobProgressEvent, this, printer->uniqueName(), printJob.get(), std::placeholders::_1)));
 		}
 		return printJob;
@@ -226,6 +251,19 @@ private:
 				eventObject["done"] = progress;
 				eventObject["total"] = total;
 				eventObject["name"] = printJob->name();
+
+				double timeDone, timeTotal;
+				if (printJob->timeProgress(timeDone, timeTotal))
+				{
+					eventObject["time_done"] = int(timeDone);
+					eventObject["time_total"] = int(timeTotal);
+				}
+
+				int remaining;
+				if (printJob->remainingTime(remaining))
+					eventObject["eta"] = remaining;
+				if (printJob->reportedProgress() >= 0)
+					eventObject["percent"] = printJob->reportedProgress();
 			}
 		}
 
@@ -252,11 +290,26 @@ private:
 	{
 		nlohmann::json event;
 
-		event["event"]["Printer." + printer + ".job"] = {
+		nlohmann::json eventObject = {
 			{ "done", progress },
 			{ "elapsed", job->timeElapsed().count() }
 		};
 
+		double timeDone, timeTotal;
+		if (job->timeProgress(timeDone, timeTotal))
+		{
+			eventObject["time_done"] = int(timeDone);
+			eventObject["time_total"] = int(timeTotal);
+		}
+
+		int remaining;
+		if (job->remainingTime(remaining))
+			eventObject["eta"] = remaining;
+		if (job->reportedProgress() >= 0)
+			eventObject["percent"] = job->reportedProgress();
+
+		event["event"]["Printer." + printer + ".job"] = eventObject;
+
 		raiseEvent(event);
 	}
 
@@ -272,6 +325,7 @@ private:
 	PrinterManager& m_printerManager;
 	FileManager& m_fileManager;
 	std::multimap<std::string, boost::signals2::connection> m_subscriptions;
+	std::mutex m_subscriptionsMutex;
 };
 
 void routeWebSockets(WebRouter* router, FileManager& fileManager, PrinterManager& printerManager, AuthManager& authManager)
@@ -24,6 +24,7 @@
 #include "AuthManager.h"
 #include "PluginManager.h"
 #include "CameraManager.h"
+#include "RealtimeScheduling.h"
 #include <signal.h>
 #include <cstring>
 
@@ -69,9 +70,12 @@ static std::string localStoragePath()
 
 void runApp()
 {
+	// Before any thread is started, so that they all inherit the CPUs left for them
+	RealtimeScheduling::configure(RealtimeScheduling::Options::parse(g_config.get_child("Realtime", boost::property_tree::ptree())));
+
 	boost::asio::io_service io;
 	FileManager fileManager(localStoragePath());
-	PrinterManager printerManager(io, g_config);
+	PrinterManager printerManager(g_config);
 	WebServer webServer(io);
 	AuthManager authManager(g_config.get_child("users"));
 	PluginManager pluginManager;
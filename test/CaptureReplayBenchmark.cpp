@@ -0,0 +1,141 @@
+// Protocol engine throughput: records a streaming session against a VirtualPrinter,
+// then replays the capture as fast as possible and times how long the Printer takes for it,
+// along with the heap allocations made per line while streaming.
+// Usage: CaptureReplayBenchmark [-n moves] [-r rounds] [virtual printer options, e.g. checksum_errors=0.01]
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <future>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <boost/filesystem.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+#include "Printer.h"
+#include "SerialCapture.h"
+
+// Made by any thread, the printer's and the replayer's are the only busy ones while streaming
+static std::atomic<size_t> s_allocations{0};
+
+void* operator new(size_t size)
+{
+	s_allocations++;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+// Sends the moves once connected, returns the time from the first one to the last reply.
+// allocations is what was allocated after the moves were queued up.
+static std::chrono::duration<double> run(const std::string& devicePath, const std::vector<std::string>& moves, size_t& allocations, const std::string& capturePath = std::string())
+{
+	boost::asio::io_service io;
+	auto printer = std::make_shared<Printer>(io);
+	std::promise<void> connected, done;
+	std::chrono::steady_clock::time_point start;
+	size_t replies = 0, queued = 0;
+
+	printer->setUniqueName("bench");
+	printer->setDevicePath(devicePath.c_str());
+	printer->setStreaming(true);
+
+	if (!capturePath.empty())
+		printer->startCapture(capturePath);
+
+	printer->stateChangeSignal().connect([&](Printer::State state) {
+		if (state != Printer::State::Connected)
+			return;
+
+		start = std::chrono::steady_clock::now();
+
+		for (const std::string& move : moves)
+		{
+			printer->sendCommand(move.c_str(), [&](const std::vector<std::string>&) {
+				if (++replies == moves.size())
+				{
+					allocations = s_allocations - queued;
+					done.set_value();
+				}
+			});
+		}
+
+		queued = s_allocations;
+	});
+
+	printer->start();
+	std::thread thread([&]() { io.run(); });
+
+	std::future<void> finished = done.get_future();
+	if (finished.wait_for(std::chrono::seconds(120)) != std::future_status::ready)
+		std::cerr << "Timed out after " << replies << " replies" << std::endl;
+
+	std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+	printer->stopCapture();
+	io.post([&]() { printer->stop(); });
+	io.stop();
+	thread.join();
+
+	return duration;
+}
+
+int main(int argc, const char** argv)
+{
+	int count = 20000, rounds = 5;
+	std::string options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			count = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			rounds = std::atoi(argv[++i]);
+		else
+			options = argv[i];
+	}
+
+	// Formatting the debug log of every line would be most of what's measured
+	boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+	std::vector<std::string> moves;
+	for (int i = 0; i < count; i++)
+		moves.push_back("G1 X" + std::to_string(i % 200) + " Y" + std::to_string(i % 150) + " E0.05");
+
+	const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("bench-%%%%%%%%.dpcap")).string();
+	size_t allocations;
+	const auto recorded = run("sim:" + options, moves, allocations, path);
+
+	std::vector<SerialCapture::Record> records;
+	SerialCapture::read(path, records);
+
+	std::cout << count << " moves against sim:" << options << ": " << recorded.count() << " s, "
+		<< records.size() << " records captured\n";
+
+	for (int round = 0; round < rounds; round++)
+	{
+		const auto replayed = run("replay:speed=0,file=" + path, moves, allocations);
+
+		std::cout << "  replay " << (round + 1) << ": " << replayed.count() << " s, "
+			<< (replayed.count() * 1e6 / count) << " us/line, "
+			<< (double(allocations) / count) << " allocations/line\n";
+	}
+
+	boost::filesystem::remove(path);
+	return 0;
+}
@@ -0,0 +1,95 @@
+// Commands sent and fitting speed of GCodeArcFitter compared to the plain file.
+// Usage: GCodeArcFitterBenchmark [-t tolerance] [file.gcode...]
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include "GCodeArcFitter.h"
+#include "GCodeReader.h"
+
+static const int BAUD_RATE = 115200;
+// "N123 " and " *45\n" added by Printer
+static const int FRAMING_BYTES = 10;
+
+int main(int argc, const char** argv)
+{
+	std::vector<std::string> files;
+	double tolerance = 0.05;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			tolerance = std::atof(argv[++i]);
+		else
+			files.push_back(argv[i]);
+	}
+
+	if (files.empty())
+		files.push_back(TEST_DATA_DIR "/sample.gcode");
+
+	for (const std::string& file : files)
+	{
+		std::vector<std::string> lines;
+
+		try
+		{
+			GCodeReader reader(file.c_str());
+			std::string_view line;
+
+			while (reader.nextLine(line))
+				lines.emplace_back(line);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Cannot read " << file << ": " << e.what() << std::endl;
+			return 1;
+		}
+
+		const int rounds = std::max<int>(1, int(2*1000*1000 / (lines.size() + 1)));
+		GCodePipeline::Stats stats;
+		std::string_view line;
+		size_t offset;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int round = 0; round < rounds; round++)
+		{
+			GCodePipeline pipeline;
+
+			pipeline.addStage(std::make_unique<GCodeArcFitter>(tolerance));
+			pipeline.reset(nullptr);
+
+			for (size_t i = 0; i < lines.size(); i++)
+			{
+				pipeline.push(lines[i], i + 1);
+
+				while (pipeline.front(line, offset))
+					pipeline.pop();
+			}
+
+			pipeline.finish();
+			while (pipeline.front(line, offset))
+				pipeline.pop();
+
+			stats = pipeline.stats();
+		}
+
+		std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		const size_t plainBytes = stats.bytesIn + stats.linesIn * FRAMING_BYTES;
+		const size_t fittedBytes = stats.bytesOut + stats.linesOut * FRAMING_BYTES;
+		// 8N1: 10 bits on the wire per byte
+		const double bytesPerSecond = BAUD_RATE / 10.0;
+
+		std::cout << file << " (tolerance " << tolerance << " mm)\n"
+			<< "  plain:   " << stats.linesIn << " lines, " << plainBytes << " bytes, " << (plainBytes / bytesPerSecond) << " s at " << BAUD_RATE << " baud\n"
+			<< "  fitted:  " << stats.linesOut << " lines (" << (100.0 * stats.linesOut / stats.linesIn) << " %), "
+			<< fittedBytes << " bytes, " << (fittedBytes / bytesPerSecond) << " s at " << BAUD_RATE << " baud\n"
+			<< "  fitting: " << (duration.count() * 1e9 / (stats.linesIn * double(rounds))) << " ns/line\n";
+	}
+
+	return 0;
+}
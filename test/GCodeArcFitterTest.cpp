@@ -0,0 +1,258 @@
+#define BOOST_TEST_MODULE GCodeArcFitterTest
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+#include <deque>
+#include <cmath>
+#include "GCodeArcFitter.h"
+#include "GCodeReader.h"
+
+static const double TOLERANCE = 0.05;
+
+static std::vector<std::string> fit(const std::vector<std::string>& input, const GCodeState* state = nullptr)
+{
+	GCodePipeline pipeline;
+	std::vector<std::string> output;
+	std::string_view line;
+	size_t offset;
+
+	pipeline.addStage(std::make_unique<GCodeArcFitter>(TOLERANCE));
+	pipeline.reset(state);
+
+	for (const std::string& line : input)
+		pipeline.push(line, 0);
+	pipeline.finish();
+
+	while (pipeline.front(line, offset))
+	{
+		output.emplace_back(line);
+		pipeline.pop();
+	}
+
+	return output;
+}
+
+// Moves along a circle around (cx, cy), from angle 'from' to 'to' in degrees
+static void circle(std::vector<std::string>& lines, double cx, double cy, double r, double from, double to, int segments, double e)
+{
+	char buf[100];
+
+	for (int i = 1; i <= segments; i++)
+	{
+		const double a = (from + (to - from) * i / segments) * M_PI / 180;
+
+		std::snprintf(buf, sizeof(buf), "G1 X%.3f Y%.3f E%.5f", cx + r * std::cos(a), cy + r * std::sin(a), e);
+		lines.push_back(buf);
+	}
+}
+
+// The command has the parameter, close enough to value
+static bool parameterIs(std::string_view line, char letter, double value)
+{
+	double v;
+	return GCodeState::parameter(line, letter, v) && std::abs(v - value) < 0.001;
+}
+
+BOOST_AUTO_TEST_CASE(TestArcs)
+{
+	// Counter-clockwise quarter circle
+	std::vector<std::string> lines = { "G90", "M83", "G1 X110 Y100 F1800" };
+	circle(lines, 100, 100, 10, 0, 90, 18, 0.01);
+
+	std::vector<std::string> out = fit(lines);
+
+	BOOST_TEST(out.size() == 4);
+	BOOST_TEST(out[2] == lines[2]);
+	BOOST_TEST(out[3].substr(0, 3) == "G3 ");
+	BOOST_TEST(parameterIs(out[3], 'X', 100));
+	BOOST_TEST(parameterIs(out[3], 'Y', 110));
+	BOOST_TEST(parameterIs(out[3], 'I', -10));
+	BOOST_TEST(parameterIs(out[3], 'J', 0));
+	BOOST_TEST(parameterIs(out[3], 'E', 0.18));
+	BOOST_TEST(out[3].find('F') == std::string::npos);
+
+	// Clockwise, with the feedrate on the first move
+	lines = { "G90", "M83", "G1 X100 Y110" };
+	circle(lines, 100, 100, 10, 90, 0, 18, 0.01);
+	lines[3] += " F1200";
+
+	out = fit(lines);
+
+	BOOST_TEST(out.size() == 4);
+	BOOST_TEST(out[3].substr(0, 3) == "G2 ");
+	BOOST_TEST(parameterIs(out[3], 'X', 110));
+	BOOST_TEST(parameterIs(out[3], 'Y', 100));
+	BOOST_TEST(parameterIs(out[3], 'I', 0));
+	BOOST_TEST(parameterIs(out[3], 'J', -10));
+	BOOST_TEST(parameterIs(out[3], 'F', 1200));
+
+	// Relative positioning, absolute extrusion
+	std::vector<std::string> absolute;
+	circle(absolute, 0, 0, 10, 90, 0, 10, 0);
+
+	lines = { "G91", "M82", "G92 E10" };
+	double px = 0, py = 10;
+
+	for (size_t i = 0; i < absolute.size(); i++)
+	{
+		double x, y;
+		char buf[100];
+
+		GCodeState::parameter(absolute[i], 'X', x);
+		GCodeState::parameter(absolute[i], 'Y', y);
+		std::snprintf(buf, sizeof(buf), "G1 X%.3f Y%.3f E%d", x - px, y - py, int(11 + i));
+		lines.push_back(buf);
+
+		px = x;
+		py = y;
+	}
+
+	out = fit(lines);
+
+	BOOST_TEST(out.size() == 4);
+	BOOST_TEST(out[3].substr(0, 3) == "G2 ");
+	BOOST_TEST(parameterIs(out[3], 'X', 10));
+	BOOST_TEST(parameterIs(out[3], 'Y', -10));
+	BOOST_TEST(parameterIs(out[3], 'I', 0));
+	BOOST_TEST(parameterIs(out[3], 'J', -10));
+	BOOST_TEST(parameterIs(out[3], 'E', 20));
+}
+
+BOOST_AUTO_TEST_CASE(TestNoArcs)
+{
+	// Straight lines
+	std::vector<std::string> lines = { "G1 X0 Y0", "G1 X10 Y0 E1", "G1 X20 Y0 E1", "G1 X30 Y0 E1", "G1 X40 Y0 E1" };
+	BOOST_TEST(fit(lines) == lines, boost::test_tools::per_element());
+
+	// The head could be anywhere until the first move
+	lines = { "M83" };
+	circle(lines, 100, 100, 10, 0, 90, 18, 0.01);
+
+	std::vector<std::string> out = fit(lines);
+	BOOST_TEST(out.size() == 3);
+	BOOST_TEST(out[1] == lines[1]);
+	BOOST_TEST(out[2].substr(0, 3) == "G3 ");
+
+	// Too few moves
+	lines = { "M83", "G1 X110 Y100" };
+	circle(lines, 100, 100, 10, 0, 30, 2, 0.01);
+	BOOST_TEST(fit(lines) == lines, boost::test_tools::per_element());
+
+	// Farther off the arc than the tolerance
+	lines = { "M83", "G1 X110 Y100" };
+	circle(lines, 100, 100, 10, 0, 90, 6, 0.01);
+	BOOST_TEST(fit(lines) == lines, boost::test_tools::per_element());
+
+	// A Z move, a feedrate change and an extrusion rate change split the arc
+	lines = { "M83", "G1 X110 Y100" };
+	circle(lines, 100, 100, 10, 0, 180, 36, 0.01);
+	lines[11] += " Z1";
+	lines[21] += " F3000";
+	lines[31].replace(lines[31].rfind('E'), std::string::npos, "E0.02");
+
+	out = fit(lines);
+	BOOST_TEST(out.size() == 8);
+	BOOST_TEST(out[2].substr(0, 3) == "G3 ");
+	BOOST_TEST(out[3] == lines[11]);
+	BOOST_TEST(out[4].substr(0, 3) == "G3 ");
+	BOOST_TEST(out[5].substr(0, 3) == "G3 ");
+	BOOST_TEST(out[5].find("F3000") != std::string::npos);
+	BOOST_TEST(out[6] == lines[31]);
+	BOOST_TEST(out[7].substr(0, 3) == "G3 ");
+}
+
+BOOST_AUTO_TEST_CASE(TestResume)
+{
+	GCodeState state;
+	state.x = 110;
+	state.y = 100;
+	state.extruderRelativePositioning = true;
+
+	std::vector<std::string> lines;
+	circle(lines, 100, 100, 10, 0, 90, 18, 0.01);
+
+	std::vector<std::string> out = fit(lines, &state);
+	BOOST_TEST(out.size() == 1);
+	BOOST_TEST(out[0].substr(0, 3) == "G3 ");
+	BOOST_TEST(parameterIs(out[0], 'I', -10));
+}
+
+// Every point of the file has to be within the tolerance of the arcs replacing it,
+// and the head has to end up in the same place after each line sent
+BOOST_AUTO_TEST_CASE(TestSampleFile)
+{
+	GCodeReader reader(TEST_DATA_DIR "/sample.gcode");
+	GCodePipeline pipeline;
+	GCodeState original, fitted;
+	std::string_view line;
+	size_t offset, arcs = 0, errors = 0;
+
+	struct Point
+	{
+		size_t offset;
+		GCodeState state;
+	};
+	std::deque<Point> pending;
+
+	pipeline.addStage(std::make_unique<GCodeArcFitter>(TOLERANCE));
+	pipeline.reset(nullptr);
+
+	auto check = [&]() {
+		while (pipeline.front(line, offset))
+		{
+			double i = 0, j = 0;
+			const bool arc = line[0] == 'G' && (line[1] == '2' || line[1] == '3');
+
+			if (arc)
+			{
+				GCodeState::parameter(line, 'I', i);
+				GCodeState::parameter(line, 'J', j);
+				arcs++;
+			}
+
+			const double cx = fitted.x + i, cy = fitted.y + j, r = std::hypot(i, j);
+			fitted.apply(line);
+
+			while (!pending.empty() && pending.front().offset <= offset)
+			{
+				const GCodeState& s = pending.front().state;
+
+				if (arc && std::abs(std::hypot(s.x - cx, s.y - cy) - r) > TOLERANCE + 0.001)
+					errors++;
+
+				if (pending.size() == 1 || pending[1].offset > offset)
+				{
+					if (std::abs(s.x - fitted.x) > 1e-4 || std::abs(s.y - fitted.y) > 1e-4 || std::abs(s.z - fitted.z) > 1e-4
+						|| std::abs(s.e - fitted.e) > 1e-4 || s.feedrate != fitted.feedrate)
+					{
+						errors++;
+					}
+				}
+
+				pending.pop_front();
+			}
+
+			pipeline.pop();
+		}
+	};
+
+	while (reader.nextLine(line))
+	{
+		original.apply(line);
+		pending.push_back({ reader.position(), original });
+
+		pipeline.push(line, reader.position());
+		check();
+	}
+
+	pipeline.finish();
+	check();
+
+	BOOST_TEST(errors == 0);
+	BOOST_TEST(pending.empty());
+	BOOST_TEST(arcs > 0);
+
+	const GCodePipeline::Stats& stats = pipeline.stats();
+	BOOST_TEST_MESSAGE("Fitted " << stats.linesIn << " lines to " << stats.linesOut << ", " << arcs << " arcs");
+
+	BOOST_TEST(stats.linesOut < stats.linesIn / 2);
+}
@@ -0,0 +1,162 @@
+#define BOOST_TEST_MODULE GCodeDecimatorTest
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+#include <deque>
+#include <cmath>
+#include "GCodeDecimator.h"
+#include "GCodeReader.h"
+
+static const double TOLERANCE = 0.01;
+
+static std::vector<std::string> decimate(const std::vector<std::string>& input)
+{
+	GCodePipeline pipeline;
+	std::vector<std::string> output;
+	std::string_view line;
+	size_t offset;
+
+	pipeline.addStage(std::make_unique<GCodeDecimator>(TOLERANCE));
+	pipeline.reset(nullptr);
+
+	for (const std::string& line : input)
+		pipeline.push(line, 0);
+	pipeline.finish();
+
+	while (pipeline.front(line, offset))
+	{
+		output.emplace_back(line);
+		pipeline.pop();
+	}
+
+	return output;
+}
+
+BOOST_AUTO_TEST_CASE(TestMerge)
+{
+	// Collinear, the extrusion adds up exactly
+	std::vector<std::string> out = decimate({ "M83", "G1 X0 Y0 F1800", "G1 X1 Y1 E0.01234 F1200", "G1 X2 Y2 E0.01234", "G1 X3.5 Y3.5 E0.01851", "G1 X4 Y4 E0.00617" });
+	std::vector<std::string> expected = { "M83", "G1 X0 Y0 F1800", "G1 X4 Y4 E.04936 F1200" };
+
+	BOOST_TEST(out == expected, boost::test_tools::per_element());
+
+	// Within the tolerance, absolute extrusion
+	out = decimate({ "G1 X0 Y0", "G1 X1 Y0.005 E1", "G1 X2 Y-0.005 E2", "G1 X3 Y0 E3", "G1 X3 Y1 E4" });
+	expected = { "G1 X0 Y0", "G1 X3 Y0 E3", "G1 X3 Y1 E4" };
+
+	BOOST_TEST(out == expected, boost::test_tools::per_element());
+
+	// Relative positioning, travel moves
+	out = decimate({ "G91", "G1 X1 Y0", "G1 X1 Y0", "G1 X0.5 Y0", "G1 Z1" });
+	expected = { "G91", "G1 X2.5 Y0", "G1 Z1" };
+
+	BOOST_TEST(out == expected, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TestNoMerge)
+{
+	// Farther off than the tolerance
+	std::vector<std::string> lines = { "G1 X0 Y0", "G1 X1 Y0.02 E1", "G1 X2 Y0 E2" };
+	BOOST_TEST(decimate(lines) == lines, boost::test_tools::per_element());
+
+	// Back along the same line
+	lines = { "G1 X0 Y0", "G1 X2 Y0", "G1 X1 Y0" };
+	BOOST_TEST(decimate(lines) == lines, boost::test_tools::per_element());
+
+	// Different extrusion rate, feedrate or Z
+	lines = { "M83", "G1 X0 Y0", "G1 X1 Y0 E1", "G1 X2 Y0 E2", "G1 X3 Y0 E2 F3000", "G1 X4 Y0 E2 Z1" };
+	BOOST_TEST(decimate(lines) == lines, boost::test_tools::per_element());
+
+	// The starting point isn't known
+	lines = { "G28", "G1 X1 Y0", "G1 X2 Y0" };
+	BOOST_TEST(decimate(lines) == lines, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TestWindow)
+{
+	std::vector<std::string> lines = { "M83", "G1 X0 Y0" };
+
+	for (size_t i = 1; i <= GCodeDecimator::MAX_SEGMENTS * 2 + 1; i++)
+		lines.push_back("G1 X" + std::to_string(i) + " Y0 E1");
+
+	std::vector<std::string> out = decimate(lines);
+	std::vector<std::string> expected = { "M83", "G1 X0 Y0", "G1 X32 Y0 E32", "G1 X64 Y0 E32", lines.back() };
+
+	BOOST_TEST(out == expected, boost::test_tools::per_element());
+}
+
+// Every point of the file has to be within the tolerance of the moves replacing it,
+// and the head has to end up in the same place after each line sent
+BOOST_AUTO_TEST_CASE(TestSampleFile)
+{
+	GCodeReader reader(TEST_DATA_DIR "/sample.gcode");
+	GCodePipeline pipeline;
+	GCodeState original, decimated;
+	std::string_view line;
+	size_t offset, errors = 0;
+
+	struct Point
+	{
+		size_t offset;
+		GCodeState state;
+	};
+	std::deque<Point> pending;
+
+	pipeline.addStage(std::make_unique<GCodeDecimator>(TOLERANCE));
+	pipeline.reset(nullptr);
+
+	auto check = [&]() {
+		while (pipeline.front(line, offset))
+		{
+			const double sx = decimated.x, sy = decimated.y;
+
+			decimated.apply(line);
+
+			const double dx = decimated.x - sx, dy = decimated.y - sy, length = std::hypot(dx, dy);
+
+			while (!pending.empty() && pending.front().offset <= offset)
+			{
+				const GCodeState& s = pending.front().state;
+
+				if (length > 0 && std::abs((s.x - sx) * dy - (s.y - sy) * dx) / length > TOLERANCE + 0.0001)
+					errors++;
+
+				if (pending.size() == 1 || pending[1].offset > offset)
+				{
+					if (std::abs(s.x - decimated.x) > 1e-4 || std::abs(s.y - decimated.y) > 1e-4 || std::abs(s.z - decimated.z) > 1e-4
+						|| std::abs(s.e - decimated.e) > 1e-6 || s.feedrate != decimated.feedrate)
+					{
+						errors++;
+					}
+				}
+
+				pending.pop_front();
+			}
+
+			pipeline.pop();
+		}
+	};
+
+	while (reader.nextLine(line))
+	{
+		original.apply(line);
+		pending.push_back({ reader.position(), original });
+
+		pipeline.push(line, reader.position());
+		check();
+	}
+
+	pipeline.finish();
+	check();
+
+	BOOST_TEST(errors == 0);
+	BOOST_TEST(pending.empty());
+
+	const GCodePipeline::Stats& stats = pipeline.stats();
+	BOOST_TEST_MESSAGE("Decimated " << stats.linesIn << " lines to " << stats.linesOut);
+
+	BOOST_TEST(stats.stages.size() == 1);
+	BOOST_TEST(stats.stages[0].name == "decimation");
+	BOOST_TEST(stats.stages[0].linesIn == stats.linesIn);
+	BOOST_TEST(stats.stages[0].linesOut == stats.linesOut);
+	BOOST_TEST(stats.linesOut < stats.linesIn);
+}
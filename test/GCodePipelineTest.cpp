@@ -0,0 +1,228 @@
+#define BOOST_TEST_MODULE GCodePipelineTest
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+#include <cmath>
+#include "GCodePipeline.h"
+#include "GCodeCompactor.h"
+#include "GCodeReader.h"
+
+typedef std::vector<std::pair<std::string, size_t>> Lines;
+
+static Lines drain(GCodePipeline& pipeline)
+{
+	Lines lines;
+	std::string_view line;
+	size_t offset;
+
+	while (pipeline.front(line, offset))
+	{
+		lines.emplace_back(line, offset);
+		pipeline.pop();
+	}
+
+	return lines;
+}
+
+static std::vector<std::string> compact(const std::vector<std::string>& input, const GCodeState* state = nullptr)
+{
+	GCodePipeline pipeline;
+	std::vector<std::string> output;
+
+	pipeline.addStage(std::make_unique<GCodeCompactor>());
+	pipeline.reset(state);
+
+	for (const std::string& line : input)
+		pipeline.push(line, 0);
+
+	for (auto& line : drain(pipeline))
+		output.push_back(line.first);
+
+	return output;
+}
+
+// Holds every other line back and emits the pair together
+class PairingStage : public GCodeStage
+{
+public:
+	const char* name() const override { return "pairing"; }
+	void process(std::string_view line, size_t endOffset, Output& out) override
+	{
+		if (m_held.empty())
+		{
+			m_held = line;
+			return;
+		}
+
+		out.line(m_held, endOffset);
+		out.line(line, endOffset);
+		m_held.clear();
+	}
+	void finish(Output& out) override
+	{
+		if (!m_held.empty())
+			out.line(m_held, 0);
+		m_held.clear();
+	}
+	void reset(const GCodeState*) override
+	{
+		m_held.clear();
+	}
+private:
+	std::string m_held;
+};
+
+BOOST_AUTO_TEST_CASE(TestQueue)
+{
+	GCodePipeline pipeline;
+
+	pipeline.addStage(std::make_unique<PairingStage>());
+	pipeline.reset(nullptr);
+
+	// More than the queue holds initially
+	for (int i = 0; i < 41; i++)
+		pipeline.push("G1 X" + std::to_string(i), i + 1);
+
+	Lines lines = drain(pipeline);
+
+	BOOST_TEST(lines.size() == 40);
+	BOOST_TEST(lines[0].first == "G1 X0");
+	BOOST_TEST(lines[0].second == 2);
+	BOOST_TEST(lines[39].first == "G1 X39");
+	BOOST_TEST(lines[39].second == 40);
+
+	pipeline.finish();
+	lines = drain(pipeline);
+
+	BOOST_TEST(lines.size() == 1);
+	BOOST_TEST(lines[0].first == "G1 X40");
+
+	BOOST_TEST(pipeline.stats().linesIn == 41);
+	BOOST_TEST(pipeline.stats().linesOut == 41);
+	BOOST_TEST(pipeline.stats().bytesIn == pipeline.stats().bytesOut);
+
+	BOOST_TEST(pipeline.stats().stages.size() == 1);
+	BOOST_TEST(pipeline.stats().stages[0].name == "pairing");
+	BOOST_TEST(pipeline.stats().stages[0].linesIn == 41);
+	BOOST_TEST(pipeline.stats().stages[0].linesOut == 41);
+}
+
+BOOST_AUTO_TEST_CASE(TestNumbers)
+{
+	auto fmt = [](double value, int decimals) {
+		std::string out;
+		GCodeCompactor::formatNumber(value, decimals, out);
+		return out;
+	};
+
+	BOOST_TEST(fmt(10, 3) == "10");
+	BOOST_TEST(fmt(10.500, 3) == "10.5");
+	BOOST_TEST(fmt(0.25, 3) == ".25");
+	BOOST_TEST(fmt(-0.25, 3) == "-.25");
+	BOOST_TEST(fmt(0, 3) == "0");
+	BOOST_TEST(fmt(-0.0001, 3) == "0");
+	BOOST_TEST(fmt(1.0005, 3) == "1.001");
+	BOOST_TEST(fmt(0.04635, 5) == ".04635");
+	BOOST_TEST(fmt(0.010, 3) == ".01");
+	BOOST_TEST(fmt(119.9999, 3) == "120");
+	BOOST_TEST(fmt(1800.4, 0) == "1800");
+}
+
+BOOST_AUTO_TEST_CASE(TestCompaction)
+{
+	std::vector<std::string> out = compact({
+		"G1 Z0.200 F720",
+		"G1 X120.000 Y100.000 F9000",
+		"G1 F9000",
+		"G1 X119.951 Y101.395 E0.04635 F9000",
+		"G1 X119.805 Y102.783 E0.04635",
+		"M117 Layer 1.000",
+		"G1 X+1.5",
+		"G1 X10 F9000.0001",
+		"G28 X",
+		"G1 X20 F9000",
+	});
+
+	// The first F has to be sent as it is unknown
+	std::vector<std::string> expected = {
+		"G1Z.2F720",
+		"G1X120Y100F9000",
+		"G1X119.951Y101.395E.04635",
+		"G1X119.805Y102.783E.04635",
+		"M117 Layer 1.000",
+		"G1X1.5",
+		"G1X10",
+		"G28 X",
+		"G1X20F9000",
+	};
+
+	BOOST_TEST(out == expected, boost::test_tools::per_element());
+
+	// Anything that isn't a plain number makes it leave the line alone
+	out = compact({ "G1 F1000", "G1 X1 Y F1000", "G1 X1 F1000" });
+	expected = { "G1F1000", "G1 X1 Y F1000", "G1X1F1000" };
+
+	BOOST_TEST(out == expected, boost::test_tools::per_element());
+
+	// Resuming restores the feedrate
+	GCodeState state;
+	state.feedrate = 1800;
+
+	out = compact({ "G1 X1 F1800" }, &state);
+	BOOST_TEST(out.size() == 1);
+	BOOST_TEST(out[0] == "G1X1");
+}
+
+// "G1X1.5Y2" -> "G1 X1.5 Y2", so that GCodeState understands it
+static std::string expand(std::string_view line)
+{
+	std::string out;
+
+	for (size_t i = 0; i < line.length(); i++)
+	{
+		if (i > 1 && line[i] >= 'A' && line[i] <= 'Z' && line[i - 1] != ' ')
+			out += ' ';
+		out += line[i];
+	}
+
+	return out;
+}
+
+BOOST_AUTO_TEST_CASE(TestSampleFile)
+{
+	GCodeReader reader(TEST_DATA_DIR "/sample.gcode");
+	GCodePipeline pipeline;
+	GCodeState original, compacted;
+	std::string_view line;
+	size_t mismatches = 0;
+
+	pipeline.addStage(std::make_unique<GCodeCompactor>());
+	pipeline.reset(nullptr);
+
+	while (reader.nextLine(line))
+	{
+		original.apply(line);
+		pipeline.push(line, reader.position());
+
+		// Dropped lines only ever repeat the feedrate
+		for (auto& out : drain(pipeline))
+		{
+			compacted.apply(out.first[0] == 'G' ? expand(out.first) : out.first);
+			BOOST_TEST(out.second == reader.position());
+		}
+
+		if (std::abs(original.x - compacted.x) > 0.0005 || std::abs(original.y - compacted.y) > 0.0005
+			|| std::abs(original.z - compacted.z) > 0.0005 || std::abs(original.e - compacted.e) > 0.00001
+			|| original.feedrate != compacted.feedrate)
+		{
+			mismatches++;
+		}
+	}
+
+	BOOST_TEST(mismatches == 0);
+
+	const GCodePipeline::Stats& stats = pipeline.stats();
+	BOOST_TEST_MESSAGE("Compacted " << stats.bytesIn << " bytes to " << stats.bytesOut << ", " << stats.linesIn << " lines to " << stats.linesOut);
+
+	BOOST_TEST(stats.linesOut <= stats.linesIn);
+	BOOST_TEST(stats.bytesOut < stats.bytesIn * 0.8);
+}
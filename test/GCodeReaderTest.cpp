@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE GCodeReaderTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include "GCodeReader.h"
+
+struct TempFile
+{
+	TempFile(const std::string& contents)
+	{
+		path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+		std::ofstream(path.string(), std::ios::binary) << contents;
+	}
+	~TempFile()
+	{
+		boost::filesystem::remove(path);
+	}
+	boost::filesystem::path path;
+};
+
+BOOST_AUTO_TEST_CASE(TestNextLine)
+{
+	TempFile file("; header\nG28 ; home\n\n  G1 X10\t\r\n;\nM84");
+	GCodeReader reader(file.path.c_str());
+	std::string_view line;
+
+	BOOST_TEST(reader.nextLine(line));
+	BOOST_TEST(line == "G28");
+	BOOST_TEST(reader.position() == 20u);
+
+	BOOST_TEST(reader.nextLine(line));
+	BOOST_TEST(line == "G1 X10");
+
+	BOOST_TEST(reader.nextLine(line));
+	BOOST_TEST(line == "M84");
+	BOOST_TEST(reader.position() == reader.size());
+
+	BOOST_TEST(!reader.nextLine(line));
+
+	reader.seek(15);
+	BOOST_TEST(reader.nextLine(line));
+	BOOST_TEST(line == "G28");
+}
+
+BOOST_AUTO_TEST_CASE(TestLineIndex)
+{
+	std::string contents;
+	std::vector<size_t> offsets;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		offsets.push_back(contents.length());
+		contents += (i % 7 == 0) ? ";comment\n" : "G1 X" + std::to_string(i) + "\n";
+	}
+
+	TempFile file(contents);
+	GCodeReader reader(file.path.c_str());
+
+	BOOST_TEST(reader.lineCount() == 1000u);
+
+	for (size_t i = 0; i < offsets.size(); i++)
+	{
+		BOOST_TEST(reader.lineOffset(i) == offsets[i]);
+		BOOST_TEST(reader.lineAt(offsets[i]) == i);
+		BOOST_TEST(reader.lineAt(offsets[i] + 2) == i);
+	}
+
+	BOOST_TEST(reader.lineOffset(1000) == contents.length());
+
+	std::string_view line;
+	reader.seekToLine(500);
+	BOOST_TEST(reader.nextLine(line));
+	BOOST_TEST(line == "G1 X500");
+}
+
+BOOST_AUTO_TEST_CASE(TestEmptyFile)
+{
+	TempFile file("");
+	GCodeReader reader(file.path.c_str());
+	std::string_view line;
+
+	BOOST_TEST(reader.size() == 0u);
+	BOOST_TEST(!reader.nextLine(line));
+	BOOST_TEST(reader.lineCount() == 0u);
+}
@@ -0,0 +1,64 @@
+#define BOOST_TEST_MODULE GCodeStateTest
+#include <boost/test/included/unit_test.hpp>
+#include "GCodeState.h"
+
+BOOST_AUTO_TEST_CASE(TestParameter)
+{
+	double value;
+
+	BOOST_TEST(GCodeState::parameter("G1 X10.5 Y-3 E+0.25", 'X', value));
+	BOOST_TEST(value == 10.5);
+	BOOST_TEST(GCodeState::parameter("G1 X10.5 Y-3 E+0.25", 'Y', value));
+	BOOST_TEST(value == -3);
+	BOOST_TEST(GCodeState::parameter("G1 X10.5 Y-3 E+0.25", 'E', value));
+	BOOST_TEST(value == 0.25);
+	BOOST_TEST(!GCodeState::parameter("G1 X10.5 Y-3 E+0.25", 'Z', value));
+	BOOST_TEST(!GCodeState::parameter("G28", 'X', value));
+}
+
+BOOST_AUTO_TEST_CASE(TestApply)
+{
+	GCodeState state;
+
+	for (const char* line : { "M140 S60", "M104 S210", "G28", "G90", "M82", "G92 E0",
+		"G1 Z0.3 F3000", "G1 X10 Y10 E1.5 F1200", "M106 S127", "G91", "G1 X5 E0.5", "M83", "G1 E-1" })
+	{
+		state.apply(line);
+	}
+
+	BOOST_TEST(state.bedTarget == 60);
+	BOOST_TEST(state.hotendTarget == 210);
+	BOOST_TEST(state.relativePositioning);
+	BOOST_TEST(state.extruderRelativePositioning);
+	BOOST_TEST(state.x == 15);
+	BOOST_TEST(state.y == 10);
+	BOOST_TEST(state.z == 0.3);
+	BOOST_TEST(state.e == 1);
+	BOOST_TEST(state.feedrate == 1200);
+	BOOST_TEST(state.fanSpeed == 127);
+
+	state.apply("M107");
+	state.apply("G92 E100");
+	BOOST_TEST(state.fanSpeed == 0);
+	BOOST_TEST(state.e == 100);
+}
+
+BOOST_AUTO_TEST_CASE(TestResumeCommands)
+{
+	GCodeState state;
+	std::vector<std::string> commands;
+
+	state.apply("M190 S60");
+	state.apply("M109 S215");
+	state.apply("G1 X20 Y30 Z1.2 E50 F1800");
+	state.resumeCommands(commands);
+
+	const std::vector<std::string> expected = {
+		"M140 S60.000", "M104 S215.000", "M190 S60.000", "M109 S215.000",
+		"G92 Z1.200", "G91", "G0 Z2", "G90", "G28 X Y",
+		"G0 X20.000 Y30.000 F3000", "G0 Z1.200", "G92 E50.000",
+		"M107", "M82", "G1 F1800.000"
+	};
+
+	BOOST_TEST(commands == expected, boost::test_tools::per_element());
+}
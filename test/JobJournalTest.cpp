@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE JobJournalTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include "JobJournal.h"
+
+static std::string tempPath()
+{
+	return (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+}
+
+BOOST_AUTO_TEST_CASE(TestRoundTrip)
+{
+	const std::string path = tempPath();
+	JobJournal::Contents contents;
+
+	{
+		JobJournal journal(path, "benchy.gcode", 123456);
+		JobJournal::Entry entry;
+
+		entry.offset = 1000;
+		journal.update(entry);
+
+		entry.offset = 2000;
+		entry.extruderRelativePositioning = true;
+		entry.hotendTarget = 215;
+		entry.bedTarget = 60;
+		journal.update(entry);
+	}
+
+	BOOST_TEST(JobJournal::read(path, contents));
+	BOOST_TEST(contents.jobName == "benchy.gcode");
+	BOOST_TEST(contents.fileSize == 123456u);
+	BOOST_TEST(contents.entry.offset == 2000u);
+	BOOST_TEST(!contents.entry.relativePositioning);
+	BOOST_TEST(contents.entry.extruderRelativePositioning);
+	BOOST_TEST(contents.entry.hotendTarget == 215);
+	BOOST_TEST(contents.entry.bedTarget == 60);
+
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestTornSlot)
+{
+	const std::string path = tempPath();
+	JobJournal::Contents contents;
+
+	{
+		JobJournal journal(path, "benchy.gcode", 123456);
+		JobJournal::Entry entry;
+
+		for (uint64_t offset : { 100, 200, 300 })
+		{
+			entry.offset = offset;
+			journal.update(entry);
+
+			// Let the writer catch up, so that every entry is written out
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+	}
+
+	// Corrupt the newest entry (the 3rd one lives in the 2nd slot)
+	{
+		std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(4096 + 512 + 20);
+		file.put('\xff');
+	}
+
+	BOOST_TEST(JobJournal::read(path, contents));
+	BOOST_TEST(contents.entry.offset == 200u);
+
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestRemove)
+{
+	const std::string path = tempPath();
+	JobJournal::Contents contents;
+
+	JobJournal journal(path, "benchy.gcode", 123456);
+	journal.remove();
+
+	BOOST_TEST(!JobJournal::read(path, contents));
+}
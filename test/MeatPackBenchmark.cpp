@@ -0,0 +1,108 @@
+// Wire bytes and encoding speed of MeatPack compared to plain G-code, as Printer would send it.
+// Usage: MeatPackBenchmark [file.gcode...]
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include "MeatPack.h"
+#include "GCodeReader.h"
+
+static const int BAUD_RATE = 115200;
+
+static unsigned int checksum(std::string_view cmd)
+{
+	unsigned int cs = 0;
+
+	for (char c : cmd)
+		cs ^= unsigned(c);
+
+	return cs & 0xff;
+}
+
+// Numbered lines with checksums, like Printer::encodeCommand()
+static std::vector<std::string> encodeFile(const char* path)
+{
+	GCodeReader reader(path);
+	std::vector<std::string> lines;
+	std::string_view line;
+	char buf[32];
+	int lineNo = 1;
+
+	while (reader.nextLine(line))
+	{
+		std::snprintf(buf, sizeof(buf), "N%d ", lineNo++);
+
+		std::string out = buf;
+		out += line;
+		out += ' ';
+		std::snprintf(buf, sizeof(buf), "*%u\n", checksum(out));
+		out += buf;
+
+		lines.push_back(std::move(out));
+	}
+
+	return lines;
+}
+
+int main(int argc, const char** argv)
+{
+	std::vector<std::string> files;
+
+	for (int i = 1; i < argc; i++)
+		files.push_back(argv[i]);
+
+	if (files.empty())
+		files.push_back(TEST_DATA_DIR "/sample.gcode");
+
+	for (const std::string& file : files)
+	{
+		std::vector<std::string> lines;
+
+		try
+		{
+			lines = encodeFile(file.c_str());
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Cannot read " << file << ": " << e.what() << std::endl;
+			return 1;
+		}
+
+		size_t plainBytes = 0, packedBytes = 0;
+		std::string packed;
+		const int rounds = std::max<int>(1, int(64*1024*1024 / (lines.size() * 32 + 1)));
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int round = 0; round < rounds; round++)
+		{
+			packedBytes = 0;
+			for (const std::string& line : lines)
+			{
+				// Reused like Printer's buffer
+				packed.clear();
+				MeatPack::pack(line, packed);
+				packedBytes += packed.length();
+			}
+		}
+
+		std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		for (const std::string& line : lines)
+			plainBytes += line.length();
+
+		// 8N1: 10 bits on the wire per byte
+		const double bytesPerSecond = BAUD_RATE / 10.0;
+
+		std::cout << file << " (" << lines.size() << " lines)\n"
+			<< "  plain:    " << plainBytes << " bytes, " << int(lines.size() / (plainBytes / bytesPerSecond)) << " lines/s at " << BAUD_RATE << " baud\n"
+			<< "  meatpack: " << packedBytes << " bytes (" << (100.0 * packedBytes / plainBytes) << " %), "
+			<< int(lines.size() / (packedBytes / bytesPerSecond)) << " lines/s at " << BAUD_RATE << " baud\n"
+			<< "  encoding: " << (plainBytes * rounds / duration.count() / 1024 / 1024) << " MiB/s, "
+			<< (duration.count() * 1e9 / (lines.size() * rounds)) << " ns/line\n";
+	}
+
+	return 0;
+}
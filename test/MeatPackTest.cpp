@@ -0,0 +1,66 @@
+#define BOOST_TEST_MODULE MeatPackTest
+#include <boost/test/included/unit_test.hpp>
+#include <fstream>
+#include "MeatPack.h"
+
+static std::string pack(std::string_view line)
+{
+	std::string out;
+	MeatPack::pack(line, out);
+	return out;
+}
+
+BOOST_AUTO_TEST_CASE(TestEncoding)
+{
+	// Two characters per byte, the first one in the low nibble
+	BOOST_TEST(pack("G1 X10\n") == std::string("\x1d\xeb\x01\xbc"));
+
+	// Characters without a code follow the byte in full
+	BOOST_TEST(pack("N1\n") == std::string("\x1f" "N" "\xbc"));
+	BOOST_TEST(pack("G1 E2\n") == std::string("\x1d\xfb" "E" "\xc2"));
+	BOOST_TEST(pack("M1*\n") == std::string("\x1f" "M" "\xcf" "*"));
+	BOOST_TEST(pack("MY\n") == std::string("\xff" "MY" "\xbc"));
+}
+
+BOOST_AUTO_TEST_CASE(TestSignals)
+{
+	MeatPack::Unpacker unpacker;
+	std::string out, data;
+
+	data = "M110 N0\n";
+	data += MeatPack::ENABLE;
+	data += pack("N1 G1 X1.5 Y2 E0.1*99\n");
+	data += pack("N2 M115*37\n");
+	data += MeatPack::DISABLE;
+	data += "N3 M112*20\n";
+	data += MeatPack::ENABLE;
+	data += pack("N4 G28\n");
+
+	unpacker.feed(data, out);
+
+	BOOST_TEST(unpacker.active());
+	BOOST_TEST(out == "M110 N0\nN1 G1 X1.5 Y2 E0.1*99\nN2 M115*37\nN3 M112*20\nN4 G28\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestRoundTrip)
+{
+	std::ifstream in(TEST_DATA_DIR "/sample.gcode");
+	MeatPack::Unpacker unpacker;
+	std::string line, plain, packed(MeatPack::ENABLE), out;
+
+	BOOST_TEST_REQUIRE(in.is_open());
+
+	while (std::getline(in, line))
+	{
+		line += '\n';
+		plain += line;
+		MeatPack::pack(line, packed);
+	}
+
+	// Byte by byte, as it could arrive
+	for (char c : packed)
+		unpacker.feed(std::string_view(&c, 1), out);
+
+	BOOST_TEST(out == plain);
+	BOOST_TEST(packed.length() < plain.length() * 0.7);
+}
@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE PrinterProbeTest
+#include <boost/test/included/unit_test.hpp>
+#include "PrinterProbe.h"
+#include "VirtualPrinter.h"
+#include "IoThread.h"
+#include <memory>
+#include <unistd.h>
+
+// Virtual printers understanding only the given baud rates (0 for any), on a thread of their own
+class Printers
+{
+public:
+	Printers(const std::vector<int>& baudRates)
+	: m_thread("simulators")
+	{
+		for (int rate : baudRates)
+		{
+			VirtualPrinter::Options options;
+			options.baudRate = rate;
+			options.thermalTimeConstant = 0;
+			m_printers.push_back(std::make_unique<VirtualPrinter>(m_thread.io(), options));
+		}
+	}
+	~Printers()
+	{
+		m_thread.stop();
+	}
+
+	std::vector<std::string> devicePaths() const
+	{
+		std::vector<std::string> paths;
+
+		for (const auto& printer : m_printers)
+			paths.push_back(printer->devicePath());
+		return paths;
+	}
+private:
+	IoThread m_thread;
+	std::vector<std::unique_ptr<VirtualPrinter>> m_printers;
+};
+
+BOOST_AUTO_TEST_CASE(TestProbe)
+{
+	Printers printers({ 0, 250000, 57600, 500000 });
+	std::vector<std::string> paths = printers.devicePaths();
+
+	paths.push_back("/dev/nonexistent-printer");
+
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<PrinterProbe::Result> results = PrinterProbe::probe(paths);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	BOOST_REQUIRE(results.size() == 5u);
+
+	// The first rate tried
+	BOOST_TEST(results[0].baudRate == 115200);
+	BOOST_TEST(results[1].baudRate == 250000);
+	BOOST_TEST(results[2].baudRate == 57600);
+	BOOST_TEST(results[3].baudRate == 500000);
+
+	for (int i = 0; i < 4; i++)
+	{
+		BOOST_TEST(results[i].devicePath == paths[i]);
+		BOOST_TEST(results[i].error.empty());
+		BOOST_TEST(results[i].firmwareName == "Marlin dashprint virtual printer");
+		BOOST_TEST(results[i].firmwareInfo["MACHINE_TYPE"] == "Virtual");
+		BOOST_TEST(results[i].firmwareInfo["Cap:AUTOREPORT_TEMP"] == "1");
+	}
+
+	BOOST_TEST(!results[4].found());
+	BOOST_TEST(!results[4].error.empty());
+
+	// All at once, 500000 is fifth in line
+	BOOST_TEST(elapsed < 2000);
+}
+
+BOOST_AUTO_TEST_CASE(TestNoReply)
+{
+	std::string path;
+	const int master = VirtualPrinter::openPseudoTerminal(path);
+
+	PrinterProbe::Options options;
+	options.deadline = std::chrono::milliseconds(600);
+
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<PrinterProbe::Result> results = PrinterProbe::probe({ path }, options);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+	BOOST_REQUIRE(results.size() == 1u);
+	BOOST_TEST(!results[0].found());
+	BOOST_TEST(results[0].error.empty());
+	BOOST_TEST(elapsed >= 600);
+	BOOST_TEST(elapsed < 1000);
+
+	::close(master);
+}
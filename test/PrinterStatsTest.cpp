@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE PrinterStatsTest
+#include <boost/test/included/unit_test.hpp>
+#include "PrinterStats.h"
+
+using std::chrono::microseconds;
+
+BOOST_AUTO_TEST_CASE(TestHistogramSmall)
+{
+	LatencyHistogram histogram;
+
+	for (int i = 1; i <= 20; i++)
+		histogram.record(microseconds(i));
+
+	// Exact below 32 us
+	BOOST_TEST(histogram.count() == 20u);
+	BOOST_TEST(histogram.min().count() == 1);
+	BOOST_TEST(histogram.max().count() == 20);
+	BOOST_TEST(histogram.mean().count() == 10);
+	BOOST_TEST(histogram.percentile(50).count() == 10);
+	BOOST_TEST(histogram.percentile(100).count() == 20);
+	BOOST_TEST(histogram.percentile(0).count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestHistogramPrecision)
+{
+	LatencyHistogram histogram;
+
+	// 1 ms to 1 s
+	for (int i = 1; i <= 1000; i++)
+		histogram.record(microseconds(i * 1000));
+
+	for (double percent : { 10.0, 50.0, 90.0, 99.0, 99.9 })
+	{
+		const double expected = percent * 10 * 1000;
+		const double actual = histogram.percentile(percent).count();
+
+		BOOST_TEST(actual >= expected);
+		BOOST_TEST(actual <= expected * (1 + 1.0 / LatencyHistogram::SUB_BUCKETS));
+	}
+
+	BOOST_TEST(histogram.percentile(100).count() == 1000000);
+
+	// Clamped into the last bucket
+	histogram.record(microseconds(int64_t(1) << 50));
+	BOOST_TEST(histogram.max().count() == int64_t(1) << 50);
+	BOOST_TEST(histogram.count() == 1001u);
+}
+
+BOOST_AUTO_TEST_CASE(TestHistogramEmpty)
+{
+	LatencyHistogram histogram;
+
+	BOOST_TEST(histogram.count() == 0u);
+	BOOST_TEST(histogram.min().count() == 0);
+	BOOST_TEST(histogram.mean().count() == 0);
+	BOOST_TEST(histogram.percentile(99).count() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestCommandKey)
+{
+	BOOST_TEST(PrinterStats::commandKey("G1 X10 Y5") == "G1");
+	BOOST_TEST(PrinterStats::commandKey("G1X10Y5") == "G1");
+	BOOST_TEST(PrinterStats::commandKey("M105") == "M105");
+	BOOST_TEST(PrinterStats::commandKey("T0") == "T0");
+	BOOST_TEST(PrinterStats::commandKey("@pause now") == "@pause");
+
+	PrinterStats stats;
+	BOOST_TEST(stats.roundTrip().count() == 0);
+
+	stats.recordLatency("G1 X1", microseconds(100));
+	stats.recordLatency("G1X2", microseconds(300));
+	stats.recordLatency("M105", microseconds(5000));
+
+	BOOST_TEST(stats.latencies.size() == 2u);
+	BOOST_TEST(stats.latencies["G1"].count() == 2u);
+	BOOST_TEST(stats.latencies["G1"].mean().count() == 200);
+	BOOST_TEST(stats.roundTrip().count() == 100);
+
+	stats.recordQueueDepth(5, 3);
+	stats.recordQueueDepth(1, 4);
+	BOOST_TEST(stats.queuedCommands == 1u);
+	BOOST_TEST(stats.maxQueuedCommands == 5u);
+	BOOST_TEST(stats.maxInFlight == 4u);
+}
@@ -5,6 +5,17 @@
 #define BOOST_TEST_MODULE PrinterTest
 #include <boost/test/included/unit_test.hpp>
 #include "Printer.h"
+#include "PrintJob.h"
+#include "SerialCapture.h"
+#include "MeatPack.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <map>
 
 BOOST_AUTO_TEST_CASE(TestKVParse)
 {
@@ -16,3 +27,1044 @@ BOOST_AUTO_TEST_CASE(TestKVParse)
 	BOOST_TEST(kv["FIRMWARE_NAME"] == "Marlin V1.0.2; Sprinter/grbl mashup for gen6");
 	BOOST_TEST(kv["FIRMWARE_URL"] == "https://github.com/prusa3d/Prusa-i3-Plus/");
 }
+
+BOOST_AUTO_TEST_CASE(TestFirmwareInfo)
+{
+	std::vector<std::string> reply = {
+		"FIRMWARE_NAME:Marlin 2.1.2.1 (Github) SOURCE_CODE_URL:github.com/MarlinFirmware/Marlin PROTOCOL_VERSION:1.0 MACHINE_TYPE:Ender-3 EXTRUDER_COUNT:1",
+		"Cap:SERIAL_XON_XOFF:0",
+		"Cap:AUTOREPORT_TEMP:1",
+		"Cap:MEATPACK:1",
+		"ok"
+	};
+	std::map<std::string,std::string> values;
+
+	Printer::parseFirmwareInfo(reply, values);
+
+	BOOST_TEST(values["FIRMWARE_NAME"] == "Marlin 2.1.2.1 (Github)");
+	BOOST_TEST(values["EXTRUDER_COUNT"] == "1");
+	BOOST_TEST(values["Cap:SERIAL_XON_XOFF"] == "0");
+	BOOST_TEST(values["Cap:AUTOREPORT_TEMP"] == "1");
+	BOOST_TEST(values["Cap:MEATPACK"] == "1");
+	BOOST_TEST(values.count("ok") == 0u);
+}
+
+// A Printer on its own thread, connected to a VirtualPrinter or a CaptureReplayer
+class SimulatedPrinter
+{
+public:
+	SimulatedPrinter(const std::string& devicePath, bool streaming, const std::string& capturePath = std::string())
+	{
+		m_printer = std::make_shared<Printer>();
+
+		m_printer->stateChangeSignal().connect([this](Printer::State state) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_state = state;
+			m_cv.notify_all();
+		});
+		// Raised once the printer's temperatures have been updated
+		m_printer->temperatureChangeSignal().connect([this](std::map<std::string, float>) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.notify_all();
+		});
+		// Lines as written and received, see gcode()
+		m_printer->gcodeSignal().connect([this](const Printer::GCodeEvent& event) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_gcode.push_back(event);
+			m_cv.notify_all();
+		});
+
+		run([&]() {
+			m_printer->setUniqueName("sim");
+			m_printer->setDevicePath(devicePath.c_str());
+			m_printer->setStreaming(streaming);
+
+			if (!capturePath.empty())
+				m_printer->startCapture(capturePath);
+
+			m_printer->start();
+		});
+	}
+	~SimulatedPrinter()
+	{
+		run([this]() { m_printer->stop(); });
+		// While the state handler can still run
+		m_printer.reset();
+	}
+
+	bool waitForState(Printer::State state)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_cv.wait_for(lock, std::chrono::seconds(10), [&]() { return m_state == state; });
+	}
+
+	// Waits until a temperature change leaves pred() true, pred() is also checked right away
+	bool waitForTemperatures(std::function<bool(const std::map<std::string, Printer::Temperature>&)> pred)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_cv.wait_for(lock, std::chrono::seconds(10), [&]() { return pred(m_printer->getTemperatures()); });
+	}
+
+	// Sends the commands and waits for their replies, returns the number of replies
+	int sendAll(const std::vector<std::string>& commands)
+	{
+		m_replies = 0;
+
+		for (const std::string& cmd : commands)
+		{
+			m_printer->sendCommand(cmd.c_str(), [this](const std::vector<std::string>& reply) {
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if (!reply.empty())
+					m_lastReply = reply.back();
+				m_replies++;
+				m_cv.notify_all();
+			});
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait_for(lock, std::chrono::seconds(20), [&]() { return m_replies == int(commands.size()) || m_state == Printer::State::Error; });
+		return m_replies;
+	}
+
+	// Waits until pred() is true for the lines written and received so far
+	bool waitForGCode(std::function<bool(const std::vector<Printer::GCodeEvent>&)> pred, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_cv.wait_for(lock, timeout, [&]() { return pred(m_gcode); });
+	}
+
+	std::vector<Printer::GCodeEvent> gcode()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_gcode;
+	}
+
+	// Runs fn on the printer's thread and waits for it
+	void run(std::function<void()> fn)
+	{
+		m_printer->call(fn);
+	}
+
+	Printer& printer() { return *m_printer; }
+	std::shared_ptr<Printer> sharedPrinter() { return m_printer; }
+	// Last line of the last reply received by sendAll()
+	std::string lastReply()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_lastReply;
+	}
+private:
+	std::shared_ptr<Printer> m_printer;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	Printer::State m_state = Printer::State::Stopped;
+	int m_replies = 0;
+	std::string m_lastReply;
+	std::vector<Printer::GCodeEvent> m_gcode;
+};
+
+// A print job of the given lines on a SimulatedPrinter, started right away
+class SimulatedJob
+{
+public:
+	SimulatedJob(SimulatedPrinter& sim, const std::vector<std::string>& lines)
+	: m_sim(sim), m_path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("job-%%%%%%%%.gcode"))
+	{
+		{
+			std::ofstream file(m_path.string());
+			for (const std::string& line : lines)
+				file << line << '\n';
+		}
+
+		m_job = std::make_shared<PrintJob>(sim.sharedPrinter(), "job.gcode", m_path.string().c_str());
+		m_connection = m_job->stateChangeSignal().connect([this](PrintJob::State state, std::string) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_state = state;
+			m_cv.notify_all();
+		});
+		m_progressConnection = m_job->progressChangeSignal().connect([this](size_t position) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_progress.emplace_back(std::chrono::steady_clock::now(), position);
+		});
+
+		sim.run([this]() {
+			m_sim.printer().setPrintJob(m_job);
+			m_job->start();
+		});
+	}
+	~SimulatedJob()
+	{
+		m_sim.run([this]() {
+			if (m_job->inProgress())
+				m_job->stop();
+
+			m_connection.disconnect();
+			m_progressConnection.disconnect();
+			m_sim.printer().setPrintJob(nullptr);
+			m_job.reset();
+		});
+
+		boost::filesystem::remove(m_path);
+		boost::filesystem::remove(TimeTable::pathFor(m_path.string()));
+	}
+
+	bool waitForState(PrintJob::State state, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_cv.wait_for(lock, timeout, [&]() { return m_state == state; });
+	}
+
+	// Belongs to the printer's thread
+	std::shared_ptr<PrintJob> job() { return m_job; }
+
+	// Progress events with the time they came
+	std::vector<std::pair<std::chrono::steady_clock::time_point, size_t>> progress()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_progress;
+	}
+private:
+	SimulatedPrinter& m_sim;
+	const boost::filesystem::path m_path;
+	std::shared_ptr<PrintJob> m_job;
+	boost::signals2::scoped_connection m_connection, m_progressConnection;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	PrintJob::State m_state = PrintJob::State::Stopped;
+	std::vector<std::pair<std::chrono::steady_clock::time_point, size_t>> m_progress;
+};
+
+// Commands written out in order, without line numbers and checksums
+static std::vector<std::string> writtenCommands(const std::vector<Printer::GCodeEvent>& gcode)
+{
+	std::vector<std::string> commands;
+
+	for (const Printer::GCodeEvent& event : gcode)
+	{
+		if (!event.outgoing)
+			continue;
+
+		std::string_view line = event.data;
+		line.remove_suffix(1);
+
+		if (line[0] == 'N')
+		{
+			line.remove_prefix(line.find(' ') + 1);
+			line = line.substr(0, line.rfind(" *"));
+		}
+
+		commands.emplace_back(line);
+	}
+
+	return commands;
+}
+
+static std::vector<std::string> moves(int count)
+{
+	std::vector<std::string> commands;
+
+	for (int i = 0; i < count; i++)
+		commands.push_back("G1 X" + std::to_string(i % 200) + " Y" + std::to_string(i % 150) + " E0.05");
+
+	return commands;
+}
+
+BOOST_AUTO_TEST_CASE(TestVirtualPrinter)
+{
+	SimulatedPrinter sim("sim:tau=0", false);
+
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	BOOST_TEST(sim.printer().hasCapability("ADVANCED_OK"));
+
+	BOOST_TEST(sim.sendAll(moves(200)) == 200);
+	BOOST_TEST(sim.sendAll({ "M104 S200", "M109 S200", "M105" }) == 3);
+	BOOST_TEST(sim.lastReply().find("T:200.00 /200.00") != std::string::npos);
+
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(stats.latencies["G1"].count() == 200u);
+	BOOST_TEST(stats.latencies["M109"].count() == 1u);
+	BOOST_TEST(stats.maxInFlight == 1u);
+	BOOST_TEST(stats.bytesSent > 200 * 10u);
+	BOOST_TEST(stats.resendRequests == 0u);
+	BOOST_TEST(stats.roundTrip().count() > 0);
+
+	sim.run([&]() {
+		BOOST_TEST(sim.printer().serialTuningResult().baudRate == 115200);
+		BOOST_TEST(!sim.printer().serialTuningResult().customBaudRate);
+	});
+}
+
+BOOST_AUTO_TEST_CASE(TestTemperatureReports)
+{
+	SimulatedPrinter sim("sim:tau=0", false);
+
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	BOOST_TEST(sim.printer().hasCapability("AUTOREPORT_TEMP"));
+	BOOST_TEST(sim.sendAll({ "M104 S210" }) == 1);
+
+	// Picked up from the reports (every 2 s by default), no M105 round trips
+	BOOST_TEST(sim.waitForTemperatures([](const std::map<std::string, Printer::Temperature>& temperatures) {
+		auto it = temperatures.find("T");
+		return it != temperatures.end() && it->second.target == 210;
+	}));
+
+	const auto now = std::chrono::system_clock::now();
+	TemperatureHistory::Series history = sim.printer().getTemperatureHistory(now - std::chrono::minutes(1), now);
+	BOOST_REQUIRE(history.size() > 0u);
+	BOOST_TEST(history.has(TemperatureReport::Bed));
+	BOOST_TEST(history.target[TemperatureReport::Tool0].back() == 210.0f);
+
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(stats.latencies.count("M155") == 1u);
+	BOOST_TEST(stats.latencies.count("M105") == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestTemperaturePolling)
+{
+	SimulatedPrinter sim("sim:tau=0,autoreport=0", false);
+
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	BOOST_TEST(sim.sendAll({ "M140 S60" }) == 1);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(stats.latencies.count("M155") == 0u);
+	BOOST_TEST(stats.latencies["M105"].count() >= 1u);
+}
+
+BOOST_AUTO_TEST_CASE(TestVirtualPrinterResends)
+{
+	// Every rejected line is retransmitted, nothing gets lost or executed twice
+	SimulatedPrinter sim("sim:checksum_errors=0.05,latency=0.2", true);
+
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	BOOST_TEST(sim.sendAll(moves(500)) == 500);
+	BOOST_TEST((sim.printer().state() == Printer::State::Connected));
+
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(stats.resendRequests > 0u);
+	BOOST_TEST(stats.linesResent >= stats.resendRequests);
+	BOOST_TEST(stats.maxInFlight > 1u);
+	// Each one takes at least the simulated 0.2 ms
+	BOOST_TEST(stats.latencies["G1"].min().count() >= 200);
+}
+
+BOOST_AUTO_TEST_CASE(TestGCodeHistory)
+{
+	SimulatedPrinter sim("sim:tau=0,autoreport=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	BOOST_TEST(sim.sendAll(moves(200)) == 200);
+
+	// The ring has wrapped around several times, whole commands make room
+	std::vector<Printer::GCodeEvent> history = sim.printer().gcodeHistory();
+	BOOST_TEST(history.size() > 90u);
+	BOOST_TEST(history.size() <= 100u);
+	BOOST_TEST(history.front().outgoing);
+	BOOST_TEST(std::any_of(history.begin(), history.end(), [](const Printer::GCodeEvent& e) {
+		return e.outgoing && e.data.find("G1 X199 Y49 ") != std::string::npos;
+	}));
+
+	for (size_t i = 1; i < history.size(); i++)
+		BOOST_TEST(history[i].commandId >= history[i - 1].commandId);
+}
+
+BOOST_AUTO_TEST_CASE(TestBusyWebThread)
+{
+	// One command at a time, each reply is a read of its own
+	SimulatedPrinter sim("sim:tau=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	// Stands in for the web server's io_service, with handlers blocking it for 20 ms each
+	// and asking the printer for its state and history the way the REST API does
+	boost::asio::io_service web;
+	std::atomic<bool> busy(true);
+	std::atomic<int> handlers(0);
+	std::function<void()> slowHandler = [&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		if (sim.printer().state() == Printer::State::Connected)
+			sim.printer().gcodeHistory();
+
+		handlers++;
+		if (busy)
+			web.post(slowHandler);
+	};
+
+	for (int i = 0; i < 4; i++)
+		web.post(slowHandler);
+	std::thread webThread([&]() { web.run(); });
+
+	sim.printer().resetStats();
+	BOOST_TEST(sim.sendAll(moves(500)) == 500);
+	const int handlersDuringMoves = handlers;
+
+	busy = false;
+	webThread.join();
+
+	// Nothing waits for the web thread. Sharing its io_service, the read of each reply would be queued
+	// behind the handlers, so the moves couldn't finish before as many handlers did, however fast the machine.
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(handlers > 0);
+	BOOST_TEST(stats.latencies["G1"].count() == 500u);
+	BOOST_TEST(handlersDuringMoves < 500);
+}
+
+BOOST_AUTO_TEST_CASE(TestBusyWebThreadJobSubmit)
+{
+	// No layer comments, so finding a layer and restoring the state before it both replay the whole file
+	const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("layers-%%%%%%%%.gcode");
+	const size_t lastLayer = 799;
+	size_t lastLayerOffset = 0;
+	{
+		std::ofstream file(path.string());
+		for (size_t layer = 0; layer <= lastLayer; layer++)
+		{
+			lastLayerOffset = file.tellp();
+			file << "G1 Z" << (layer + 1) * 0.2 << '\n';
+			for (const std::string& move : moves(500))
+				file << move << '\n';
+		}
+	}
+
+	SimulatedPrinter sim("sim:tau=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	// A job submitted with "layer" the way restSubmitJob does it, only setPrintJob() and the start
+	// are left for the printer's thread
+	std::shared_ptr<PrintJob> job;
+	std::atomic<bool> submitted(false);
+	size_t offset = 0;
+
+	std::thread webThread([&]() {
+		auto printJob = std::make_shared<PrintJob>(sim.sharedPrinter(), "layers.gcode", path.string().c_str());
+
+		offset = printJob->layerOffset(lastLayer);
+		PrintJob::StartPoint startPoint = printJob->startPoint(offset);
+
+		sim.run([&]() {
+			sim.printer().setPrintJob(printJob);
+			printJob->startAt(startPoint);
+		});
+
+		job = printJob;
+		submitted = true;
+	});
+
+	// The printer keeps answering meanwhile
+	std::chrono::steady_clock::duration longest(0);
+	int rounds = 0;
+
+	while (!submitted)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		BOOST_TEST(sim.sendAll(moves(10)) == 10);
+		longest = std::max(longest, std::chrono::steady_clock::now() - start);
+		rounds++;
+	}
+	webThread.join();
+
+	size_t position, total;
+	sim.run([&]() {
+		BOOST_TEST((job->state() == PrintJob::State::Running));
+		job->progress(position, total);
+		job->stop();
+	});
+	BOOST_TEST(offset == lastLayerOffset);
+	BOOST_TEST(position >= offset);
+
+	// Had the scans run on the printer's thread, a command would have waited for about as long as they take
+	const auto start = std::chrono::steady_clock::now();
+	job->startPoint(job->layerOffset(lastLayer));
+	const auto scans = std::chrono::steady_clock::now() - start;
+
+	using std::chrono::microseconds;
+	BOOST_TEST(rounds > 1);
+	BOOST_TEST(std::chrono::duration_cast<microseconds>(longest).count() < std::chrono::duration_cast<microseconds>(scans).count() / 2);
+
+	sim.run([&]() { job.reset(); });
+
+	boost::filesystem::remove(path);
+	boost::filesystem::remove(TimeTable::pathFor(path.string()));
+}
+
+BOOST_AUTO_TEST_CASE(TestWakeupProbe)
+{
+	SimulatedPrinter sim("sim:tau=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	// Once a second without real-time scheduling
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+	while (sim.printer().stats().wakeupLatency.count() == 0 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	BOOST_TEST(sim.printer().stats().wakeupLatency.count() > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestVirtualPrinterError)
+{
+	SimulatedPrinter sim("sim:errors=1", false);
+
+	// The first command after connecting fails
+	BOOST_TEST(sim.waitForState(Printer::State::Error));
+	BOOST_TEST(sim.printer().errorMessage() == "Simulated failure");
+}
+
+BOOST_AUTO_TEST_CASE(TestCaptureReplay)
+{
+	const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("printer-%%%%%%%%.dpcap")).string();
+	uint64_t sent, received;
+
+	{
+		SimulatedPrinter sim("sim:checksum_errors=0.05,latency=0.2", true, path);
+
+		BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+		BOOST_TEST(sim.sendAll(moves(300)) == 300);
+
+		sent = sim.printer().capture()->bytesSent();
+		received = sim.printer().capture()->bytesReceived();
+		sim.printer().stopCapture();
+	}
+
+	std::vector<SerialCapture::Record> records;
+	BOOST_REQUIRE(SerialCapture::read(path, records));
+	BOOST_TEST((records.front().event == SerialCapture::Event::Connected));
+	BOOST_TEST(sent > 0u);
+	BOOST_TEST(received > 0u);
+
+	// The same session with the recorded replies, including the resend requests, as fast as possible
+	{
+		SimulatedPrinter sim("replay:speed=0,file=" + path, true);
+
+		BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+		BOOST_TEST(sim.sendAll(moves(300)) == 300);
+		BOOST_TEST((sim.printer().state() == Printer::State::Connected));
+	}
+
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestSdOffload)
+{
+	const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("sdtest-%%%%%%%%.gcode");
+	{
+		std::ofstream file(path.string());
+		for (const std::string& move : moves(500))
+			file << move << '\n';
+	}
+
+	// 5 ms per line from the card, so that there's a status report before it's done
+	SimulatedPrinter sim("sim:tau=0,sd_line=5", true);
+
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	// The printer's settings and capabilities belong to its thread
+	sim.run([&]() {
+		BOOST_TEST(sim.printer().hasCapability("SDCARD"));
+		sim.printer().setSdOffload(true);
+	});
+
+	std::shared_ptr<PrintJob> job;
+	std::mutex mutex;
+	std::condition_variable cv;
+	PrintJob::State state = PrintJob::State::Stopped;
+	std::vector<size_t> progress;
+	bool wasPrintingFromSd = false;
+
+	sim.run([&]() {
+		job = std::make_shared<PrintJob>(sim.sharedPrinter(), "sdtest.gcode", path.string().c_str());
+
+		job->stateChangeSignal().connect([&](PrintJob::State newState, std::string) {
+			std::unique_lock<std::mutex> lock(mutex);
+			state = newState;
+			cv.notify_all();
+		});
+		job->progressChangeSignal().connect([&](size_t position) {
+			std::unique_lock<std::mutex> lock(mutex);
+			progress.push_back(position);
+			wasPrintingFromSd = job->printingFromSd();
+		});
+
+		sim.printer().setPrintJob(job);
+		job->start();
+	});
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		BOOST_TEST(cv.wait_for(lock, std::chrono::seconds(20), [&]() { return state == PrintJob::State::Done || state == PrintJob::State::Error; }));
+		BOOST_TEST((state == PrintJob::State::Done));
+	}
+
+	size_t done, total;
+	sim.run([&]() { job->progress(done, total); });
+
+	BOOST_TEST(wasPrintingFromSd);
+	BOOST_REQUIRE(progress.size() >= 2u);
+	BOOST_TEST(std::is_sorted(progress.begin(), progress.end()));
+	BOOST_TEST(progress.back() == total);
+	BOOST_TEST(done == total);
+
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(stats.latencies["M28"].count() == 1u);
+	BOOST_TEST(stats.latencies["M29"].count() == 1u);
+	BOOST_TEST(stats.latencies["M24"].count() == 1u);
+	BOOST_TEST((sim.printer().state() == Printer::State::Connected));
+
+	sim.run([&]() { job.reset(); });
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestM110WhileUploading)
+{
+	SimulatedPrinter sim("sim:tau=0,autoreport=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	// The M110 only goes into the file, the firmware's line numbers carry on
+	BOOST_TEST(sim.sendAll({ "M28 upload.gco", "M110 N0", "G1 X1", "G1 X2", "M29" }) == 5);
+	BOOST_TEST((sim.printer().state() == Printer::State::Connected));
+	BOOST_TEST(sim.printer().stats().resendRequests == 0u);
+
+	BOOST_TEST(sim.sendAll({ "M110 N0", "G1 X3" }) == 2);
+	BOOST_TEST(sim.lastReply().compare(0, 2, "ok") == 0);
+	BOOST_TEST(sim.printer().stats().resendRequests == 0u);
+}
+
+// For what no signal tells about, e.g. the replies to commands
+static bool eventually(std::function<bool()> pred, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+{
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	while (!pred())
+	{
+		if (std::chrono::steady_clock::now() >= deadline)
+			return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+// The firmware reports the temperature while waiting in M109
+static bool isHeating(const std::vector<Printer::GCodeEvent>& gcode)
+{
+	return std::any_of(gcode.begin(), gcode.end(), [](const Printer::GCodeEvent& event) {
+		return !event.outgoing && event.data.find(" W:") != std::string::npos;
+	});
+}
+
+// Job lines written before and after the command
+static void jobLinesAround(const std::vector<std::string>& commands, std::string_view command, int& before, int& after)
+{
+	auto it = std::find(commands.begin(), commands.end(), command);
+	auto isMove = [](const std::string& cmd) { return cmd.compare(0, 3, "G1 ") == 0; };
+
+	before = std::count_if(commands.begin(), it, isMove);
+	after = std::count_if(it, commands.end(), isMove);
+}
+
+BOOST_AUTO_TEST_CASE(TestEmergencyWhileHeating)
+{
+	// Heating up would take a minute with the default thermal model
+	SimulatedPrinter sim("sim:emergency_parser=1", true);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	std::vector<std::string> lines = moves(100);
+	lines.insert(lines.begin(), "M109 S200");
+	SimulatedJob job(sim, lines);
+
+	// Job lines fill up the window behind M109
+	BOOST_REQUIRE(sim.waitForGCode(isHeating));
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	std::atomic<bool> done(false);
+	sim.printer().resetStats();
+	sim.printer().sendCommand("M108", [&](const std::vector<std::string>&) { done = true; });
+
+	BOOST_TEST(job.waitForState(PrintJob::State::Done, std::chrono::seconds(5)));
+	BOOST_TEST(done);
+
+	// Written while the window was full, ahead of the job lines waiting for room
+	int before, after;
+	jobLinesAround(writtenCommands(sim.gcode()), "M108", before, after);
+	BOOST_TEST(before > 0);
+	BOOST_TEST(after > 0);
+
+	// From the call to the write, nothing to wait for but the printer's thread
+	PrinterStats stats = sim.printer().stats();
+	BOOST_TEST(stats.priorityLatency.count() == 1u);
+	BOOST_TEST(stats.priorityLatency.max().count() < 10000);
+	BOOST_TEST((sim.printer().state() == Printer::State::Connected));
+}
+
+BOOST_AUTO_TEST_CASE(TestEmergencyStop)
+{
+	SimulatedPrinter sim("sim:emergency_parser=1", true);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	std::vector<std::string> lines = moves(100);
+	lines.insert(lines.begin(), "M109 S200");
+	SimulatedJob job(sim, lines);
+
+	BOOST_REQUIRE(sim.waitForGCode(isHeating));
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	sim.printer().sendCommand("M112", nullptr);
+
+	// The firmware stops right away, not after heating up and the lines ahead of M112
+	BOOST_TEST(sim.waitForGCode([](const std::vector<Printer::GCodeEvent>& gcode) {
+		return std::any_of(gcode.begin(), gcode.end(), [](const Printer::GCodeEvent& event) {
+			return !event.outgoing && event.data == "Error:Printer halted. kill() called!";
+		});
+	}, std::chrono::seconds(1)));
+
+	int before, after;
+	jobLinesAround(writtenCommands(sim.gcode()), "M112", before, after);
+	BOOST_TEST(before > 0);
+	BOOST_TEST(before < 100);
+}
+
+BOOST_AUTO_TEST_CASE(TestResendAcrossPriorityCommands)
+{
+	SimulatedPrinter sim("sim:tau=0,latency=1,checksum_errors=0.1", true);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	SimulatedJob job(sim, moves(300));
+	std::atomic<int> replies(0);
+
+	for (int i = 0; i < 30; i++)
+	{
+		sim.printer().sendPriorityCommand(("M117 Priority " + std::to_string(i)).c_str(), [&](const std::vector<std::string>&) { replies++; });
+		std::this_thread::sleep_for(std::chrono::milliseconds(3));
+	}
+
+	BOOST_TEST(job.waitForState(PrintJob::State::Done, std::chrono::seconds(20)));
+	BOOST_TEST(eventually([&]() { return replies == 30; }));
+	BOOST_TEST(sim.printer().stats().resendRequests > 0u);
+
+	// Each line number is retransmitted with the line it was first written with
+	std::map<std::string, std::string> lineByNumber;
+	int mismatches = 0, priorityResent = 0;
+
+	for (const Printer::GCodeEvent& event : sim.gcode())
+	{
+		if (!event.outgoing || event.data[0] != 'N')
+			continue;
+
+		const std::string number = event.data.substr(0, event.data.find(' '));
+		auto it = lineByNumber.find(number);
+
+		if (it == lineByNumber.end())
+			lineByNumber.emplace(number, event.data);
+		else if (it->second != event.data)
+			mismatches++;
+		else if (event.data.find("M117 Priority") != std::string::npos)
+			priorityResent++;
+	}
+
+	BOOST_TEST(mismatches == 0);
+	BOOST_TEST(priorityResent > 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestEmergencyUnnumbered)
+{
+	SimulatedPrinter sim("sim:tau=0", true);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	// Up to the last line number before the counter is reset, see MAX_LINENO
+	const int lastLineNo = 9999;
+	BOOST_TEST(sim.sendAll({ "M105" }) == 1);
+
+	const std::vector<Printer::GCodeEvent> gcode = sim.gcode();
+	auto m105 = std::find_if(gcode.rbegin(), gcode.rend(), [](const Printer::GCodeEvent& event) {
+		return event.outgoing && event.data.find(" M105 ") != std::string::npos;
+	});
+	BOOST_REQUIRE(m105 != gcode.rend());
+
+	const int lineNo = std::atoi(m105->data.c_str() + 1);
+	BOOST_TEST(sim.sendAll(moves(lastLineNo - lineNo - 1)) == lastLineNo - lineNo - 1);
+
+	// The reset waits for the dwell, M108 doesn't
+	std::atomic<int> replies(0);
+	auto counted = [&](const std::vector<std::string>&) { replies++; };
+
+	sim.printer().sendCommand("G4 P300", counted);
+	sim.printer().sendCommand("G1 X1", counted);
+	sim.printer().sendCommand("M108", counted);
+
+	BOOST_TEST(eventually([&]() { return replies == 3; }));
+
+	std::vector<std::string> written;
+	for (const Printer::GCodeEvent& event : sim.gcode())
+	{
+		if (event.outgoing)
+			written.push_back(event.data);
+	}
+
+	BOOST_REQUIRE(written.size() >= 4u);
+	BOOST_TEST(written[written.size() - 4].compare(0, 13, "N9999 G4 P300") == 0);
+	BOOST_TEST(written[written.size() - 3] == "M108\n");
+	BOOST_TEST(written[written.size() - 2] == "M110 N0\n");
+	BOOST_TEST(written[written.size() - 1].compare(0, 9, "N1 G1 X1 ") == 0);
+
+	BOOST_TEST(sim.printer().stats().resendRequests == 0u);
+	BOOST_TEST((sim.printer().state() == Printer::State::Connected));
+}
+
+BOOST_AUTO_TEST_CASE(TestEmergencyMeatPack)
+{
+	const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("printer-%%%%%%%%.dpcap")).string();
+
+	SimulatedPrinter sim("sim:emergency_parser=1,meatpack=1", true, path);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	std::atomic<bool> heated(false);
+	sim.printer().sendCommand("M109 S200", [&](const std::vector<std::string>&) { heated = true; });
+	BOOST_REQUIRE(sim.waitForGCode(isHeating));
+
+	sim.printer().sendCommand("M108", nullptr);
+
+	// Packed, the emergency parser wouldn't see it and M109 would wait for the heater
+	BOOST_TEST(eventually([&]() { return bool(heated); }, std::chrono::seconds(2)));
+	sim.printer().stopCapture();
+
+	std::string m108;
+	for (const Printer::GCodeEvent& event : sim.gcode())
+	{
+		if (event.outgoing && event.data.find(" M108 ") != std::string::npos)
+			m108 = event.data;
+	}
+	BOOST_REQUIRE(!m108.empty());
+
+	std::vector<SerialCapture::Record> records;
+	std::string sent;
+
+	BOOST_REQUIRE(SerialCapture::read(path, records));
+	for (const SerialCapture::Record& record : records)
+	{
+		if (record.event == SerialCapture::Event::Sent)
+			sent += record.data;
+	}
+
+	// Plain text from the start of a line
+	BOOST_TEST(sent.find(std::string(MeatPack::DISABLE) + "\n" + m108 + std::string(MeatPack::ENABLE)) != std::string::npos);
+
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestProgressRate)
+{
+	SimulatedPrinter sim("sim:tau=0,latency=1", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	sim.run([&]() { sim.printer().setProgressRate(10); });
+
+	SimulatedJob job(sim, moves(400));
+	BOOST_REQUIRE(job.waitForState(PrintJob::State::Done));
+
+	size_t position, total;
+	sim.run([&]() { job.job()->progress(position, total); });
+
+	// At most one every 100 ms, apart from the final position delivered on Done
+	auto progress = job.progress();
+	BOOST_REQUIRE(progress.size() >= 3u);
+	for (size_t i = 1; i + 1 < progress.size(); i++)
+		BOOST_TEST(std::chrono::duration_cast<std::chrono::milliseconds>(progress[i].first - progress[i - 1].first).count() >= 99);
+
+	BOOST_TEST(progress.size() < 400u);
+	BOOST_TEST(progress.back().second == total);
+}
+
+BOOST_AUTO_TEST_CASE(TestProgressNoLimit)
+{
+	SimulatedPrinter sim("sim:tau=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	sim.run([&]() { sim.printer().setProgressRate(0); });
+
+	// Every line confirmed is reported
+	SimulatedJob job(sim, moves(400));
+	BOOST_REQUIRE(job.waitForState(PrintJob::State::Done));
+
+	auto progress = job.progress();
+	BOOST_TEST(progress.size() == 400u);
+}
+
+BOOST_AUTO_TEST_CASE(TestProgressMinDelta)
+{
+	SimulatedPrinter sim("sim:tau=0", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	sim.run([&]() {
+		sim.printer().setProgressRate(0);
+		sim.printer().setProgressMinDelta(10);
+	});
+
+	SimulatedJob job(sim, moves(400));
+	BOOST_REQUIRE(job.waitForState(PrintJob::State::Done));
+
+	size_t position, total;
+	sim.run([&]() { job.job()->progress(position, total); });
+
+	// Each at least 10 % further, apart from the final position delivered on Done
+	auto progress = job.progress();
+	BOOST_REQUIRE(progress.size() >= 2u);
+	BOOST_TEST(progress.size() <= 11u);
+	for (size_t i = 1; i + 1 < progress.size(); i++)
+		BOOST_TEST(progress[i].second - progress[i - 1].second >= total / 10);
+
+	BOOST_TEST(progress.back().second == total);
+}
+
+BOOST_AUTO_TEST_CASE(TestProgressHeldBack)
+{
+	SimulatedPrinter sim("sim:tau=0,latency=1", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+	sim.run([&]() { sim.printer().setProgressRate(1); });
+
+	SimulatedJob job(sim, moves(2000));
+	size_t position, total;
+
+	// Past the first event, the next one isn't due for a second
+	BOOST_REQUIRE(eventually([&]() { return !job.progress().empty(); }));
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	sim.run([&]() {
+		job.job()->pause();
+		job.job()->progress(position, total);
+	});
+	BOOST_TEST(job.progress().size() == 2u);
+	BOOST_TEST(job.progress().back().second == position);
+
+	sim.run([&]() { job.job()->start(); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	sim.run([&]() {
+		job.job()->stop();
+		job.job()->progress(position, total);
+	});
+	BOOST_TEST(job.progress().back().second == position);
+	BOOST_TEST(position < total);
+}
+
+// Hands out "G1 X<n>" lines as a print job does, counting how often each one is confirmed.
+// Belongs to the printer's thread, apart from the atomic counters.
+class TestJobSource : public Printer::JobSource
+{
+public:
+	TestJobSource(int lines)
+	: m_confirmations(lines, 0)
+	{
+		for (int i = 0; i < lines; i++)
+			m_lines.push_back("G1 X" + std::to_string(i));
+	}
+
+	bool peekLine(std::string_view& line) override
+	{
+		if (m_paused || m_next >= m_lines.size())
+			return false;
+
+		line = m_lines[m_next];
+		return true;
+	}
+	size_t lineSent() override
+	{
+		m_sent++;
+		return m_next++;
+	}
+	void lineDone(size_t cookie, bool success) override
+	{
+		if (success)
+			m_confirmations[cookie]++;
+		m_done++;
+	}
+
+	bool m_paused = false;
+	size_t m_next = 0;
+	std::vector<std::string> m_lines;
+	std::vector<int> m_confirmations;
+	std::atomic<size_t> m_sent = 0, m_done = 0;
+};
+
+BOOST_AUTO_TEST_CASE(TestJobSourceAlternation)
+{
+	SimulatedPrinter sim("sim:tau=0,latency=1", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	auto source = std::make_shared<TestJobSource>(100);
+
+	sim.run([&]() {
+		sim.printer().setJobSource(source);
+		for (int i = 0; i < 20; i++)
+			sim.printer().sendCommand(("M117 Command " + std::to_string(i)).c_str(), nullptr);
+	});
+
+	BOOST_REQUIRE(eventually([&]() { return source->m_done == 100; }));
+
+	// One each while both are waiting, the job lines are on their own once the commands are gone
+	std::vector<std::string> commands = writtenCommands(sim.gcode());
+	auto first = std::find(commands.begin(), commands.end(), "G1 X0");
+	auto last = std::find(commands.begin(), commands.end(), "M117 Command 19");
+	BOOST_REQUIRE(first < last);
+
+	int jobLines = 0;
+	for (auto it = first; it <= last; it++)
+	{
+		const bool fromJob = it->compare(0, 3, "G1 ") == 0;
+		BOOST_TEST(fromJob == ((it - first) % 2 == 0));
+		jobLines += fromJob;
+	}
+	BOOST_TEST(jobLines == 20);
+
+	sim.run([&]() { sim.printer().setJobSource(nullptr); });
+}
+
+BOOST_AUTO_TEST_CASE(TestJobSourcePreamble)
+{
+	SimulatedPrinter sim("sim:tau=0,latency=1", false);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	auto source = std::make_shared<TestJobSource>(100);
+	sim.run([&]() { sim.printer().setJobSource(source); });
+	BOOST_REQUIRE(eventually([&]() { return source->m_done >= 20; }));
+
+	// Paused, with a command in between, so that it would be the job's turn
+	sim.run([&]() { source->m_paused = true; });
+	BOOST_REQUIRE(eventually([&]() { return source->m_done == source->m_sent; }));
+	BOOST_TEST(sim.sendAll({ "M117 Paused" }) == 1);
+
+	// Resumed the way PrintJob::run() does it
+	sim.run([&]() {
+		source->m_paused = false;
+		for (int i = 0; i < 3; i++)
+			sim.printer().sendCommand(("M117 Preamble " + std::to_string(i)).c_str(), nullptr);
+		sim.printer().setJobSource(source);
+	});
+
+	BOOST_REQUIRE(eventually([&]() { return source->m_done == 100; }));
+
+	std::vector<std::string> commands = writtenCommands(sim.gcode());
+	auto preamble = std::find(commands.begin(), commands.end(), "M117 Preamble 0");
+	BOOST_REQUIRE(preamble != commands.begin());
+	BOOST_REQUIRE(preamble + 3 < commands.end());
+
+	// Nothing from the job before or in between
+	BOOST_TEST(preamble[-1] == "M117 Paused");
+	BOOST_TEST(preamble[1] == "M117 Preamble 1");
+	BOOST_TEST(preamble[2] == "M117 Preamble 2");
+	BOOST_TEST(preamble[3].compare(0, 3, "G1 ") == 0);
+
+	sim.run([&]() { sim.printer().setJobSource(nullptr); });
+}
+
+BOOST_AUTO_TEST_CASE(TestJobSourceResends)
+{
+	SimulatedPrinter sim("sim:tau=0,checksum_errors=0.1", true);
+	BOOST_REQUIRE(sim.waitForState(Printer::State::Connected));
+
+	auto source = std::make_shared<TestJobSource>(300);
+	sim.run([&]() { sim.printer().setJobSource(source); });
+	BOOST_REQUIRE(eventually([&]() { return source->m_done == 300; }));
+
+	// Retransmitted lines are confirmed once, when the printer finally takes them
+	sim.run([&]() {
+		BOOST_TEST(std::count(source->m_confirmations.begin(), source->m_confirmations.end(), 1) == 300);
+		sim.printer().setJobSource(nullptr);
+	});
+	BOOST_TEST(sim.printer().stats().linesResent > 0u);
+	BOOST_TEST(source->m_sent == 300u);
+}
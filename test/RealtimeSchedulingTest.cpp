@@ -0,0 +1,127 @@
+#define BOOST_TEST_MODULE RealtimeSchedulingTest
+#include <boost/test/included/unit_test.hpp>
+#include <stdexcept>
+#include <thread>
+#include <fstream>
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/capability.h>
+#include <unistd.h>
+#include "RealtimeScheduling.h"
+#include "GCodeReader.h"
+
+static RealtimeScheduling::Options parse(const std::string& priority, const std::string& policy, const std::string& cpus)
+{
+	boost::property_tree::ptree tree;
+
+	if (!priority.empty())
+		tree.put("priority", priority);
+	if (!policy.empty())
+		tree.put("policy", policy);
+	if (!cpus.empty())
+		tree.put("cpus", cpus);
+
+	return RealtimeScheduling::Options::parse(tree);
+}
+
+BOOST_AUTO_TEST_CASE(TestParse)
+{
+	RealtimeScheduling::Options options = parse("", "", "");
+	BOOST_TEST(!options.enabled());
+	BOOST_TEST(!options.lockMemory);
+
+	options = parse("50", "rr", "");
+	BOOST_TEST(options.enabled());
+	BOOST_TEST(options.priority == 50);
+	BOOST_TEST(options.roundRobin);
+
+	options = parse("", "fifo", "1");
+	BOOST_TEST(options.enabled());
+	BOOST_TEST(!options.roundRobin);
+
+	BOOST_CHECK_THROW(parse("100", "", ""), std::invalid_argument);
+	BOOST_CHECK_THROW(parse("-1", "", ""), std::invalid_argument);
+	BOOST_CHECK_THROW(parse("10", "deadline", ""), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestCpuList)
+{
+	BOOST_TEST(RealtimeScheduling::Options::parseCpuList("").empty());
+	BOOST_TEST(RealtimeScheduling::Options::parseCpuList("3") == std::vector<int>({ 3 }));
+	BOOST_TEST(RealtimeScheduling::Options::parseCpuList("2, 3") == std::vector<int>({ 2, 3 }));
+	BOOST_TEST(RealtimeScheduling::Options::parseCpuList("0,2-4") == std::vector<int>({ 0, 2, 3, 4 }));
+
+	for (const char* invalid : { "x", "1,", "3-1", "-1", "1-", "1.5", "2-3-4" })
+		BOOST_CHECK_THROW(RealtimeScheduling::Options::parseCpuList(invalid), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestLockMemoryLeavesFilesMappable)
+{
+	const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	std::ofstream(path.string(), std::ios::binary) << "G28\n";
+	// Sparse, takes no room
+	boost::filesystem::resize_file(path, 1024 * 1024 * 1024);
+
+	// Root isn't held to the limit without CAP_IPC_LOCK. It stays permitted, to be taken back after.
+	struct __user_cap_header_struct header = { _LINUX_CAPABILITY_VERSION_3, 0 };
+	struct __user_cap_data_struct caps[2], lowCaps[2];
+
+	::syscall(SYS_capget, &header, caps);
+	std::copy(caps, caps + 2, lowCaps);
+	lowCaps[CAP_IPC_LOCK / 32].effective &= ~(1u << (CAP_IPC_LOCK % 32));
+	::syscall(SYS_capset, &header, lowCaps);
+
+	// Enough for what's mapped now, not for the file. Ahead of the tests starting threads,
+	// their malloc arenas would take the process past the hard limit.
+	struct rlimit limit, lowered;
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	size_t mappedKiB = 0;
+
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, 7, "VmSize:") == 0)
+			mappedKiB = std::stoul(line.substr(7));
+	}
+
+	::getrlimit(RLIMIT_MEMLOCK, &limit);
+	lowered = limit;
+	lowered.rlim_cur = std::min<rlim_t>((mappedKiB + 64 * 1024) * 1024, limit.rlim_max);
+	::setrlimit(RLIMIT_MEMLOCK, &lowered);
+
+	RealtimeScheduling::Options options;
+	options.lockMemory = true;
+	RealtimeScheduling::configure(options);
+
+	BOOST_CHECK_NO_THROW(GCodeReader reader(path.c_str()));
+
+	::munlockall();
+	::setrlimit(RLIMIT_MEMLOCK, &limit);
+	::syscall(SYS_capset, &header, caps);
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestEnterPinsThread)
+{
+	RealtimeScheduling::Options options;
+	options.cpus = { 0 };
+	RealtimeScheduling::configure(options);
+
+	cpu_set_t set;
+	bool realtime = true;
+
+	std::thread([&]() {
+		realtime = RealtimeScheduling::enter();
+		CPU_ZERO(&set);
+		::sched_getaffinity(0, sizeof(set), &set);
+	}).join();
+
+	// No priority asked for
+	BOOST_TEST(!realtime);
+	BOOST_TEST(CPU_COUNT(&set) == 1);
+	BOOST_TEST(CPU_ISSET(0, &set));
+}
@@ -0,0 +1,143 @@
+// Compares the reply tokenizer with the previous istream based line handling.
+// Usage: ReplyTokenizerBenchmark [transcript or .dpcap capture...]
+// Of a capture, what the printer sent is used, see PUT printers/<name>/capture.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <boost/asio/streambuf.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include "ReplyTokenizer.h"
+#include "SerialCapture.h"
+
+static const size_t CORPUS_SIZE = 16*1024*1024;
+
+// What Printer::readDone used to do per line
+static int legacyRun(const std::string& data)
+{
+	boost::asio::streambuf buf;
+	int oks = 0;
+
+	{
+		std::ostream os(&buf);
+		os << data;
+	}
+
+	std::istream is(&buf);
+	std::string line;
+
+	while (std::getline(is, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+
+		if (boost::starts_with(line, "ok ") || line == "ok")
+			oks++;
+		else if (line == "start")
+			;
+		else if (boost::starts_with(line, "Error:"))
+			;
+		else if (boost::starts_with(line, "Resend:"))
+			;
+	}
+
+	return oks;
+}
+
+static int tokenizerRun(const std::string& data)
+{
+	ReplyTokenizer::Reply reply;
+	size_t offset = 0, consumed;
+	int oks = 0;
+
+	while ((consumed = ReplyTokenizer::next(data.c_str() + offset, data.length() - offset, reply)) > 0)
+	{
+		offset += consumed;
+		if (reply.kind == ReplyTokenizer::Kind::Ok)
+			oks++;
+	}
+
+	return oks;
+}
+
+template<typename Fn>
+static void measure(const char* name, const std::string& data, size_t lines, Fn fn)
+{
+	auto start = std::chrono::steady_clock::now();
+	int oks = fn(data);
+	std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << ": " << oks << " oks, "
+		<< (data.length() / duration.count() / 1024 / 1024) << " MiB/s, "
+		<< (duration.count() * 1e9 / lines) << " ns/line\n";
+}
+
+int main(int argc, const char** argv)
+{
+	std::vector<std::string> files;
+
+	for (int i = 1; i < argc; i++)
+		files.push_back(argv[i]);
+
+	if (files.empty())
+	{
+		for (const char* name : { "marlin.log", "prusa.log", "klipper.log" })
+			files.push_back(std::string(TEST_DATA_DIR "/") + name);
+	}
+
+	for (const std::string& file : files)
+	{
+		std::string transcript, data;
+
+		if (boost::ends_with(file, ".dpcap"))
+		{
+			std::vector<SerialCapture::Record> records;
+
+			if (!SerialCapture::read(file, records))
+			{
+				std::cerr << "Cannot read capture " << file << std::endl;
+				return 1;
+			}
+
+			for (const SerialCapture::Record& record : records)
+			{
+				if (record.event == SerialCapture::Event::Received)
+					transcript += record.data;
+			}
+		}
+		else
+		{
+			std::ifstream in(file);
+			if (!in.is_open())
+			{
+				std::cerr << "Cannot open " << file << std::endl;
+				return 1;
+			}
+
+			std::stringstream ss;
+			ss << in.rdbuf();
+			transcript = ss.str();
+		}
+
+		if (transcript.empty())
+		{
+			std::cerr << "Nothing received in " << file << std::endl;
+			return 1;
+		}
+
+		while (data.length() < CORPUS_SIZE)
+			data += transcript;
+
+		size_t lines = std::count(data.begin(), data.end(), '\n');
+
+		std::cout << file << " (" << lines << " lines)\n";
+		measure("  istream  ", data, lines, legacyRun);
+		measure("  tokenizer", data, lines, tokenizerRun);
+	}
+
+	return 0;
+}
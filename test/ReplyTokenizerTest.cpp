@@ -0,0 +1,144 @@
+#define BOOST_TEST_MODULE ReplyTokenizerTest
+#include <boost/test/included/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include "ReplyTokenizer.h"
+
+using Kind = ReplyTokenizer::Kind;
+
+static Kind classify(const char* line, int& number)
+{
+	return ReplyTokenizer::classify(line, number);
+}
+
+BOOST_AUTO_TEST_CASE(TestClassify)
+{
+	int number;
+
+	BOOST_TEST((classify("ok", number) == Kind::Ok));
+	BOOST_TEST((classify("ok T:21.48 /0.00 B:21.02 /0.00 @:0 B@:0", number) == Kind::Ok));
+	BOOST_TEST((classify("ok N12 P15 B3", number) == Kind::Ok));
+	BOOST_TEST((classify("okay", number) == Kind::Other));
+
+	BOOST_TEST((classify("Resend: 19", number) == Kind::Resend));
+	BOOST_TEST(number == 19);
+	BOOST_TEST((classify("Resend:123", number) == Kind::Resend));
+	BOOST_TEST(number == 123);
+	BOOST_TEST((classify("rs 7", number) == Kind::Resend));
+	BOOST_TEST(number == 7);
+	BOOST_TEST((classify("Resend: ", number) == Kind::Resend));
+	BOOST_TEST(number == -1);
+
+	BOOST_TEST((classify("Error:checksum mismatch, Last Line: 20", number) == Kind::Error));
+	BOOST_TEST((classify("!! Must home axis first: 125.000 105.000 0.200 [0.000]", number) == Kind::Error));
+	BOOST_TEST((classify("echo:busy: processing", number) == Kind::Busy));
+	BOOST_TEST((classify("busy: paused for user", number) == Kind::Busy));
+	BOOST_TEST((classify("echo:SD card ok", number) == Kind::Echo));
+	BOOST_TEST((classify("// Klipper state: Ready", number) == Kind::Echo));
+	BOOST_TEST((classify("start", number) == Kind::Start));
+	BOOST_TEST((classify("started", number) == Kind::Other));
+
+	BOOST_TEST((classify(" T:150.03 /210.00 B:60.11 /60.00 @:127 B@:0 W:?", number) == Kind::Temperature));
+	BOOST_TEST((classify("T:171.8 E:0 W:?", number) == Kind::Temperature));
+	BOOST_TEST((classify("B:60.0 /60.0 T0:160.7 /210.0", number) == Kind::Temperature));
+	BOOST_TEST((classify("T0:210.0 /210.0", number) == Kind::Temperature));
+	BOOST_TEST((classify("SD printing byte 1024/52311", number) == Kind::SdStatus));
+	BOOST_TEST((classify("Not SD printing", number) == Kind::SdStatus));
+	BOOST_TEST((classify("Done printing file", number) == Kind::SdStatus));
+	BOOST_TEST((classify("SD card ok", number) == Kind::Other));
+	BOOST_TEST((classify("tmc2130_home_enter(axes_mask=0x01)", number) == Kind::Other));
+	BOOST_TEST((classify("X:0.00 Y:0.00 Z:0.00 E:0.00 Count X:0 Y:0 Z:0", number) == Kind::Other));
+	BOOST_TEST((classify("", number) == Kind::Other));
+}
+
+BOOST_AUTO_TEST_CASE(TestSplitting)
+{
+	const char data[] = "ok\r\n\nResend: 5\nok T:2";
+	ReplyTokenizer::Reply reply;
+	size_t offset = 0, consumed;
+
+	consumed = ReplyTokenizer::next(data, sizeof(data) - 1, reply);
+	BOOST_TEST(consumed == 4u);
+	BOOST_TEST(reply.line == "ok");
+	BOOST_TEST((reply.kind == Kind::Ok));
+	offset += consumed;
+
+	consumed = ReplyTokenizer::next(data + offset, sizeof(data) - 1 - offset, reply);
+	BOOST_TEST(consumed == 1u);
+	BOOST_TEST(reply.line.empty());
+	offset += consumed;
+
+	consumed = ReplyTokenizer::next(data + offset, sizeof(data) - 1 - offset, reply);
+	BOOST_TEST(reply.line == "Resend: 5");
+	BOOST_TEST(reply.number == 5);
+	offset += consumed;
+
+	// Incomplete line stays in the buffer
+	BOOST_TEST(ReplyTokenizer::next(data + offset, sizeof(data) - 1 - offset, reply) == 0u);
+}
+
+// The transcripts in test/data are put together by hand after the output of each firmware, they weren't recorded
+// from a printer. To be replaced by real ones: capture a session with PUT printers/<name>/capture {"active": true},
+// take what was received from the .dpcap file (ReplyTokenizerBenchmark reads captures as they are) and update the counts.
+static std::map<Kind, int> tokenizeCorpus(const char* name)
+{
+	std::ifstream file(std::string(TEST_DATA_DIR "/") + name);
+	std::stringstream ss;
+	std::map<Kind, int> counts;
+
+	ss << file.rdbuf();
+
+	const std::string data = ss.str();
+	ReplyTokenizer::Reply reply;
+	size_t offset = 0, consumed;
+
+	while ((consumed = ReplyTokenizer::next(data.c_str() + offset, data.length() - offset, reply)) > 0)
+	{
+		offset += consumed;
+		counts[reply.kind]++;
+	}
+
+	BOOST_TEST(offset == data.length());
+	return counts;
+}
+
+BOOST_AUTO_TEST_CASE(TestMarlinCorpus)
+{
+	auto counts = tokenizeCorpus("marlin.log");
+
+	BOOST_TEST(counts[Kind::Ok] == 30);
+	BOOST_TEST(counts[Kind::Resend] == 2);
+	BOOST_TEST(counts[Kind::Error] == 3);
+	BOOST_TEST(counts[Kind::Busy] == 2);
+	BOOST_TEST(counts[Kind::Echo] == 24);
+	BOOST_TEST(counts[Kind::Temperature] == 19);
+	BOOST_TEST(counts[Kind::Start] == 1);
+	BOOST_TEST(counts[Kind::Other] == 33);
+}
+
+BOOST_AUTO_TEST_CASE(TestPrusaCorpus)
+{
+	auto counts = tokenizeCorpus("prusa.log");
+
+	BOOST_TEST(counts[Kind::Ok] == 30);
+	BOOST_TEST(counts[Kind::Resend] == 2);
+	BOOST_TEST(counts[Kind::Error] == 2);
+	BOOST_TEST(counts[Kind::Busy] == 7);
+	BOOST_TEST(counts[Kind::Echo] == 8);
+	BOOST_TEST(counts[Kind::Temperature] == 17);
+	BOOST_TEST(counts[Kind::Start] == 1);
+	BOOST_TEST(counts[Kind::Other] == 22);
+}
+
+BOOST_AUTO_TEST_CASE(TestKlipperCorpus)
+{
+	auto counts = tokenizeCorpus("klipper.log");
+
+	BOOST_TEST(counts[Kind::Ok] == 29);
+	BOOST_TEST(counts[Kind::Resend] == 0);
+	BOOST_TEST(counts[Kind::Error] == 3);
+	BOOST_TEST(counts[Kind::Echo] == 8);
+	BOOST_TEST(counts[Kind::Temperature] == 8);
+	BOOST_TEST(counts[Kind::Other] == 2);
+}
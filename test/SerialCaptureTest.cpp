@@ -0,0 +1,212 @@
+#define BOOST_TEST_MODULE SerialCaptureTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <thread>
+#include <future>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "SerialCapture.h"
+#include "CaptureReplayer.h"
+
+static std::string tempPath()
+{
+	return (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("capture-%%%%%%%%.dpcap")).string();
+}
+
+// Connected, "M105\n" -> "ok T:20\n" 50 ms later, "G28\n" -> "ok\n"
+static std::string writeSample()
+{
+	const std::string path = tempPath();
+	SerialCapture capture(path);
+
+	capture.record(SerialCapture::Event::Received, "start\n", 6);
+	capture.record(SerialCapture::Event::Connected);
+	capture.record(SerialCapture::Event::Sent, "M105\n", 5);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	capture.record(SerialCapture::Event::Received, "ok T:20\n", 8);
+	capture.record(SerialCapture::Event::Sent, "G28\n", 4);
+	capture.record(SerialCapture::Event::Received, "ok\n", 3);
+
+	return path;
+}
+
+// The printer's side of the replay
+class Connection
+{
+public:
+	Connection(const CaptureReplayer::Options& options)
+	: m_replayer(m_io, options)
+	{
+		open();
+		m_thread = std::thread([this]() { m_io.run(); });
+	}
+	~Connection()
+	{
+		m_io.stop();
+		m_thread.join();
+		::close(m_fd);
+	}
+
+	void open()
+	{
+		m_fd = ::open(m_replayer.devicePath().c_str(), O_RDWR | O_NOCTTY);
+		BOOST_REQUIRE(m_fd >= 0);
+
+		struct termios tos;
+		::tcgetattr(m_fd, &tos);
+		::cfmakeraw(&tos);
+		::tcsetattr(m_fd, TCSANOW, &tos);
+	}
+	void reopen()
+	{
+		::close(m_fd);
+		// Let the replayer notice
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		open();
+	}
+
+	void write(const std::string& data)
+	{
+		BOOST_REQUIRE(::write(m_fd, data.c_str(), data.length()) == ssize_t(data.length()));
+	}
+
+	std::string readLine(int timeoutMs = 2000)
+	{
+		std::string line;
+		struct pollfd pfd = { m_fd, POLLIN, 0 };
+		char c;
+
+		while (::poll(&pfd, 1, timeoutMs) > 0 && ::read(m_fd, &c, 1) == 1)
+		{
+			if (c == '\n')
+				return line;
+			line += c;
+		}
+
+		return "(timeout)";
+	}
+
+	// Taken on the replayer's thread
+	CaptureReplayer::Stats stats()
+	{
+		std::promise<CaptureReplayer::Stats> stats;
+
+		m_io.post([&]() { stats.set_value(m_replayer.stats()); });
+		return stats.get_future().get();
+	}
+private:
+	boost::asio::io_service m_io;
+	CaptureReplayer m_replayer;
+	int m_fd;
+	std::thread m_thread;
+};
+
+BOOST_AUTO_TEST_CASE(TestRecordAndRead)
+{
+	const std::string path = writeSample();
+	std::vector<SerialCapture::Record> records;
+
+	BOOST_REQUIRE(SerialCapture::read(path, records));
+	BOOST_REQUIRE(records.size() == 6u);
+
+	BOOST_TEST((records[1].event == SerialCapture::Event::Connected));
+	BOOST_TEST(records[1].data.empty());
+	BOOST_TEST((records[2].event == SerialCapture::Event::Sent));
+	BOOST_TEST(records[2].data == "M105\n");
+	BOOST_TEST((records[3].event == SerialCapture::Event::Received));
+	BOOST_TEST(records[3].data == "ok T:20\n");
+
+	const auto gap = records[3].time - records[2].time;
+	BOOST_TEST(gap.count() >= 50000);
+	BOOST_TEST(gap.count() < 1000000);
+
+	// A torn last record is dropped
+	boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 2);
+	BOOST_REQUIRE(SerialCapture::read(path, records));
+	BOOST_TEST(records.size() == 5u);
+
+	boost::filesystem::remove(path);
+
+	BOOST_TEST(!SerialCapture::read(path, records));
+}
+
+BOOST_AUTO_TEST_CASE(TestOptions)
+{
+	CaptureReplayer::Options options = CaptureReplayer::Options::parse("file=/tmp/x.dpcap,speed=2.5");
+
+	BOOST_TEST(options.file == "/tmp/x.dpcap");
+	BOOST_TEST(options.speed == 2.5);
+
+	BOOST_CHECK_THROW(CaptureReplayer::Options::parse("speed=2"), std::invalid_argument);
+	BOOST_CHECK_THROW(CaptureReplayer::Options::parse("file=x,speed=-1"), std::invalid_argument);
+	BOOST_CHECK_THROW(CaptureReplayer::Options::parse("file=x,rate=1"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestReplay)
+{
+	CaptureReplayer::Options options;
+	options.file = writeSample();
+
+	Connection conn(options);
+
+	// Starts at the connection, replies wait for the data they followed
+	BOOST_TEST(conn.readLine(200) == "(timeout)");
+
+	auto start = std::chrono::steady_clock::now();
+	conn.write("M105\n");
+	BOOST_TEST(conn.readLine() == "ok T:20");
+	BOOST_TEST(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() >= 45);
+
+	conn.write("G2");
+	BOOST_TEST(conn.readLine(200) == "(timeout)");
+	conn.write("9\n");
+	BOOST_TEST(conn.readLine() == "ok");
+
+	BOOST_TEST(conn.stats().finished);
+	BOOST_TEST(conn.stats().mismatchedBytes == 1u);
+	BOOST_TEST(conn.stats().bytesReplayed == 11u);
+
+	boost::filesystem::remove(options.file);
+}
+
+BOOST_AUTO_TEST_CASE(TestReplaySpeed)
+{
+	const std::string path = tempPath();
+
+	{
+		SerialCapture capture(path);
+
+		capture.record(SerialCapture::Event::Connected);
+		capture.record(SerialCapture::Event::Sent, "G4 P1000\n", 9);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+		capture.record(SerialCapture::Event::Received, "ok\n", 3);
+
+		// The printer got reset
+		capture.record(SerialCapture::Event::Connected);
+		capture.record(SerialCapture::Event::Received, "start\n", 6);
+	}
+
+	CaptureReplayer::Options options;
+	options.file = path;
+	options.speed = 10;
+
+	Connection conn(options);
+
+	auto start = std::chrono::steady_clock::now();
+	conn.write("G4 P1000\n");
+	BOOST_TEST(conn.readLine() == "ok");
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	BOOST_TEST(elapsed >= 95);
+	BOOST_TEST(elapsed < 500);
+
+	// Waits for the reconnect
+	BOOST_TEST(conn.readLine(200) == "(timeout)");
+	conn.reopen();
+	BOOST_TEST(conn.readLine() == "start");
+	BOOST_TEST(conn.stats().finished);
+
+	boost::filesystem::remove(path);
+}
@@ -0,0 +1,109 @@
+#define BOOST_TEST_MODULE SerialTuningTest
+#include <boost/test/included/unit_test.hpp>
+#include <system_error>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <asm/termbits.h>
+#include "SerialTuning.h"
+
+// The slave side of a pty stands in for a serial port
+class Pty
+{
+public:
+	Pty()
+	{
+		m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+		BOOST_REQUIRE(m_master != -1);
+		BOOST_REQUIRE(::grantpt(m_master) == 0 && ::unlockpt(m_master) == 0);
+
+		m_slave = ::open(::ptsname(m_master), O_RDWR | O_NOCTTY);
+		BOOST_REQUIRE(m_slave != -1);
+	}
+	~Pty()
+	{
+		::close(m_slave);
+		::close(m_master);
+	}
+
+	int fd() const { return m_slave; }
+
+	struct termios2 termios() const
+	{
+		struct termios2 tio;
+		BOOST_REQUIRE(::ioctl(m_slave, TCGETS2, &tio) == 0);
+		return tio;
+	}
+private:
+	int m_master, m_slave;
+};
+
+BOOST_AUTO_TEST_CASE(TestStandardRates)
+{
+	BOOST_TEST(SerialTuning::isStandardBaudRate(115200));
+	BOOST_TEST(SerialTuning::isStandardBaudRate(500000));
+	BOOST_TEST(!SerialTuning::isStandardBaudRate(250000));
+	BOOST_TEST(!SerialTuning::isStandardBaudRate(0));
+}
+
+BOOST_AUTO_TEST_CASE(TestStandardBaudRate)
+{
+	Pty pty;
+	SerialTuning tuning;
+
+	SerialTuning::Result result = tuning.apply(pty.fd(), 115200);
+	BOOST_TEST(!result.customBaudRate);
+	BOOST_TEST(result.baudRate == 115200);
+	// Not a UART
+	BOOST_TEST(!result.lowLatency);
+
+	BOOST_TEST((pty.termios().c_cflag & CBAUD) == B115200);
+}
+
+BOOST_AUTO_TEST_CASE(TestCustomBaudRate)
+{
+	Pty pty;
+	SerialTuning tuning;
+
+	tuning.vmin = 0;
+	tuning.vtime = 5;
+
+	SerialTuning::Result result = tuning.apply(pty.fd(), 250000);
+	BOOST_TEST(result.customBaudRate);
+	BOOST_TEST(result.baudRate == 250000);
+
+	struct termios2 tio = pty.termios();
+	BOOST_TEST((tio.c_cflag & CBAUD) == BOTHER);
+	BOOST_TEST(tio.c_ospeed == 250000u);
+	BOOST_TEST(tio.c_cc[VMIN] == 0);
+	BOOST_TEST(tio.c_cc[VTIME] == 5);
+
+	BOOST_TEST(SerialTuning::baudRate(pty.fd()) == 250000);
+}
+
+BOOST_AUTO_TEST_CASE(TestUsbCdc)
+{
+	Pty pty;
+	SerialTuning tuning;
+
+	tuning.apply(pty.fd(), 9600);
+
+	// The rate is left alone
+	tuning.usbCdc = true;
+	SerialTuning::Result result = tuning.apply(pty.fd(), 250000);
+	BOOST_TEST(!result.customBaudRate);
+	BOOST_TEST(result.baudRate == 0);
+	BOOST_TEST((pty.termios().c_cflag & CBAUD) == B9600);
+}
+
+BOOST_AUTO_TEST_CASE(TestNotATerminal)
+{
+	int fds[2];
+	BOOST_REQUIRE(::pipe(fds) == 0);
+
+	BOOST_CHECK_THROW(SerialTuning().apply(fds[0], 115200), std::system_error);
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE TemperatureHistoryTest
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include "TemperatureHistory.h"
+
+using std::chrono::seconds;
+using std::chrono::milliseconds;
+
+static const TemperatureHistory::clock::time_point START(seconds(1700000000));
+
+static TemperatureReport makeReport(float hotend, float bed)
+{
+	TemperatureReport report;
+	report.readings[TemperatureReport::Tool0] = { hotend, 200 };
+	report.readings[TemperatureReport::Bed] = { bed, 60 };
+	report.present = report.targets = (1u << TemperatureReport::Tool0) | (1u << TemperatureReport::Bed);
+	return report;
+}
+
+BOOST_AUTO_TEST_CASE(TestRecent)
+{
+	TemperatureHistory history;
+
+	for (int i = 0; i < 10; i++)
+		history.record(START + seconds(2 * i), makeReport(100 + i, 50));
+
+	TemperatureHistory::Series series = history.query(START, START + seconds(60));
+
+	BOOST_TEST(series.size() == 10u);
+	BOOST_TEST(series.has(TemperatureReport::Tool0));
+	BOOST_TEST(series.has(TemperatureReport::Bed));
+	BOOST_TEST(!series.has(TemperatureReport::Chamber));
+	BOOST_TEST(series.current[TemperatureReport::Tool0][0] == 100.0f);
+	// The last one still sits in the bucket being filled
+	BOOST_TEST(series.current[TemperatureReport::Tool0][9] == 109.0f);
+	BOOST_TEST(series.target[TemperatureReport::Bed][9] == 60.0f);
+	BOOST_TEST((series.when[9] == START + seconds(18)));
+
+	// Time range
+	series = history.query(START + seconds(5), START + seconds(10));
+	BOOST_TEST(series.size() == 3u);
+	BOOST_TEST(series.current[TemperatureReport::Tool0][0] == 103.0f);
+}
+
+BOOST_AUTO_TEST_CASE(TestMaxPoints)
+{
+	TemperatureHistory history;
+
+	for (int i = 0; i < 100; i++)
+		history.record(START + seconds(i), makeReport(i, 50));
+
+	TemperatureHistory::Series series = history.query(START, START + seconds(100), 10);
+
+	BOOST_TEST(series.size() == 10u);
+	BOOST_TEST(series.current[TemperatureReport::Tool0][0] == 4.5f);
+	BOOST_TEST(series.current[TemperatureReport::Tool0][9] == 94.5f);
+	BOOST_TEST((series.when[0] == START + milliseconds(4500)));
+}
+
+BOOST_AUTO_TEST_CASE(TestTiers)
+{
+	TemperatureHistory history;
+
+	// Two hours at one report per second, more than the finest tier keeps
+	for (int i = 0; i < 7200; i++)
+		history.record(START + seconds(i), makeReport(i % 20, 50));
+
+	TemperatureHistory::Series series = history.query(START + seconds(7000), START + seconds(7200));
+	BOOST_TEST(series.size() == 200u);
+
+	// Served by the 10 s tier, averaged over each 10 s
+	series = history.query(START, START + seconds(7200));
+	BOOST_TEST(series.size() == 720u);
+	BOOST_TEST(series.current[TemperatureReport::Tool0][0] == 4.5f);
+	BOOST_TEST(series.current[TemperatureReport::Tool0][1] == 14.5f);
+	BOOST_TEST((series.when[0] == START + milliseconds(4500)));
+
+	BOOST_TEST(TemperatureHistory::retention().count() == 24 * 3600);
+}
+
+BOOST_AUTO_TEST_CASE(TestSensorAppearing)
+{
+	TemperatureHistory history;
+	TemperatureReport report = makeReport(20, 20);
+
+	history.record(START, report);
+
+	report.readings[TemperatureReport::Chamber] = { 30, 0 };
+	report.present |= 1u << TemperatureReport::Chamber;
+	history.record(START + seconds(1), report);
+
+	TemperatureHistory::Series series = history.query(START, START + seconds(2));
+
+	BOOST_TEST(series.size() == 2u);
+	BOOST_TEST(series.has(TemperatureReport::Chamber));
+	BOOST_TEST(std::isnan(series.current[TemperatureReport::Chamber][0]));
+	BOOST_TEST(series.current[TemperatureReport::Chamber][1] == 30.0f);
+	// No target reported
+	BOOST_TEST(std::isnan(series.target[TemperatureReport::Chamber][1]));
+
+	history.clear();
+	BOOST_TEST(history.query(START, START + seconds(2)).size() == 0u);
+}
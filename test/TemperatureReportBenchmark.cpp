@@ -0,0 +1,131 @@
+// Compares TemperatureReport with the previous kvParse and std::stof based parsing.
+// Usage: TemperatureReportBenchmark [iterations]
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdlib>
+#include "TemperatureReport.h"
+
+static const char* const LINES[] = {
+	"ok T:210.00 /210.00 B:60.00 /60.00 @:127 B@:0",
+	" T:209.87 /210.00 B:60.12 /60.00 @:64 B@:12",
+	"ok T:25.00 /0.00 B:24.00 /0.00 C:30.00 /35.00 T0:200.00 /200.00 T1:25.00 /0.00 @:0 B@:0 C@:64 @0:90 @1:0",
+	"T:187.45 E:0 W:?",
+};
+
+// What Printer::kvParse did
+static void kvParse(const std::string& line, std::map<std::string,std::string>& values)
+{
+	int pos = 0;
+	std::vector<std::pair<int, int>> keyPositions;
+
+	values.clear();
+	while ((pos = line.find(':', pos)) != std::string::npos)
+	{
+		int x = pos - 1;
+
+		while (x >= 0 && !isspace(line[x]))
+		{
+			if (line[x] == ':')
+				goto ignore;
+			x--;
+		}
+
+		keyPositions.push_back(std::make_pair(x+1, pos));
+
+ignore:
+		pos++;
+	}
+
+	for (size_t i = 0; i < keyPositions.size(); i++)
+	{
+		const std::pair<int, int>& pos = keyPositions[i];
+		std::string key = line.substr(pos.first, pos.second - pos.first), value;
+
+		if (i + 1 < keyPositions.size())
+		{
+			int off = pos.second + 1;
+			value = line.substr(off, keyPositions[i+1].first - off - 1);
+		}
+		else
+			value = line.substr(pos.second + 1);
+
+		values.emplace(std::move(key), std::move(value));
+	}
+}
+
+// What Printer::parseTemperatures used to do per line, returns the sum of the values as a check
+static double legacyParse(const std::string& line)
+{
+	std::map<std::string, std::string> values;
+	double sum = 0;
+
+	kvParse(line, values);
+
+	for (auto it : values)
+	{
+		if (it.first != "T" && it.first != "B")
+			continue;
+
+		try
+		{
+			size_t slash = it.second.find('/');
+
+			sum += std::stof(it.second);
+			if (slash != std::string::npos)
+				sum += std::stof(it.second.substr(slash + 1));
+		}
+		catch (const std::exception& e)
+		{
+		}
+	}
+
+	return sum;
+}
+
+static double reportParse(const std::string& line)
+{
+	TemperatureReport report;
+	double sum = 0;
+
+	report.parse(line);
+
+	for (int sensor : { int(TemperatureReport::Tool0), int(TemperatureReport::Bed) })
+	{
+		if (report.has(sensor))
+			sum += report.readings[sensor].current + report.readings[sensor].target;
+	}
+
+	return sum;
+}
+
+template<typename Fn>
+static void measure(const char* name, const std::vector<std::string>& lines, int iterations, Fn fn)
+{
+	double sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++)
+	{
+		for (const std::string& line : lines)
+			sum += fn(line);
+	}
+
+	std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << ": " << (duration.count() * 1e9 / iterations / lines.size()) << " ns/line (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char** argv)
+{
+	const int iterations = (argc > 1) ? std::atoi(argv[1]) : 500000;
+	std::vector<std::string> lines(std::begin(LINES), std::end(LINES));
+
+	measure("kvParse", lines, iterations, legacyParse);
+	measure("report ", lines, iterations, reportParse);
+
+	return 0;
+}
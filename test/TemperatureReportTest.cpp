@@ -0,0 +1,86 @@
+#define BOOST_TEST_MODULE TemperatureReportTest
+#include <boost/test/included/unit_test.hpp>
+#include "TemperatureReport.h"
+
+BOOST_AUTO_TEST_CASE(TestMarlinReply)
+{
+	TemperatureReport report;
+
+	BOOST_TEST(report.parse("ok T:210.00 /215.00 B:60.50 /60.00 @:127 B@:0"));
+	BOOST_TEST(report.has(TemperatureReport::Tool0));
+	BOOST_TEST(report.has(TemperatureReport::Bed));
+	BOOST_TEST(!report.has(TemperatureReport::Chamber));
+	BOOST_TEST(report.readings[TemperatureReport::Tool0].current == 210.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Tool0].target == 215.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Tool0].power == 127);
+	BOOST_TEST(report.readings[TemperatureReport::Bed].current == 60.5f);
+	BOOST_TEST(report.readings[TemperatureReport::Bed].target == 60.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Bed].power == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestMultipleHeaters)
+{
+	TemperatureReport report;
+
+	BOOST_TEST(report.parse(" T:25.00 /0.00 B:24.00 /0.00 C:30.00 /35.00 T0:200.00 /200.00 T1:25.00 /0.00 P:22.50 @:0 B@:0 C@:64 @0:90 @1:0"));
+	BOOST_TEST(report.readings[TemperatureReport::Tool0].current == 200.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Tool0].power == 90);
+	BOOST_TEST(report.readings[TemperatureReport::Tool0 + 1].current == 25.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Tool0 + 1].target == 0.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Chamber].target == 35.0f);
+	BOOST_TEST(report.readings[TemperatureReport::Chamber].power == 64);
+	BOOST_TEST(report.readings[TemperatureReport::Probe].current == 22.5f);
+	BOOST_TEST(!report.has(TemperatureReport::Tool0 + 2));
+}
+
+BOOST_AUTO_TEST_CASE(TestWaitLines)
+{
+	TemperatureReport report;
+
+	// M109, without targets
+	BOOST_TEST(report.parse("T:187.45 E:0 W:?"));
+	BOOST_TEST(report.present == 1u << TemperatureReport::Tool0);
+	BOOST_TEST(report.readings[TemperatureReport::Tool0].current == 187.45f);
+	BOOST_TEST(!report.hasTarget(TemperatureReport::Tool0));
+
+	// Without a space before the target
+	BOOST_TEST(report.parse("T:21.3/0.0 B:22.1/65.0"));
+	BOOST_TEST(report.readings[TemperatureReport::Bed].target == 65.0f);
+
+	BOOST_TEST(!report.parse("ok"));
+	BOOST_TEST(!report.parse("echo:busy: processing"));
+	BOOST_TEST(!report.parse("T:? B:"));
+	BOOST_TEST(!report.parse(""));
+}
+
+BOOST_AUTO_TEST_CASE(TestChanges)
+{
+	TemperatureReport last, report;
+
+	BOOST_TEST(report.parse("T:200.00 /200.00 B:60.00 /60.00"));
+	BOOST_TEST(last.changes(report) == (0x3u | (0x3u << (2 * TemperatureReport::Bed))));
+	last.merge(report);
+
+	BOOST_TEST(report.parse("T:200.00 /200.00 B:60.00 /60.00"));
+	BOOST_TEST(last.changes(report) == 0u);
+
+	// Partial update, only the hotend during M109
+	BOOST_TEST(report.parse("T:201.00 E:0 W:?"));
+	BOOST_TEST(last.changes(report) == TemperatureReport::CURRENT_CHANGED);
+	last.merge(report);
+	BOOST_TEST(last.readings[TemperatureReport::Tool0].target == 200.0f);
+	BOOST_TEST(last.has(TemperatureReport::Bed));
+	BOOST_TEST(last.readings[TemperatureReport::Bed].current == 60.0f);
+	BOOST_TEST(last.readings[TemperatureReport::Tool0].current == 201.0f);
+
+	BOOST_TEST(report.parse("B:60.00 /70.00"));
+	BOOST_TEST(last.changes(report) == TemperatureReport::TARGET_CHANGED << (2 * TemperatureReport::Bed));
+}
+
+BOOST_AUTO_TEST_CASE(TestSensorNames)
+{
+	BOOST_TEST(TemperatureReport::sensorName(TemperatureReport::Tool0) == std::string("T"));
+	BOOST_TEST(TemperatureReport::sensorName(TemperatureReport::Tool0 + 3) == std::string("T3"));
+	BOOST_TEST(TemperatureReport::sensorName(TemperatureReport::Bed) == std::string("B"));
+	BOOST_TEST(TemperatureReport::sensorName(TemperatureReport::Chamber) == std::string("C"));
+}
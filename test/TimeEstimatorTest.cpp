@@ -0,0 +1,159 @@
+#define BOOST_TEST_MODULE TimeEstimatorTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <sstream>
+#include "TimeEstimator.h"
+#include "GCodeReader.h"
+
+// 1000 mm/s^2, no jerk: every corner is a full stop
+static const char* SETUP = "M201 X10000 Y10000 Z10000 E10000\nM204 S1000 R1000\nM205 X0 Y0 Z0 E0\n";
+
+static double estimate(const std::string& gcode, TimeTable& table)
+{
+	TimeEstimator estimator(table);
+	std::istringstream in(SETUP + gcode);
+	std::string line;
+	uint64_t offset = 0;
+
+	while (std::getline(in, line))
+	{
+		offset += line.length() + 1;
+		estimator.line(GCodeReader::stripLine(line), offset);
+	}
+
+	estimator.finish(offset);
+	return estimator.totalTime();
+}
+
+static double estimate(const std::string& gcode)
+{
+	TimeTable table;
+	return estimate(gcode, table);
+}
+
+BOOST_AUTO_TEST_CASE(TestTrapezoid)
+{
+	// 5 mm to reach 100 mm/s, 90 mm cruising, 5 mm to stop
+	BOOST_TEST(estimate("G1 X100 F6000\n") == 1.1, boost::test_tools::tolerance(1e-6));
+}
+
+BOOST_AUTO_TEST_CASE(TestTriangle)
+{
+	// Too short to reach 200 mm/s, peaks at 100 mm/s
+	BOOST_TEST(estimate("G1 X10 F12000\n") == 0.2, boost::test_tools::tolerance(1e-6));
+}
+
+BOOST_AUTO_TEST_CASE(TestJunctions)
+{
+	// Straight on at full speed
+	BOOST_TEST(estimate("G1 X10 F6000\nG1 X20\n") == 0.3, boost::test_tools::tolerance(1e-6));
+	// Stops in the corner without any jerk
+	BOOST_TEST(estimate("G1 X10 F6000\nG1 Y10\n") == 0.4, boost::test_tools::tolerance(1e-6));
+
+	// With jerk, the corner can be passed at some speed
+	const double withJerk = estimate("M205 X8 Y8\nG1 X10 F6000\nG1 Y10\n");
+	BOOST_TEST(withJerk < 0.4);
+	BOOST_TEST(withJerk > 0.3);
+
+	// Junction deviation as well
+	const double withDeviation = estimate("M205 J0.05\nG1 X10 F6000\nG1 Y10\n");
+	BOOST_TEST(withDeviation < 0.4);
+	BOOST_TEST(withDeviation > 0.3);
+}
+
+BOOST_AUTO_TEST_CASE(TestLookAhead)
+{
+	// Many segments on a straight line, more than the planner looks ahead at once
+	std::ostringstream gcode;
+
+	gcode << "G91\nG1 F6000\n";
+	for (int i = 0; i < 100; i++)
+		gcode << "G1 X1\n";
+
+	BOOST_TEST(estimate(gcode.str()) == 1.1, boost::test_tools::tolerance(1e-6));
+
+	// Tiny segments: the look-ahead doesn't reach far enough to allow full speed, like in the firmware
+	gcode.str("");
+	gcode << "G91\nG1 F6000\n";
+	for (int i = 0; i < 1000; i++)
+		gcode << "G1 X0.1\n";
+
+	BOOST_TEST(estimate(gcode.str()) > 1.2);
+}
+
+BOOST_AUTO_TEST_CASE(TestLimits)
+{
+	// Feedrate capped by M203
+	BOOST_TEST(estimate("M203 X50\nG1 X100 F6000\n") == 2.05, boost::test_tools::tolerance(1e-6));
+	// Retraction, 25 mm/s maximum for E
+	BOOST_TEST(estimate("M83\nG1 E-5 F3000\n") == 0.225, boost::test_tools::tolerance(1e-6));
+}
+
+BOOST_AUTO_TEST_CASE(TestDwellAndArcs)
+{
+	BOOST_TEST(estimate("G4 P500\nG4 S2\n") == 2.5, boost::test_tools::tolerance(1e-6));
+	BOOST_TEST(estimate("G1 X10 F6000\nG4 P500\nG1 X20\n") == 0.9, boost::test_tools::tolerance(1e-6));
+
+	// Half circle with a radius of 10 mm is 31.4 mm long, much more than the chord
+	BOOST_TEST(estimate("G1 X10 F6000\nG1 X20\nG2 X0 I-10 J0\n")
+		> estimate("G1 X10 F6000\nG1 X20\nG1 X0\n") + 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(TestTable)
+{
+	std::ostringstream gcode;
+
+	gcode << "G1 F6000\n";
+	for (int i = 1; i <= 100; i++)
+		gcode << "G1 X" << (i % 2) * 10 << " Y" << i << "\n";
+
+	TimeTable table;
+	const double total = estimate(gcode.str(), table);
+	const uint64_t size = std::string(SETUP).length() + gcode.str().length();
+
+	BOOST_TEST(table.samples() > 1u);
+	BOOST_TEST(table.timeAt(0) == 0);
+	BOOST_TEST(table.timeAt(size) == total, boost::test_tools::tolerance(1e-5));
+	BOOST_TEST(table.totalTime() == total, boost::test_tools::tolerance(1e-5));
+
+	double previous = 0;
+	for (uint64_t offset = 0; offset <= size; offset += 7)
+	{
+		const double t = table.timeAt(offset);
+		BOOST_TEST(t >= previous);
+		previous = t;
+	}
+
+	const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+	TimeTable loaded;
+
+	table.save(path, size, 1234);
+	BOOST_TEST(!loaded.load(path, size, 1235));
+	BOOST_TEST(!loaded.load(path, size + 1, 1234));
+	BOOST_TEST(loaded.load(path, size, 1234));
+	BOOST_TEST(loaded.samples() == table.samples());
+	BOOST_TEST(loaded.timeAt(size / 2) == table.timeAt(size / 2));
+
+	boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(TestProgressCommands)
+{
+	TimeTable table;
+
+	estimate("G1 X10 F6000\n", table);
+	BOOST_TEST(!table.hasProgressCommands());
+
+	TimeTable withM73;
+	estimate("M73 P0 R1\nG1 X10 F6000\nM73 P100 R0\n", withM73);
+	BOOST_TEST(withM73.hasProgressCommands());
+
+	const std::string path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+	TimeTable loaded;
+
+	withM73.save(path, 100, 1234);
+	BOOST_TEST(loaded.load(path, 100, 1234));
+	BOOST_TEST(loaded.hasProgressCommands());
+
+	boost::filesystem::remove(path);
+}
@@ -0,0 +1,351 @@
+#define BOOST_TEST_MODULE VirtualPrinterTest
+#include <boost/test/included/unit_test.hpp>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "VirtualPrinter.h"
+#include "MeatPack.h"
+
+// The printer's side of the pseudo terminal, with the virtual printer running in the background
+class Connection
+{
+public:
+	Connection(const VirtualPrinter::Options& options)
+	: m_simulator(m_io, options)
+	{
+		m_fd = ::open(m_simulator.devicePath().c_str(), O_RDWR | O_NOCTTY);
+		BOOST_REQUIRE(m_fd >= 0);
+
+		struct termios tos;
+		::tcgetattr(m_fd, &tos);
+		::cfmakeraw(&tos);
+		::tcsetattr(m_fd, TCSANOW, &tos);
+
+		m_thread = std::thread([this]() { m_io.run(); });
+	}
+	~Connection()
+	{
+		m_io.stop();
+		m_thread.join();
+		::close(m_fd);
+	}
+
+	void setSpeed(speed_t speed)
+	{
+		struct termios tos;
+		::tcgetattr(m_fd, &tos);
+		::cfsetspeed(&tos, speed);
+		::tcsetattr(m_fd, TCSANOW, &tos);
+	}
+
+	void write(const std::string& data)
+	{
+		BOOST_REQUIRE(::write(m_fd, data.c_str(), data.length()) == ssize_t(data.length()));
+	}
+
+	// "N5 G1 X1 *12"
+	void writeNumbered(int lineNo, const std::string& cmd)
+	{
+		std::string line = "N" + std::to_string(lineNo) + " " + cmd + " ";
+		unsigned int cs = 0;
+
+		for (char c : line)
+			cs ^= (unsigned char) c;
+
+		write(line + "*" + std::to_string(cs & 0xff) + "\n");
+	}
+
+	// Lines up to and including the next "ok"
+	std::vector<std::string> readReply(int timeoutMs = 5000)
+	{
+		std::vector<std::string> lines;
+
+		while (true)
+		{
+			size_t end;
+			while ((end = m_buffer.find('\n')) != std::string::npos)
+			{
+				lines.push_back(m_buffer.substr(0, end));
+				m_buffer.erase(0, end + 1);
+
+				if (lines.back().compare(0, 2, "ok") == 0)
+					return lines;
+			}
+
+			struct pollfd pfd = { m_fd, POLLIN, 0 };
+			if (::poll(&pfd, 1, timeoutMs) <= 0)
+			{
+				lines.push_back("(timeout)");
+				return lines;
+			}
+
+			char buf[256];
+			ssize_t rd = ::read(m_fd, buf, sizeof(buf));
+			if (rd > 0)
+				m_buffer.append(buf, rd);
+		}
+	}
+
+	const VirtualPrinter::Stats& stats() const { return m_simulator.stats(); }
+private:
+	boost::asio::io_service m_io;
+	VirtualPrinter m_simulator;
+	int m_fd;
+	std::thread m_thread;
+	std::string m_buffer;
+};
+
+BOOST_AUTO_TEST_CASE(TestOptions)
+{
+	VirtualPrinter::Options options = VirtualPrinter::Options::parse("latency=1.5,rx=64,checksum_errors=0.01,errors=0.5,tau=0,advanced_ok=0,autoreport=0,seed=7");
+
+	BOOST_TEST(options.latency.count() == 1500);
+	BOOST_TEST(options.rxBufferSize == 64u);
+	BOOST_TEST(options.checksumErrorRate == 0.01);
+	BOOST_TEST(options.errorRate == 0.5);
+	BOOST_TEST(options.thermalTimeConstant == 0);
+	BOOST_TEST(!options.advancedOk);
+	BOOST_TEST(!options.autoReport);
+	BOOST_TEST(options.seed == 7u);
+
+	BOOST_TEST(VirtualPrinter::Options::parse("").rxBufferSize == 128u);
+	BOOST_TEST(VirtualPrinter::Options::parse("baud=250000").baudRate == 250000);
+	BOOST_TEST(VirtualPrinter::Options::parse("emergency_parser=1,meatpack=1").emergencyParser);
+	BOOST_TEST(VirtualPrinter::Options::parse("emergency_parser=1,meatpack=1").meatPack);
+	BOOST_CHECK_THROW(VirtualPrinter::Options::parse("latency"), std::invalid_argument);
+	BOOST_CHECK_THROW(VirtualPrinter::Options::parse("latency=x"), std::invalid_argument);
+	BOOST_CHECK_THROW(VirtualPrinter::Options::parse("speed=1"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestProtocol)
+{
+	Connection conn(VirtualPrinter::Options{});
+	std::vector<std::string> reply;
+
+	conn.write("M110 N0\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 1u);
+	BOOST_TEST(reply.back().compare(0, 5, "ok N0") == 0);
+
+	conn.write("M115\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() > 2u);
+	BOOST_TEST(reply[0].compare(0, 14, "FIRMWARE_NAME:") == 0);
+	BOOST_TEST((std::find(reply.begin(), reply.end(), "Cap:ADVANCED_OK:1") != reply.end()));
+
+	conn.writeNumbered(1, "G1 X10");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 1u);
+	BOOST_TEST(reply[0] == "ok N1 P15 B3");
+
+	// Bad checksum
+	conn.write("N2 G1 X20 *0\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 3u);
+	BOOST_TEST(reply[0] == "Error:checksum mismatch, Last Line: 1");
+	BOOST_TEST(reply[1] == "Resend: 2");
+	BOOST_TEST(reply[2] == "ok");
+
+	// Skipped a line
+	conn.writeNumbered(3, "G1 X30");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 3u);
+	BOOST_TEST(reply[0] == "Error:Line Number is not Last Line Number+1, Last Line: 1");
+	BOOST_TEST(reply[1] == "Resend: 2");
+
+	conn.writeNumbered(2, "G1 X20");
+	reply = conn.readReply();
+	BOOST_TEST(reply.back() == "ok N2 P15 B3");
+
+	BOOST_TEST(conn.stats().rejectedLines == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(TestTemperatures)
+{
+	VirtualPrinter::Options options;
+	options.thermalTimeConstant = 0.05;
+	options.advancedOk = false;
+
+	Connection conn(options);
+	std::vector<std::string> reply;
+
+	conn.write("M105\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 1u);
+	BOOST_TEST(reply[0] == "ok T:25.00 /0.00 B:25.00 /0.00 @:0 B@:0");
+
+	// Reports the temperature while heating up
+	conn.write("M109 S200\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() > 1u);
+	BOOST_TEST(reply[0].compare(0, 2, "T:") == 0);
+	BOOST_TEST(reply.back() == "ok");
+
+	conn.write("M105\n");
+	reply = conn.readReply();
+	double current = 0, target = 0;
+	BOOST_TEST(std::sscanf(reply.back().c_str(), "ok T:%lf /%lf", &current, &target) == 2);
+	BOOST_TEST(std::abs(current - 200) < 1.5);
+	BOOST_TEST(target == 200);
+
+	// Reported without asking
+	conn.write("M155 S0.2\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.back() == "ok");
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(300));
+	conn.write("M155 S0\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 2u);
+	BOOST_TEST(reply.front().compare(0, 3, " T:") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestOverflow)
+{
+	VirtualPrinter::Options options;
+	options.latency = std::chrono::milliseconds(20);
+	options.rxBufferSize = 32;
+
+	Connection conn(options);
+	std::string burst;
+
+	for (int i = 0; i < 10; i++)
+		burst += "G1 X100 Y100\n";
+
+	conn.write(burst);
+
+	// The lines that fit are executed, the rest is lost
+	int oks = 0;
+	while (conn.readReply(500).back() != "(timeout)")
+		oks++;
+
+	BOOST_TEST(oks >= 2);
+	BOOST_TEST(oks < 10);
+	BOOST_TEST(conn.stats().bytesLost > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestSdCard)
+{
+	Connection conn(VirtualPrinter::Options{});
+	std::vector<std::string> reply;
+
+	conn.write("M28 TEST.GCO\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.front() == "Writing to file: TEST.GCO");
+
+	// Stored with "\r\n", not executed
+	conn.writeNumbered(1, "M104 S215");
+	BOOST_TEST(conn.readReply().back() == "ok N1 P15 B3");
+	conn.write("G1 X10\n");
+	conn.readReply();
+	conn.write("M29 TEST.GCO\n");
+	BOOST_TEST(conn.readReply().front() == "Done saving file.");
+	BOOST_TEST(conn.stats().sdBytesWritten == 19u);
+
+	conn.write("M23 MISSING.GCO\n");
+	BOOST_TEST(conn.readReply().front() == "open failed, File: MISSING.GCO.");
+
+	conn.write("M23 TEST.GCO\n");
+	reply = conn.readReply();
+	BOOST_TEST(reply.size() == 3u);
+	BOOST_TEST(reply[0] == "File opened: TEST.GCO Size: 19");
+
+	conn.write("M27\n");
+	BOOST_TEST(conn.readReply().front() == "SD printing byte 0/19");
+
+	// Both lines fit into the first tick
+	conn.write("M24\n");
+	BOOST_TEST(conn.readReply().front() == "Done printing file");
+
+	conn.write("M105\n");
+	BOOST_TEST(conn.readReply().back().find("/215.00") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(TestBaudRate)
+{
+	VirtualPrinter::Options options;
+	options.baudRate = 115200;
+
+	Connection conn(options);
+
+	conn.setSpeed(B57600);
+	conn.write("M110 N0\n");
+	BOOST_TEST(conn.readReply(300).back() == "(timeout)");
+	BOOST_TEST(conn.stats().bytesLost == 8u);
+
+	conn.setSpeed(B115200);
+	conn.write("M110 N0\n");
+	BOOST_TEST(conn.readReply().back().compare(0, 2, "ok") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestEmergencyParser)
+{
+	VirtualPrinter::Options options;
+	options.emergencyParser = true;
+	options.advancedOk = false;
+
+	Connection conn(options);
+	std::vector<std::string> reply;
+
+	// Would take a minute with the default thermal model, M108 is taken while waiting in M109 and executed after it
+	conn.write("M109 S200\n");
+	conn.writeNumbered(1, "M108");
+	reply = conn.readReply(1000);
+	BOOST_TEST(reply.back() == "ok");
+	BOOST_TEST(conn.readReply(1000).back() == "ok");
+	BOOST_TEST(conn.stats().emergencyCommands == 1u);
+
+	// Nothing after M112 is executed
+	conn.write("M109 S250\n");
+	conn.write("M112\n");
+	reply = conn.readReply(300);
+	BOOST_TEST((std::find(reply.begin(), reply.end(), "Error:Printer halted. kill() called!") != reply.end()));
+	BOOST_TEST(reply.back() == "(timeout)");
+
+	conn.write("M105\n");
+	BOOST_TEST(conn.readReply(300).back() == "(timeout)");
+}
+
+BOOST_AUTO_TEST_CASE(TestMeatPack)
+{
+	VirtualPrinter::Options options;
+	options.emergencyParser = true;
+	options.meatPack = true;
+	options.advancedOk = false;
+
+	Connection conn(options);
+	std::string data;
+
+	conn.write("M115\n");
+	std::vector<std::string> reply = conn.readReply();
+	BOOST_TEST((std::find(reply.begin(), reply.end(), "Cap:MEATPACK:1") != reply.end()));
+
+	data = MeatPack::ENABLE;
+	MeatPack::pack("M104 S215\n", data);
+	conn.write(data);
+	BOOST_TEST(conn.readReply().back() == "ok");
+
+	conn.write(std::string(MeatPack::DISABLE) + "M105\n");
+	BOOST_TEST(conn.readReply().back().find("/215.00") != std::string::npos);
+
+	// The emergency parser only sees M108 in plain text, and only at the start of a line.
+	// Packed, it waits for M109 to finish.
+	data = MeatPack::ENABLE;
+	MeatPack::pack("M109 S200\n", data);
+	MeatPack::pack("M108\n", data);
+	conn.write(data);
+	BOOST_TEST(conn.readReply(300).back() == "(timeout)");
+	BOOST_TEST(conn.stats().emergencyCommands == 0u);
+
+	data = MeatPack::DISABLE;
+	data += "\nM108\n";
+	data += MeatPack::ENABLE;
+	conn.write(data);
+	BOOST_TEST(conn.readReply(1000).back() == "ok");
+	BOOST_TEST(conn.stats().emergencyCommands == 1u);
+}
@@ -0,0 +1,2578 @@
+; generated for dashprint tests: perimeters as short segments, subdivided straight walls, zig-zag infill
+M201 X1000 Y1000 Z200 E5000 ; sets maximum accelerations, mm/sec^2
+M203 X200 Y200 Z12 E120 ; sets maximum feedrates, mm/sec
+M204 P1250 R1250 T1250 ; sets acceleration (P, T) and retract acceleration (R), mm/sec^2
+M205 X8.00 Y8.00 Z0.40 E4.50 ; sets the jerk limits, mm/sec
+M140 S60
+M104 S215
+M190 S60
+M109 S215
+G28 ; home all axes
+G90 ; use absolute coordinates
+M83 ; extruder relative mode
+G92 E0
+;LAYER_CHANGE
+;Z:0.2
+G1 Z0.200 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:0.4
+G1 Z0.400 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:0.6
+G1 Z0.600 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:0.8
+G1 Z0.800 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:1.0
+G1 Z1.000 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:1.2
+G1 Z1.200 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:1.4
+G1 Z1.400 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+;LAYER_CHANGE
+;Z:1.6
+G1 Z1.600 F720
+G1 E-0.80000 F2100
+G1 X120.000 Y100.000 F9000
+G1 E0.80000 F2100
+;TYPE:Perimeter
+G1 F1800
+G1 X119.951 Y101.395 E0.04635
+G1 X119.805 Y102.783 E0.04635
+G1 X119.563 Y104.158 E0.04635
+G1 X119.225 Y105.513 E0.04635
+G1 X118.794 Y106.840 E0.04635
+G1 X118.271 Y108.135 E0.04635
+G1 X117.659 Y109.389 E0.04635
+G1 X116.961 Y110.598 E0.04635
+G1 X116.180 Y111.756 E0.04635
+G1 X115.321 Y112.856 E0.04635
+G1 X114.387 Y113.893 E0.04635
+G1 X113.383 Y114.863 E0.04635
+G1 X112.313 Y115.760 E0.04635
+G1 X111.184 Y116.581 E0.04635
+G1 X110.000 Y117.321 E0.04635
+G1 X108.767 Y117.976 E0.04635
+G1 X107.492 Y118.544 E0.04635
+G1 X106.180 Y119.021 E0.04635
+G1 X104.838 Y119.406 E0.04635
+G1 X103.473 Y119.696 E0.04635
+G1 X102.091 Y119.890 E0.04635
+G1 X100.698 Y119.988 E0.04635
+G1 X99.302 Y119.988 E0.04635
+G1 X97.909 Y119.890 E0.04635
+G1 X96.527 Y119.696 E0.04635
+G1 X95.162 Y119.406 E0.04635
+G1 X93.820 Y119.021 E0.04635
+G1 X92.508 Y118.544 E0.04635
+G1 X91.233 Y117.976 E0.04635
+G1 X90.000 Y117.321 E0.04635
+G1 X88.816 Y116.581 E0.04635
+G1 X87.687 Y115.760 E0.04635
+G1 X86.617 Y114.863 E0.04635
+G1 X85.613 Y113.893 E0.04635
+G1 X84.679 Y112.856 E0.04635
+G1 X83.820 Y111.756 E0.04635
+G1 X83.039 Y110.598 E0.04635
+G1 X82.341 Y109.389 E0.04635
+G1 X81.729 Y108.135 E0.04635
+G1 X81.206 Y106.840 E0.04635
+G1 X80.775 Y105.513 E0.04635
+G1 X80.437 Y104.158 E0.04635
+G1 X80.195 Y102.783 E0.04635
+G1 X80.049 Y101.395 E0.04635
+G1 X80.000 Y100.000 E0.04635
+G1 X80.049 Y98.605 E0.04635
+G1 X80.195 Y97.217 E0.04635
+G1 X80.437 Y95.842 E0.04635
+G1 X80.775 Y94.487 E0.04635
+G1 X81.206 Y93.160 E0.04635
+G1 X81.729 Y91.865 E0.04635
+G1 X82.341 Y90.611 E0.04635
+G1 X83.039 Y89.402 E0.04635
+G1 X83.820 Y88.244 E0.04635
+G1 X84.679 Y87.144 E0.04635
+G1 X85.613 Y86.107 E0.04635
+G1 X86.617 Y85.137 E0.04635
+G1 X87.687 Y84.240 E0.04635
+G1 X88.816 Y83.419 E0.04635
+G1 X90.000 Y82.679 E0.04635
+G1 X91.233 Y82.024 E0.04635
+G1 X92.508 Y81.456 E0.04635
+G1 X93.820 Y80.979 E0.04635
+G1 X95.162 Y80.594 E0.04635
+G1 X96.527 Y80.304 E0.04635
+G1 X97.909 Y80.110 E0.04635
+G1 X99.302 Y80.012 E0.04635
+G1 X100.698 Y80.012 E0.04635
+G1 X102.091 Y80.110 E0.04635
+G1 X103.473 Y80.304 E0.04635
+G1 X104.838 Y80.594 E0.04635
+G1 X106.180 Y80.979 E0.04635
+G1 X107.492 Y81.456 E0.04635
+G1 X108.767 Y82.024 E0.04635
+G1 X110.000 Y82.679 E0.04635
+G1 X111.184 Y83.419 E0.04635
+G1 X112.313 Y84.240 E0.04635
+G1 X113.383 Y85.137 E0.04635
+G1 X114.387 Y86.107 E0.04635
+G1 X115.321 Y87.144 E0.04635
+G1 X116.180 Y88.244 E0.04635
+G1 X116.961 Y89.402 E0.04635
+G1 X117.659 Y90.611 E0.04635
+G1 X118.271 Y91.865 E0.04635
+G1 X118.794 Y93.160 E0.04635
+G1 X119.225 Y94.487 E0.04635
+G1 X119.563 Y95.842 E0.04635
+G1 X119.805 Y97.217 E0.04635
+G1 X119.951 Y98.605 E0.04635
+G1 X120.000 Y100.000 E0.04635
+G1 E-0.80000 F2100
+G1 X119.550 Y100.000 F9000
+G1 E0.80000 F2100
+G1 X119.502 Y98.636 E0.04530 F1800
+G1 X119.360 Y97.279 E0.04530 F1800
+G1 X119.123 Y95.935 E0.04530 F1800
+G1 X118.793 Y94.611 E0.04530 F1800
+G1 X118.371 Y93.314 E0.04530 F1800
+G1 X117.860 Y92.048 E0.04530 F1800
+G1 X117.262 Y90.822 E0.04530 F1800
+G1 X116.579 Y89.640 E0.04530 F1800
+G1 X115.816 Y88.509 E0.04530 F1800
+G1 X114.976 Y87.434 E0.04530 F1800
+G1 X114.063 Y86.419 E0.04530 F1800
+G1 X113.082 Y85.472 E0.04530 F1800
+G1 X112.036 Y84.594 E0.04530 F1800
+G1 X110.932 Y83.792 E0.04530 F1800
+G1 X109.775 Y83.069 E0.04530 F1800
+G1 X108.570 Y82.429 E0.04530 F1800
+G1 X107.324 Y81.874 E0.04530 F1800
+G1 X106.041 Y81.407 E0.04530 F1800
+G1 X104.730 Y81.031 E0.04530 F1800
+G1 X103.395 Y80.747 E0.04530 F1800
+G1 X102.044 Y80.557 E0.04530 F1800
+G1 X100.682 Y80.462 E0.04530 F1800
+G1 X99.318 Y80.462 E0.04530 F1800
+G1 X97.956 Y80.557 E0.04530 F1800
+G1 X96.605 Y80.747 E0.04530 F1800
+G1 X95.270 Y81.031 E0.04530 F1800
+G1 X93.959 Y81.407 E0.04530 F1800
+G1 X92.676 Y81.874 E0.04530 F1800
+G1 X91.430 Y82.429 E0.04530 F1800
+G1 X90.225 Y83.069 E0.04530 F1800
+G1 X89.068 Y83.792 E0.04530 F1800
+G1 X87.964 Y84.594 E0.04530 F1800
+G1 X86.918 Y85.472 E0.04530 F1800
+G1 X85.937 Y86.419 E0.04530 F1800
+G1 X85.024 Y87.434 E0.04530 F1800
+G1 X84.184 Y88.509 E0.04530 F1800
+G1 X83.421 Y89.640 E0.04530 F1800
+G1 X82.738 Y90.822 E0.04530 F1800
+G1 X82.140 Y92.048 E0.04530 F1800
+G1 X81.629 Y93.314 E0.04530 F1800
+G1 X81.207 Y94.611 E0.04530 F1800
+G1 X80.877 Y95.935 E0.04530 F1800
+G1 X80.640 Y97.279 E0.04530 F1800
+G1 X80.498 Y98.636 E0.04530 F1800
+G1 X80.450 Y100.000 E0.04530 F1800
+G1 X80.498 Y101.364 E0.04530 F1800
+G1 X80.640 Y102.721 E0.04530 F1800
+G1 X80.877 Y104.065 E0.04530 F1800
+G1 X81.207 Y105.389 E0.04530 F1800
+G1 X81.629 Y106.686 E0.04530 F1800
+G1 X82.140 Y107.952 E0.04530 F1800
+G1 X82.738 Y109.178 E0.04530 F1800
+G1 X83.421 Y110.360 E0.04530 F1800
+G1 X84.184 Y111.491 E0.04530 F1800
+G1 X85.024 Y112.566 E0.04530 F1800
+G1 X85.937 Y113.581 E0.04530 F1800
+G1 X86.918 Y114.528 E0.04530 F1800
+G1 X87.964 Y115.406 E0.04530 F1800
+G1 X89.068 Y116.208 E0.04530 F1800
+G1 X90.225 Y116.931 E0.04530 F1800
+G1 X91.430 Y117.571 E0.04530 F1800
+G1 X92.676 Y118.126 E0.04530 F1800
+G1 X93.959 Y118.593 E0.04530 F1800
+G1 X95.270 Y118.969 E0.04530 F1800
+G1 X96.605 Y119.253 E0.04530 F1800
+G1 X97.956 Y119.443 E0.04530 F1800
+G1 X99.318 Y119.538 E0.04530 F1800
+G1 X100.682 Y119.538 E0.04530 F1800
+G1 X102.044 Y119.443 E0.04530 F1800
+G1 X103.395 Y119.253 E0.04530 F1800
+G1 X104.730 Y118.969 E0.04530 F1800
+G1 X106.041 Y118.593 E0.04530 F1800
+G1 X107.324 Y118.126 E0.04530 F1800
+G1 X108.570 Y117.571 E0.04530 F1800
+G1 X109.775 Y116.931 E0.04530 F1800
+G1 X110.932 Y116.208 E0.04530 F1800
+G1 X112.036 Y115.406 E0.04530 F1800
+G1 X113.082 Y114.528 E0.04530 F1800
+G1 X114.063 Y113.581 E0.04530 F1800
+G1 X114.976 Y112.566 E0.04530 F1800
+G1 X115.816 Y111.491 E0.04530 F1800
+G1 X116.579 Y110.360 E0.04530 F1800
+G1 X117.262 Y109.178 E0.04530 F1800
+G1 X117.860 Y107.952 E0.04530 F1800
+G1 X118.371 Y106.686 E0.04530 F1800
+G1 X118.793 Y105.389 E0.04530 F1800
+G1 X119.123 Y104.065 E0.04530 F1800
+G1 X119.360 Y102.721 E0.04530 F1800
+G1 X119.502 Y101.364 E0.04530 F1800
+G1 X119.550 Y100.000 E0.04530 F1800
+G1 E-0.80000 F2100
+G1 X60.000 Y60.000 F9000
+G1 E0.80000 F2100
+;TYPE:External perimeter
+G1 F1500
+G1 X64.000 Y60.000 E0.13280
+G1 X68.000 Y60.000 E0.13280
+G1 X72.000 Y60.000 E0.13280
+G1 X76.000 Y60.000 E0.13280
+G1 X80.000 Y60.000 E0.13280
+G1 X84.000 Y60.000 E0.13280
+G1 X88.000 Y60.000 E0.13280
+G1 X92.000 Y60.000 E0.13280
+G1 X96.000 Y60.000 E0.13280
+G1 X100.000 Y60.000 E0.13280
+G1 X104.000 Y60.000 E0.13280
+G1 X108.000 Y60.000 E0.13280
+G1 X112.000 Y60.000 E0.13280
+G1 X116.000 Y60.000 E0.13280
+G1 X120.000 Y60.000 E0.13280
+G1 X124.000 Y60.000 E0.13280
+G1 X128.000 Y60.000 E0.13280
+G1 X132.000 Y60.000 E0.13280
+G1 X136.000 Y60.000 E0.13280
+G1 X140.000 Y60.000 E0.13280
+G1 X140.000 Y64.000 E0.13280
+G1 X140.000 Y68.000 E0.13280
+G1 X140.000 Y72.000 E0.13280
+G1 X140.000 Y76.000 E0.13280
+G1 X140.000 Y80.000 E0.13280
+G1 X140.000 Y84.000 E0.13280
+G1 X140.000 Y88.000 E0.13280
+G1 X140.000 Y92.000 E0.13280
+G1 X140.000 Y96.000 E0.13280
+G1 X140.000 Y100.000 E0.13280
+G1 X140.000 Y104.000 E0.13280
+G1 X140.000 Y108.000 E0.13280
+G1 X140.000 Y112.000 E0.13280
+G1 X140.000 Y116.000 E0.13280
+G1 X140.000 Y120.000 E0.13280
+G1 X140.000 Y124.000 E0.13280
+G1 X140.000 Y128.000 E0.13280
+G1 X140.000 Y132.000 E0.13280
+G1 X140.000 Y136.000 E0.13280
+G1 X140.000 Y140.000 E0.13280
+G1 X136.000 Y140.000 E0.13280
+G1 X132.000 Y140.000 E0.13280
+G1 X128.000 Y140.000 E0.13280
+G1 X124.000 Y140.000 E0.13280
+G1 X120.000 Y140.000 E0.13280
+G1 X116.000 Y140.000 E0.13280
+G1 X112.000 Y140.000 E0.13280
+G1 X108.000 Y140.000 E0.13280
+G1 X104.000 Y140.000 E0.13280
+G1 X100.000 Y140.000 E0.13280
+G1 X96.000 Y140.000 E0.13280
+G1 X92.000 Y140.000 E0.13280
+G1 X88.000 Y140.000 E0.13280
+G1 X84.000 Y140.000 E0.13280
+G1 X80.000 Y140.000 E0.13280
+G1 X76.000 Y140.000 E0.13280
+G1 X72.000 Y140.000 E0.13280
+G1 X68.000 Y140.000 E0.13280
+G1 X64.000 Y140.000 E0.13280
+G1 X60.000 Y140.000 E0.13280
+G1 X60.000 Y136.000 E0.13280
+G1 X60.000 Y132.000 E0.13280
+G1 X60.000 Y128.000 E0.13280
+G1 X60.000 Y124.000 E0.13280
+G1 X60.000 Y120.000 E0.13280
+G1 X60.000 Y116.000 E0.13280
+G1 X60.000 Y112.000 E0.13280
+G1 X60.000 Y108.000 E0.13280
+G1 X60.000 Y104.000 E0.13280
+G1 X60.000 Y100.000 E0.13280
+G1 X60.000 Y96.000 E0.13280
+G1 X60.000 Y92.000 E0.13280
+G1 X60.000 Y88.000 E0.13280
+G1 X60.000 Y84.000 E0.13280
+G1 X60.000 Y80.000 E0.13280
+G1 X60.000 Y76.000 E0.13280
+G1 X60.000 Y72.000 E0.13280
+G1 X60.000 Y68.000 E0.13280
+G1 X60.000 Y64.000 E0.13280
+G1 X60.000 Y60.000 E0.13280
+;TYPE:Solid infill
+G1 F3000
+G1 X62.000 Y62.000 F9000
+G1 F3000
+G1 X138.000 Y62.000 E2.52320
+G1 X138.000 Y66.000 E0.13280
+G1 X62.000 Y66.000 E2.52320
+G1 X62.000 Y70.000 E0.13280
+G1 X138.000 Y70.000 E2.52320
+G1 X138.000 Y74.000 E0.13280
+G1 X62.000 Y74.000 E2.52320
+G1 X62.000 Y78.000 E0.13280
+G1 X138.000 Y78.000 E2.52320
+G1 X138.000 Y82.000 E0.13280
+G1 X62.000 Y82.000 E2.52320
+G1 X62.000 Y86.000 E0.13280
+G1 X138.000 Y86.000 E2.52320
+G1 X138.000 Y90.000 E0.13280
+G1 X62.000 Y90.000 E2.52320
+G1 X62.000 Y94.000 E0.13280
+G1 X138.000 Y94.000 E2.52320
+G1 X138.000 Y98.000 E0.13280
+G1 X62.000 Y98.000 E2.52320
+G1 X62.000 Y102.000 E0.13280
+G1 X138.000 Y102.000 E2.52320
+G1 X138.000 Y106.000 E0.13280
+G1 X62.000 Y106.000 E2.52320
+G1 X62.000 Y110.000 E0.13280
+G1 X138.000 Y110.000 E2.52320
+G1 X138.000 Y114.000 E0.13280
+G1 X62.000 Y114.000 E2.52320
+G1 X62.000 Y118.000 E0.13280
+G1 X138.000 Y118.000 E2.52320
+G1 X138.000 Y122.000 E0.13280
+G1 X62.000 Y122.000 E2.52320
+G1 X62.000 Y126.000 E0.13280
+G1 X138.000 Y126.000 E2.52320
+G1 X138.000 Y130.000 E0.13280
+G1 X62.000 Y130.000 E2.52320
+G1 X62.000 Y134.000 E0.13280
+G1 X138.000 Y134.000 E2.52320
+G1 X138.000 Y138.000 E0.13280
+G1 X62.000 Y138.000 E2.52320
+G1 X62.000 Y138.000 E0.00000
+M107
+M104 S0
+M140 S0
+G1 X0 Y200 F3000
+M84